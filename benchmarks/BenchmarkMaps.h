@@ -0,0 +1,43 @@
+#ifndef OMEGA_BENCHMARK_MAPS_H
+#define OMEGA_BENCHMARK_MAPS_H
+
+// Shared fixture for the tile map benchmarks (pathfinding, flow fields, field of view)
+
+#include "Tilemap.h"
+#include <chrono>
+
+const int MAP_SIZE = 512;
+const int ROOM_SIZE = 24;
+
+// Doorway in the west wall of room (10, 10), near the middle of the map;
+// three tiles tall, toggled to time incremental repairs
+const int DOOR_X = ROOM_SIZE * 10;
+const int DOOR_Y = ROOM_SIZE * 10 + ROOM_SIZE / 2 - 1;
+
+inline double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Grid of rooms with a doorway in every wall, plus scattered pillars
+inline void buildRooms(Tilemap& map) {
+    for (int i = 0; i < MAP_SIZE; i += ROOM_SIZE) {
+        map.fillRect(i, 0, 1, MAP_SIZE, Tile(0, true));
+        map.fillRect(0, i, MAP_SIZE, 1, Tile(0, true));
+    }
+    for (int y = 0; y < MAP_SIZE; y += ROOM_SIZE) {
+        for (int x = 0; x < MAP_SIZE; x += ROOM_SIZE) {
+            map.fillRect(x, y + ROOM_SIZE / 2 - 1, 1, 3, Tile());
+            map.fillRect(x + ROOM_SIZE / 2 - 1, y, 3, 1, Tile());
+            map.setTile(x + 5, y + 7, Tile(1, true));
+            map.setTile(x + 15, y + 17, Tile(1, true));
+        }
+    }
+}
+
+// Closes (true) or reopens the benchmark doorway
+inline void setDoorClosed(Tilemap& map, bool closed) {
+    map.fillRect(DOOR_X, DOOR_Y, 1, 3, closed ? Tile(0, true) : Tile());
+}
+
+#endif // OMEGA_BENCHMARK_MAPS_H
@@ -0,0 +1,116 @@
+// Field of view benchmark
+// Frame budget: the player's radius-24 field of view plus line of sight from
+// 1,000 enemies to the player within 0.5 ms on a walled 512x512 map, and the
+// cost of standing still (viewsheds reused) for comparison. Afterwards checks
+// that the field of view is symmetric and agrees with line of sight.
+
+#include "FieldOfView.h"
+#include "BenchmarkMaps.h"
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const int VIEW_RADIUS = 24;
+const int ENEMY_COUNT = 1000;
+const int ENEMY_RANGE = 40;         // Enemies are spread around the player's path
+const int FRAMES = 400;
+const int CHECK_STRIDE = 40;        // Frames between viewer positions checked
+const double FRAME_BUDGET_MS = 0.5;
+
+// Open tiles within the radius where the viewer's view disagrees with the
+// tile's own view back (symmetry) or with hasLineOfSight, in either direction
+int checkViewshed(const Tilemap& map, FieldOfView& fieldOfView, int viewerX, int viewerY) {
+    Viewshed view;
+    Viewshed reverse;
+    fieldOfView.compute(view, viewerX, viewerY, VIEW_RADIUS);
+
+    int errors = 0;
+    for (int y = viewerY - VIEW_RADIUS; y <= viewerY + VIEW_RADIUS; y++) {
+        for (int x = viewerX - VIEW_RADIUS; x <= viewerX + VIEW_RADIUS; x++) {
+            int dx = x - viewerX;
+            int dy = y - viewerY;
+            if (dx * dx + dy * dy > VIEW_RADIUS * VIEW_RADIUS || map.isTileSolid(x, y)) continue;
+
+            bool visible = view.isVisible(x, y);
+            fieldOfView.compute(reverse, x, y, VIEW_RADIUS);
+            if (reverse.isVisible(viewerX, viewerY) != visible ||
+                fieldOfView.hasLineOfSight(viewerX, viewerY, x, y) != visible ||
+                fieldOfView.hasLineOfSight(x, y, viewerX, viewerY) != visible) {
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+} // namespace
+
+int main() {
+    Tilemap map(MAP_SIZE, MAP_SIZE, 16, 16);
+    buildRooms(map);
+    FieldOfView fieldOfView(&map);
+    Viewshed playerView;
+
+    // The player walks the central corridor of a row of rooms
+    int playerY = ROOM_SIZE * 10 + ROOM_SIZE / 2;
+    int startX = ROOM_SIZE * 4;
+
+    std::vector<LineOfSightQuery> queries(ENEMY_COUNT);
+    std::vector<char> results;
+    for (int i = 0; i < ENEMY_COUNT; i++) {
+        queries[i].fromX = startX + (i * 7919) % (FRAMES + 2 * ENEMY_RANGE) - ENEMY_RANGE;
+        queries[i].fromY = playerY + (i * 104729) % (2 * ENEMY_RANGE) - ENEMY_RANGE;
+    }
+
+    size_t visibleTiles = 0;
+    size_t enemiesInSight = 0;
+    auto walkStart = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        int playerX = startX + frame;
+        fieldOfView.compute(playerView, playerX, playerY, VIEW_RADIUS);
+        visibleTiles += playerView.countVisible();
+
+        for (LineOfSightQuery& query : queries) {
+            query.toX = playerX;
+            query.toY = playerY;
+        }
+        fieldOfView.testLinesOfSight(queries, results);
+        for (char visible : results) enemiesInSight += visible;
+    }
+    double walkMs = elapsedMs(walkStart) / FRAMES;
+
+    // Standing still: the viewshed is reused until a nearby tile changes
+    int playerX = startX + FRAMES;
+    auto idleStart = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        fieldOfView.compute(playerView, playerX, playerY, VIEW_RADIUS);
+    }
+    double idleMs = elapsedMs(idleStart) / FRAMES;
+    FieldOfViewStats stats = fieldOfView.getStats();
+
+    int viewErrors = 0;
+    for (int frame = 0; frame < FRAMES; frame += CHECK_STRIDE) {
+        viewErrors += checkViewshed(map, fieldOfView, startX + frame, playerY);
+    }
+    std::cout << "=== Field of View Benchmark ===" << std::endl;
+    std::cout << "Map:               " << MAP_SIZE << "x" << MAP_SIZE << " tiles, radius " << VIEW_RADIUS << std::endl;
+    std::cout << "Visible tiles:     " << visibleTiles / FRAMES << " per frame" << std::endl;
+    std::cout << "Enemies in sight:  " << enemiesInSight / FRAMES << " / " << ENEMY_COUNT << std::endl;
+    std::cout << "Viewsheds:         " << stats.viewshedsComputed << " computed, "
+              << stats.viewshedsReused << " reused" << std::endl;
+    std::cout << "Standing still:    " << idleMs * 1000.0 << " us per frame" << std::endl;
+    std::cout << "Walking:           " << walkMs << " ms of " << FRAME_BUDGET_MS << " ms per frame" << std::endl;
+    std::cout << "View check:        " << viewErrors << " tiles asymmetric or disagreeing with line of sight" << std::endl;
+
+    if (viewErrors > 0) {
+        std::cout << "INCORRECT FIELD OF VIEW" << std::endl;
+        return 1;
+    }
+    if (walkMs > FRAME_BUDGET_MS) {
+        std::cout << "OVER BUDGET" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
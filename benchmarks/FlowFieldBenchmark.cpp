@@ -0,0 +1,102 @@
+// Flow field benchmark
+// Crowd budget: 5,000 agents converging on one goal steer from a shared field
+// on a walled 512x512 map within 1 ms per frame. Also times the field build and
+// the in-place repair after a door toggles, and checks the repaired field
+// against one built from scratch.
+
+#include "FlowField.h"
+#include "BenchmarkMaps.h"
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const int TILE_SIZE = 16;
+const int AGENT_COUNT = 5000;
+const int FRAMES = 200;
+const float AGENT_SPEED = 2.0f;     // World units per frame
+const double FRAME_BUDGET_MS = 1.0;
+
+// Tiles whose cost or direction differ between the two fields
+int countDifferences(const FlowField& repaired, const FlowField& built) {
+    int differences = 0;
+    for (int y = 0; y < MAP_SIZE; y++) {
+        for (int x = 0; x < MAP_SIZE; x++) {
+            if (repaired.getCost(x, y) != built.getCost(x, y) ||
+                repaired.getDirectionIndex(x, y) != built.getDirectionIndex(x, y)) {
+                differences++;
+            }
+        }
+    }
+    return differences;
+}
+
+} // namespace
+
+int main() {
+    Tilemap map(MAP_SIZE, MAP_SIZE, TILE_SIZE, TILE_SIZE);
+    buildRooms(map);
+    FlowFieldService service(&map);
+
+    int goalX = MAP_SIZE / 2 + 2;
+    int goalY = MAP_SIZE / 2 + 2;
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<const FlowField> field = service.getField(goalX, goalY);
+    double buildMs = elapsedMs(buildStart);
+
+    std::vector<Vector2> agents;
+    for (int i = 0; static_cast<int>(agents.size()) < AGENT_COUNT; i++) {
+        int x = (i * 7919) % MAP_SIZE;
+        int y = (i * 104729 / MAP_SIZE) % MAP_SIZE;
+        if (field->isReachable(x, y)) {
+            agents.push_back(Vector2((x + 0.5f) * TILE_SIZE, (y + 0.5f) * TILE_SIZE));
+        }
+    }
+
+    auto steerStart = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        for (Vector2& agent : agents) {
+            const Vector2& direction = field->sample(agent);
+            agent.x += direction.x * AGENT_SPEED;
+            agent.y += direction.y * AGENT_SPEED;
+        }
+    }
+    double frameMs = elapsedMs(steerStart) / FRAMES;
+
+    // Close and reopen the doorway next to the goal's room; every field is repaired in place
+    auto repairStart = std::chrono::high_resolution_clock::now();
+    setDoorClosed(map, true);
+    service.update();
+    setDoorClosed(map, false);
+    service.update();
+    double repairMs = elapsedMs(repairStart) / 2.0;
+    uint64_t tilesReset = service.getStats().tilesInvalidated / 2;
+
+    // A repair must land exactly where a fresh build does, door closed and open
+    setDoorClosed(map, true);
+    service.update();
+    int closedDifferences = countDifferences(*field, *FlowFieldService(&map).getField(goalX, goalY));
+    setDoorClosed(map, false);
+    service.update();
+    int openDifferences = countDifferences(*field, *FlowFieldService(&map).getField(goalX, goalY));
+
+    std::cout << "=== Flow Field Benchmark ===" << std::endl;
+    std::cout << "Map:               " << MAP_SIZE << "x" << MAP_SIZE << " tiles" << std::endl;
+    std::cout << "Field build:       " << buildMs << " ms" << std::endl;
+    std::cout << "Door repair:       " << repairMs << " ms ("
+              << tilesReset << " tiles reset)" << std::endl;
+    std::cout << AGENT_COUNT << " agents:      " << frameMs << " ms of " << FRAME_BUDGET_MS << " ms per frame" << std::endl;
+    std::cout << "Repair check:      " << closedDifferences << " / " << openDifferences
+              << " tiles differ from a fresh build (door closed / open)" << std::endl;
+
+    if (closedDifferences > 0 || openDifferences > 0) {
+        std::cout << "INCORRECT REPAIR" << std::endl;
+        return 1;
+    }
+    if (frameMs > FRAME_BUDGET_MS) {
+        std::cout << "OVER BUDGET" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
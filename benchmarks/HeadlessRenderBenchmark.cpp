@@ -0,0 +1,197 @@
+// Headless render benchmark: runs the scene render path (culling, parallel
+// command recording, sorted queue, sprite batch) against the null backend and
+// reports CPU submission cost with the draw, state change and upload counts
+// the frame would have issued to GL. Needs no window or GPU. A second pass
+// submits every sprite without culling; the culled frame must be cheaper.
+//
+// Usage: bench-render-headless [--instanced] [--trace <file>]
+//   --trace writes the backend calls of the last frame to <file>
+
+#include "Renderer.h"
+#include "RenderBackend.h"
+#include "SpriteBatch.h"
+#include "GLStateCache.h"
+#include "CommandList.h"
+#include "Culling.h"
+#include "Camera.h"
+#include "ECS.h"
+#include "Texture.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const int ENTITY_COUNT = 100000;
+const int MOVING_COUNT = 1000;     // Drift every frame; the rest stay where they were created
+const int TEXTURE_COUNT = 8;
+const int RECORD_JOBS = 4;
+const int WARMUP_FRAMES = 10;
+const int FRAMES = 200;
+const int UNCULLED_FRAMES = 20;
+const int SCREEN_WIDTH = 1280;
+const int SCREEN_HEIGHT = 720;
+const float WORLD_SIZE = 8192.0f;
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool instanced = false;
+    const char* tracePath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--instanced") == 0) {
+            instanced = true;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        }
+    }
+
+    Renderer renderer(nullptr, RenderBackendType::Null);
+    renderer.setViewportSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (!renderer.initialize()) {
+        std::cerr << "Failed to initialize headless renderer" << std::endl;
+        return 1;
+    }
+    if (instanced) {
+        renderer.getSpriteBatch().setMode(SpriteBatchMode::Instanced);
+    }
+
+    // A handful of textures so sorting and batching have something to do
+    std::vector<std::unique_ptr<Texture>> textures;
+    for (int i = 0; i < TEXTURE_COUNT; i++) {
+        unsigned char pixel[4] = { static_cast<unsigned char>(i * 32), 128, 255, 255 };
+        textures.push_back(std::make_unique<Texture>());
+        textures.back()->createFromData(pixel, 1, 1, 4);
+    }
+
+    ECS ecs;
+    std::vector<Transform*> moving;
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        Entity entity = ecs.createEntity();
+        auto* transform = ecs.addComponent<Transform>(entity);
+        transform->position = Vector2(std::fmod(i * 37.0f, WORLD_SIZE), std::fmod(i * 91.0f, WORLD_SIZE));
+        if (i < MOVING_COUNT) {
+            moving.push_back(transform);
+        }
+
+        auto* sprite = ecs.addComponent<SpriteComponent>(entity);
+        sprite->sprite.setTexture(textures[i % TEXTURE_COUNT].get());
+        sprite->sprite.setSize(Vector2(16, 16));
+    }
+
+    CullingSystem culling(&ecs);
+    Camera camera(static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT));
+    std::vector<Entity> visible;
+
+    // Records the entities over RECORD_JOBS worker lists and submits the frame
+    auto renderFrame = [&](const std::vector<Entity>& entities) {
+        size_t perJob = (entities.size() + RECORD_JOBS - 1) / RECORD_JOBS;
+        for (int job = 0; job < RECORD_JOBS; job++) {
+            size_t begin = job * perJob;
+            size_t end = std::min(entities.size(), begin + perJob);
+            renderer.recordAsync([&ecs, &entities, &camera, begin, end](CommandList& list) {
+                list.setCamera(&camera);
+                for (size_t i = begin; i < end; i++) {
+                    auto* transform = ecs.getComponent<Transform>(entities[i]);
+                    auto* spriteComp = ecs.getComponent<SpriteComponent>(entities[i]);
+                    Sprite sprite = spriteComp->sprite;
+                    sprite.setPosition(transform->position);
+                    list.drawSprite(sprite);
+                }
+            });
+        }
+
+        renderer.executeCommandLists();
+        renderer.flushRenderQueue(&camera);
+        renderer.present();
+    };
+
+    RenderBackend& backend = renderer.getBackend();
+    double totalMs = 0.0;
+    double cullMs = 0.0;
+    RenderBackendStats frameStats;
+    int elidedStates = 0;
+
+    for (int frame = 0; frame < WARMUP_FRAMES + FRAMES; frame++) {
+        bool lastFrame = frame == WARMUP_FRAMES + FRAMES - 1;
+        if (lastFrame && tracePath) {
+            backend.setTraceEnabled(true);
+        }
+        backend.resetStats();
+        GLStateCache::getInstance().resetStats();
+
+        // Game logic, not timed: a few entities move and mark their transforms dirty
+        for (Transform* transform : moving) {
+            transform->position.x = std::fmod(transform->position.x + 4.0f, WORLD_SIZE);
+            transform->dirty = true;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // Pan across the world so the visible set changes every frame
+        camera.setPosition(Vector2(std::fmod(frame * 8.0f, WORLD_SIZE - SCREEN_WIDTH), 1024.0f));
+
+        renderer.clear(0.0f, 0.0f, 0.0f, 1.0f);
+
+        visible.clear();
+        culling.update();
+        culling.cull(camera, visible);
+        auto culled = std::chrono::high_resolution_clock::now();
+
+        renderFrame(visible);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        if (frame >= WARMUP_FRAMES) {
+            totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+            cullMs += std::chrono::duration<double, std::milli>(culled - start).count();
+        }
+
+        frameStats = backend.getStats();
+        elidedStates = GLStateCache::getInstance().getStats().totalElided();
+    }
+    backend.setTraceEnabled(false);
+
+    // Same scene with every sprite submitted and the GPU left to clip
+    std::vector<Entity> everything = ecs.getEntities();
+    double unculledMs = 0.0;
+    for (int frame = 0; frame < UNCULLED_FRAMES; frame++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        renderer.clear(0.0f, 0.0f, 0.0f, 1.0f);
+        renderFrame(everything);
+        auto end = std::chrono::high_resolution_clock::now();
+        unculledMs += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    std::cout << "Headless render (" << (instanced ? "instanced" : "vertices") << "), "
+              << culling.getLastVisibleCount() << " of " << ENTITY_COUNT << " sprites visible" << std::endl;
+    std::cout << "  CPU submission:   " << totalMs / FRAMES << " ms/frame" << std::endl;
+    std::cout << "    update + cull:  " << cullMs / FRAMES << " ms/frame (" << MOVING_COUNT << " moving)" << std::endl;
+    std::cout << "  Without culling:  " << unculledMs / UNCULLED_FRAMES << " ms/frame" << std::endl;
+    std::cout << "  Draw calls:       " << frameStats.drawCalls << std::endl;
+    std::cout << "  State changes:    " << frameStats.stateChanges() << " (" << elidedStates << " elided by cache)" << std::endl;
+    std::cout << "  Uniform updates:  " << frameStats.getCount(RenderCall::SetUniform) << std::endl;
+    std::cout << "  Buffer uploads:   " << frameStats.bufferUploads() << " ("
+              << frameStats.bufferBytesUploaded / 1024 << " KiB)" << std::endl;
+
+    if (tracePath) {
+        std::ofstream out(tracePath);
+        if (!out) {
+            std::cerr << "Failed to open trace file: " << tracePath << std::endl;
+            return 1;
+        }
+        backend.writeTrace(out);
+        std::cout << "  Trace:            " << backend.getTrace().size() << " calls -> " << tracePath << std::endl;
+    }
+
+    if (totalMs / FRAMES >= unculledMs / UNCULLED_FRAMES) {
+        std::cout << "OVER BUDGET" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Hierarchical pathfinding benchmark
+// Crowd budget: every one of AGENT_COUNT agents repaths to a moving target once a
+// second on a walled 512x512 map, spread over the frames, using at most a quarter
+// of the frame time. Also times the incremental rebuild after a door toggles,
+// then checks a sample of paths against plain A* (a single-cluster Pathfinder).
+
+#include "Pathfinder.h"
+#include "BenchmarkMaps.h"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const int AGENT_COUNT = 500;
+const int ROUNDS = 20;
+const int CHECK_STRIDE = 10;            // Every tenth agent is checked against plain A*
+const double ROUND_BUDGET_MS = 250.0;    // Per second of game time
+
+// Ends at start and goal, walkable, one 8-way step at a time, no solid corners cut
+bool isPathValid(const Tilemap& map, const std::vector<TileCoord>& path, TileCoord start, TileCoord goal) {
+    if (path.empty()) return false;
+    if (path.front().x != start.x || path.front().y != start.y) return false;
+    if (path.back().x != goal.x || path.back().y != goal.y) return false;
+
+    for (size_t i = 0; i < path.size(); i++) {
+        if (map.isTileSolid(path[i].x, path[i].y)) return false;
+        if (i == 0) continue;
+
+        int dx = path[i].x - path[i - 1].x;
+        int dy = path[i].y - path[i - 1].y;
+        if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0)) return false;
+        if (dx != 0 && dy != 0 &&
+            (map.isTileSolid(path[i - 1].x + dx, path[i - 1].y) || map.isTileSolid(path[i - 1].x, path[i - 1].y + dy))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Mismatches against plain A* for every CHECK_STRIDE-th agent
+int checkPaths(const Tilemap& map, Pathfinder& pathfinder, Pathfinder& reference,
+               const std::vector<TileCoord>& agents, TileCoord target) {
+    int errors = 0;
+    std::vector<TileCoord> path;
+    std::vector<TileCoord> referencePath;
+    for (size_t i = 0; i < agents.size(); i += CHECK_STRIDE) {
+        const TileCoord& agent = agents[i];
+        bool found = pathfinder.findPath(agent.x, agent.y, target.x, target.y, path);
+        bool referenceFound = reference.findPath(agent.x, agent.y, target.x, target.y, referencePath);
+        if (found != referenceFound || (found && !isPathValid(map, path, agent, target))) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+} // namespace
+
+int main() {
+    Tilemap map(MAP_SIZE, MAP_SIZE, 16, 16);
+    buildRooms(map);
+
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    Pathfinder pathfinder(&map);
+    double buildMs = elapsedMs(buildStart);
+
+    // Agents all over the map; every agent has its own start, so the cache never helps
+    std::vector<TileCoord> agents;
+    for (int i = 0; static_cast<int>(agents.size()) < AGENT_COUNT; i++) {
+        int x = (i * 7919) % MAP_SIZE;
+        int y = (i * 104729 / MAP_SIZE) % MAP_SIZE;
+        if (!map.isTileSolid(x, y)) agents.push_back(TileCoord{ x, y });
+    }
+    pathfinder.setCacheCapacity(0);
+
+    std::vector<TileCoord> path;
+    size_t found = 0;
+    size_t steps = 0;
+    auto repathStart = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < ROUNDS; pass++) {
+        int targetX = MAP_SIZE / 2 + pass * 3;
+        int targetY = MAP_SIZE / 2 + 2;
+        for (const TileCoord& agent : agents) {
+            if (pathfinder.findPath(agent.x, agent.y, targetX, targetY, path)) {
+                found++;
+                steps += path.size();
+            }
+        }
+    }
+    double roundMs = elapsedMs(repathStart) / ROUNDS;
+
+    // Close and reopen one doorway
+    auto updateStart = std::chrono::high_resolution_clock::now();
+    setDoorClosed(map, true);
+    pathfinder.update();
+    setDoorClosed(map, false);
+    pathfinder.update();
+    double updateMs = elapsedMs(updateStart) / 2.0;
+
+    // One cluster covering the map makes the bounded search a plain A*. Checked
+    // with the door closed and open again, so the rebuilt clusters are covered
+    Pathfinder reference(&map, MAP_SIZE);
+    reference.setCacheCapacity(0);
+    TileCoord target = { MAP_SIZE / 2, MAP_SIZE / 2 + 2 };
+    setDoorClosed(map, true);
+    int pathErrors = checkPaths(map, pathfinder, reference, agents, target);
+    setDoorClosed(map, false);
+    pathErrors += checkPaths(map, pathfinder, reference, agents, target);
+
+    const PathfinderStats& stats = pathfinder.getStats();
+    std::cout << "=== Pathfinding Benchmark ===" << std::endl;
+    std::cout << "Map:               " << MAP_SIZE << "x" << MAP_SIZE << " tiles, "
+              << stats.abstractNodes << " abstract nodes" << std::endl;
+    std::cout << "Build:             " << buildMs << " ms" << std::endl;
+    std::cout << "Door toggle:       " << updateMs << " ms" << std::endl;
+    std::cout << "Paths found:       " << found << " / " << AGENT_COUNT * ROUNDS
+              << " (avg " << (found ? steps / found : 0) << " tiles)" << std::endl;
+    std::cout << "Per repath:        " << roundMs * 1000.0 / AGENT_COUNT << " us" << std::endl;
+    std::cout << AGENT_COUNT << " repaths:      " << roundMs << " ms (budget " << ROUND_BUDGET_MS << " ms)" << std::endl;
+    std::cout << "Path check:        " << pathErrors << " mismatches against plain A*" << std::endl;
+
+    if (pathErrors > 0) {
+        std::cout << "INCORRECT PATHS" << std::endl;
+        return 1;
+    }
+    if (roundMs > ROUND_BUDGET_MS) {
+        std::cout << "OVER BUDGET" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
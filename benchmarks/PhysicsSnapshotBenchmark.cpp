@@ -0,0 +1,89 @@
+// Physics snapshot/restore benchmark
+// Rollback netcode budget: 8 save+restore round trips per 16 ms frame at 2k bodies.
+
+#include "Physics.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+namespace {
+
+const int BODY_COUNT = 2000;
+const int ITERATIONS = 1000;
+const int ROLLBACKS_PER_FRAME = 8;
+const double FRAME_BUDGET_MS = 16.0;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+int main() {
+    PhysicsWorld world(Vector2(0, -10.0f));
+    
+    PhysicsShapeDef shapeDef;
+    shapeDef.type = ShapeType::Box;
+    shapeDef.size = Vector2(1.0f, 1.0f);
+    
+    for (int i = 0; i < BODY_COUNT; i++) {
+        PhysicsBodyDef bodyDef;
+        bodyDef.type = (i % 10 == 0) ? BodyType::Static : BodyType::Dynamic;
+        bodyDef.position = Vector2(static_cast<float>(i % 50) * 2.0f, static_cast<float>(i / 50) * 2.0f);
+        bodyDef.linearVelocity = Vector2(static_cast<float>(i % 7) - 3.0f, 0.0f);
+        PhysicsBody* body = world.createBody(bodyDef);
+        world.addShape(body, shapeDef);
+    }
+    
+    // Settle into a representative state
+    for (int i = 0; i < 60; i++) {
+        world.step(1.0f / 60.0f);
+    }
+    
+    std::vector<uint8_t> buffer;
+    world.saveState(buffer); // Warm up the buffer allocation
+    
+    auto saveStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        world.saveState(buffer);
+    }
+    double saveMs = elapsedMs(saveStart) / ITERATIONS;
+    
+    auto restoreStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        if (!world.restoreState(buffer)) {
+            std::cerr << "Restore failed" << std::endl;
+            return 1;
+        }
+    }
+    double restoreMs = elapsedMs(restoreStart) / ITERATIONS;
+    
+    // Rollback pattern: restore, resimulate one tick, save
+    auto rollbackStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        world.restoreState(buffer);
+        world.step(1.0f / 60.0f);
+        world.saveState(buffer);
+    }
+    double rollbackMs = elapsedMs(rollbackStart) / ITERATIONS;
+    
+    double perFrameMs = (saveMs + restoreMs) * ROLLBACKS_PER_FRAME;
+    
+    std::cout << "=== Physics Snapshot Benchmark ===" << std::endl;
+    std::cout << "Bodies:            " << BODY_COUNT << std::endl;
+    std::cout << "Snapshot size:     " << buffer.size() << " bytes" << std::endl;
+    std::cout << "Save:              " << saveMs * 1000.0 << " us" << std::endl;
+    std::cout << "Restore:           " << restoreMs * 1000.0 << " us" << std::endl;
+    std::cout << "Restore+step+save: " << rollbackMs * 1000.0 << " us" << std::endl;
+    std::cout << ROLLBACKS_PER_FRAME << "x save+restore: " << perFrameMs << " ms of "
+              << FRAME_BUDGET_MS << " ms frame" << std::endl;
+    
+    if (perFrameMs > FRAME_BUDGET_MS) {
+        std::cout << "OVER BUDGET" << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
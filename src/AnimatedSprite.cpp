@@ -82,7 +82,16 @@ void AnimatedSprite::update(float deltaTime) {
 
 void AnimatedSprite::setTexture(Texture* texture) {
     m_texture = texture;
+    m_region = TextureRegion();
     m_sprite.setTexture(texture);
+    updateSpriteFrame();
+}
+
+void AnimatedSprite::setRegion(const TextureRegion& region) {
+    m_texture = region.texture;
+    m_region = region;
+    m_sprite.setRegion(region);
+    updateSpriteFrame();
 }
 
 void AnimatedSprite::setPosition(const Vector2& pos) {
@@ -114,6 +123,10 @@ void AnimatedSprite::drawWithCamera(Shader* shader, Camera* camera, int screenWi
     m_sprite.drawWithCamera(shader, camera, screenWidth, screenHeight);
 }
 
+void AnimatedSprite::draw(SpriteBatch& batch) const {
+    m_sprite.draw(batch);
+}
+
 void AnimatedSprite::updateSpriteFrame() {
     if (!m_currentAnimation || !m_texture) {
         return;
@@ -121,11 +134,19 @@ void AnimatedSprite::updateSpriteFrame() {
     
     // Get current frame data
     AnimFrame frame = m_currentAnimation->getFrame(m_currentFrame);
+    if (frame.width <= 0 || frame.height <= 0) {
+        return;
+    }
     
-    // For now, we'll just store the frame data
-    // In a full implementation, you'd update texture coordinates here
-    // This is a simplified version that works with full sprite sheets
+    float texWidth = static_cast<float>(m_texture->getWidth());
+    float texHeight = static_cast<float>(m_texture->getHeight());
+    if (texWidth <= 0.0f || texHeight <= 0.0f) {
+        return;
+    }
     
-    // You could implement texture coordinate updates in Sprite class
-    // or use a shader-based approach with UV offsets
+    // Frame rects are in sprite sheet pixels; offset into the atlas region if there is one
+    float x = static_cast<float>(m_region.x + frame.x);
+    float y = static_cast<float>(m_region.y + frame.y);
+    m_sprite.setTextureRect(Vector2(x / texWidth, y / texHeight),
+                            Vector2((x + frame.width) / texWidth, (y + frame.height) / texHeight));
 }
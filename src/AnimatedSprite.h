@@ -27,6 +27,7 @@ public:
     
     // Sprite properties
     void setTexture(Texture* texture);
+    void setRegion(const TextureRegion& region); // Sprite sheet packed in an atlas; frames are relative to it
     void setPosition(const Vector2& pos);
     void setSize(const Vector2& size);
     void setColor(const Color& color);
@@ -37,6 +38,7 @@ public:
     // Rendering
     void draw(Shader* shader, int screenWidth, int screenHeight);
     void drawWithCamera(Shader* shader, Camera* camera, int screenWidth, int screenHeight);
+    void draw(SpriteBatch& batch) const;
     
     // Get underlying sprite
     Sprite& getSprite() { return m_sprite; }
@@ -56,6 +58,7 @@ private:
     bool m_paused;
     
     Texture* m_texture;
+    TextureRegion m_region;
     Vector2 m_baseSize; // Original sprite size before animation frames
 };
 
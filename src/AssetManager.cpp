@@ -1,4 +1,5 @@
 #include "AssetManager.h"
+#include "AsyncTextureLoader.h"
 #include <iostream>
 
 AssetManager& AssetManager::getInstance() {
@@ -28,6 +29,24 @@ Texture* AssetManager::loadTexture(const std::string& name, const std::string& f
     return texture.get();
 }
 
+Texture* AssetManager::loadTextureAsync(const std::string& name, const std::string& filepath) {
+    auto it = m_textures.find(name);
+    if (it != m_textures.end()) {
+        return it->second.get();
+    }
+
+    auto texture = std::make_shared<Texture>();
+    AsyncTextureLoader::getInstance().load(texture, filepath);
+    if (texture->getState() == TextureState::Failed) {
+        std::cerr << "AssetManager: Failed to queue texture '" << name << "' from " << filepath << std::endl;
+        return nullptr;
+    }
+
+    m_textures[name] = texture;
+    std::cout << "AssetManager: Queued texture '" << name << "' for async loading" << std::endl;
+    return texture.get();
+}
+
 Texture* AssetManager::getTexture(const std::string& name) {
     auto it = m_textures.find(name);
     if (it != m_textures.end()) {
@@ -50,8 +69,47 @@ void AssetManager::unloadTexture(const std::string& name) {
     }
 }
 
+// Atlas management
+TextureAtlas& AssetManager::getAtlas() {
+    if (!m_atlas) {
+        m_atlas = std::make_unique<TextureAtlas>();
+    }
+    return *m_atlas;
+}
+
+TextureRegion AssetManager::loadTextureRegion(const std::string& name, const std::string& filepath) {
+    TextureAtlas& atlas = getAtlas();
+    if (atlas.hasRegion(name)) {
+        return atlas.getRegion(name);
+    }
+
+    TextureRegion region;
+    if (!atlas.addFromFile(name, filepath, region)) {
+        std::cerr << "AssetManager: Failed to pack texture '" << name << "' from " << filepath << std::endl;
+        return TextureRegion();
+    }
+
+    std::cout << "AssetManager: Packed texture '" << name << "' (" << region.width << "x" << region.height
+              << ") into atlas page " << atlas.getPageCount() << std::endl;
+    return region;
+}
+
+TextureRegion AssetManager::getTextureRegion(const std::string& name) {
+    if (m_atlas && m_atlas->hasRegion(name)) {
+        return m_atlas->getRegion(name);
+    }
+
+    std::cerr << "AssetManager: Texture region '" << name << "' not found" << std::endl;
+    return TextureRegion();
+}
+
+bool AssetManager::hasTextureRegion(const std::string& name) const {
+    return m_atlas && m_atlas->hasRegion(name);
+}
+
 // Shader management
-Shader* AssetManager::loadShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc) {
+Shader* AssetManager::loadShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc,
+                                 const ShaderDefines& defines) {
     // Check if already loaded
     auto it = m_shaders.find(name);
     if (it != m_shaders.end()) {
@@ -61,7 +119,7 @@ Shader* AssetManager::loadShader(const std::string& name, const std::string& ver
 
     // Create and compile new shader
     auto shader = std::make_shared<Shader>();
-    if (!shader->loadFromSource(vertexSrc, fragmentSrc)) {
+    if (!shader->loadFromSource(vertexSrc, fragmentSrc, defines)) {
         std::cerr << "AssetManager: Failed to load shader '" << name << "'" << std::endl;
         return nullptr;
     }
@@ -104,6 +162,9 @@ void AssetManager::unloadAll() {
 void AssetManager::unloadAllTextures() {
     std::cout << "AssetManager: Unloading " << m_textures.size() << " texture(s)" << std::endl;
     m_textures.clear();
+    if (m_atlas) {
+        m_atlas->clear();
+    }
 }
 
 void AssetManager::unloadAllShaders() {
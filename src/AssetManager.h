@@ -6,6 +6,7 @@
 #include <memory>
 #include "Texture.h"
 #include "Shader.h"
+#include "TextureAtlas.h"
 
 class AssetManager {
 public:
@@ -13,12 +14,22 @@ public:
 
     // Texture management
     Texture* loadTexture(const std::string& name, const std::string& filepath);
+    // Returns at once; the texture shows a placeholder until AsyncTextureLoader
+    // has decoded and uploaded it (see Texture::getState)
+    Texture* loadTextureAsync(const std::string& name, const std::string& filepath);
     Texture* getTexture(const std::string& name);
     bool hasTexture(const std::string& name) const;
     void unloadTexture(const std::string& name);
-
-    // Shader management
-    Shader* loadShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+    
+    // Atlas-packed textures: images share pages so their sprites batch together
+    TextureRegion loadTextureRegion(const std::string& name, const std::string& filepath);
+    TextureRegion getTextureRegion(const std::string& name);
+    bool hasTextureRegion(const std::string& name) const;
+    TextureAtlas& getAtlas();
+
+    // Shader management; further variants of a loaded shader come from Shader::getVariant
+    Shader* loadShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc,
+                       const ShaderDefines& defines = ShaderDefines());
     Shader* getShader(const std::string& name);
     bool hasShader(const std::string& name) const;
     void unloadShader(const std::string& name);
@@ -39,6 +50,7 @@ private:
 
     std::unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
     std::unordered_map<std::string, std::shared_ptr<Shader>> m_shaders;
+    std::unique_ptr<TextureAtlas> m_atlas;
 };
 
 #endif // OMEGA_ASSET_MANAGER_H
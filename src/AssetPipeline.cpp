@@ -1,4 +1,6 @@
 #include "AssetPipeline.h"
+#include "CookedTexture.h"
+#include "stb_image.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -14,29 +16,45 @@ namespace fs = std::filesystem;
 bool TextureProcessor::process(const std::string& inputPath, const std::string& outputPath, AssetMetadata& metadata) {
     std::cout << "Processing texture: " << inputPath << std::endl;
     
-    // In a real implementation, you would:
-    // 1. Load the image using stb_image or similar
-    // 2. Apply compression if enabled
-    // 3. Generate mipmaps if enabled
-    // 4. Save to custom format
-    
-    // For now, just copy the file
-    try {
-        fs::copy_file(inputPath, outputPath, fs::copy_options::overwrite_existing);
-        
-        metadata.type = "texture";
-        metadata.sourcePath = inputPath;
-        metadata.outputPath = outputPath;
-        metadata.customData["compression"] = m_compressionEnabled ? "true" : "false";
-        metadata.customData["mipmaps"] = m_mipmapEnabled ? "true" : "false";
-        
-        std::cout << "Texture processed: " << outputPath << std::endl;
-        return true;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* pixels = stbi_load(inputPath.c_str(), &width, &height, &channels, 0);
+    if (!pixels) {
+        std::cerr << "Failed to process texture: " << inputPath << " (" << stbi_failure_reason() << ")" << std::endl;
+        return false;
     }
-    catch (const std::exception& e) {
-        std::cerr << "Failed to process texture: " << e.what() << std::endl;
+    
+    // Premultiply and bake the mip chain offline so loading is a straight upload
+    CookedTextureOptions options;
+    options.premultiplyAlpha = m_premultiplyAlpha;
+    options.mipmaps = m_mipmapEnabled;
+    
+    std::vector<unsigned char> image;
+    bool cooked = CookedTexture::cook(pixels, width, height, channels, options, image);
+    stbi_image_free(pixels);
+    
+    if (!cooked || !CookedTexture::writeFile(outputPath, image)) {
+        std::cerr << "Failed to process texture: " << inputPath << std::endl;
         return false;
     }
+    
+    CookedTexture header;
+    header.parse(image.data(), image.size());
+    
+    metadata.type = "texture";
+    metadata.sourcePath = inputPath;
+    metadata.outputPath = outputPath;
+    metadata.customData["compression"] = m_compressionEnabled ? "true" : "false";
+    metadata.customData["mipmaps"] = m_mipmapEnabled ? "true" : "false";
+    metadata.customData["width"] = std::to_string(width);
+    metadata.customData["height"] = std::to_string(height);
+    metadata.customData["channels"] = std::to_string(channels);
+    metadata.customData["levels"] = std::to_string(header.getLevelCount());
+    metadata.customData["premultiplied"] = header.isPremultiplied() ? "true" : "false";
+    
+    std::cout << "Texture processed: " << outputPath << std::endl;
+    return true;
 }
 
 // ============================================================================
@@ -36,10 +36,12 @@ public:
     
     void setCompressionEnabled(bool enabled) { m_compressionEnabled = enabled; }
     void setMipmapEnabled(bool enabled) { m_mipmapEnabled = enabled; }
+    void setPremultiplyAlpha(bool enabled) { m_premultiplyAlpha = enabled; }
 
 private:
-    bool m_compressionEnabled = false;
-    bool m_mipmapEnabled = false;
+    bool m_compressionEnabled = false;  // Reserved; no block compressor yet
+    bool m_mipmapEnabled = true;
+    bool m_premultiplyAlpha = true;
 };
 
 // Audio processor
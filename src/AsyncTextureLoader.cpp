@@ -0,0 +1,315 @@
+#include "AsyncTextureLoader.h"
+#include "Texture.h"
+#include "ThreadPool.h"
+#include "StreamBuffer.h"
+#include "MappedFile.h"
+#include "CookedTexture.h"
+#include "RenderBackend.h"
+#include "GLStateCache.h"
+#include "stb_image.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+struct AsyncTextureLoader::DecodedImage {
+    MappedFile file;                    // .otex: levels point into the mapping
+    std::vector<unsigned char> cooked;  // Decoded images, cooked in memory
+    CookedTexture image;
+};
+
+struct AsyncTextureLoader::UploadJob {
+    std::shared_ptr<Texture> texture;
+    std::string filepath;
+    std::unique_ptr<DecodedImage> decoded;  // Null if decoding failed
+    GLuint target = 0;                      // Real texture, swapped in on completion
+    int level = 0;
+    int row = 0;
+};
+
+namespace {
+
+GLenum glFormat(OTexPixelFormat format) {
+    switch (format) {
+        case OTexPixelFormat::R8: return GL_RED;
+        case OTexPixelFormat::RG8: return GL_RG;
+        case OTexPixelFormat::RGB8: return GL_RGB;
+        case OTexPixelFormat::RGBA8: return GL_RGBA;
+    }
+    return GL_RGBA;
+}
+
+bool hasExtension(const std::string& path, const std::string& extension) {
+    return path.size() >= extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+} // namespace
+
+AsyncTextureLoader& AsyncTextureLoader::getInstance() {
+    static AsyncTextureLoader instance;
+    return instance;
+}
+
+AsyncTextureLoader::AsyncTextureLoader()
+    : m_decoding(0)
+    , m_cancelled(false)
+    , m_uploadBudget(DEFAULT_UPLOAD_BUDGET)
+    , m_workerCount(DEFAULT_WORKER_COUNT)
+    , m_uploadedLastFrame(0) {
+}
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+    // GL objects are gone by now (shutdown); only stop the workers
+    m_cancelled = true;
+    m_pool.reset();
+}
+
+std::unique_ptr<AsyncTextureLoader::DecodedImage> AsyncTextureLoader::decode(const std::string& filepath) {
+    auto decoded = std::make_unique<DecodedImage>();
+
+    if (hasExtension(filepath, ".otex")) {
+        if (!decoded->file.open(filepath) || !decoded->image.parse(decoded->file.getData(), decoded->file.getSize())) {
+            return nullptr;
+        }
+        return decoded;
+    }
+
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* pixels = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
+    if (!pixels) {
+        return nullptr;
+    }
+
+    // Same result as Texture::loadFromFile (straight alpha, full mip chain),
+    // but the mips are built here instead of on the GL thread
+    CookedTextureOptions options;
+    options.premultiplyAlpha = false;
+    options.mipmaps = true;
+    bool ok = CookedTexture::cook(pixels, width, height, channels, options, decoded->cooked);
+    stbi_image_free(pixels);
+
+    if (!ok || !decoded->image.parse(decoded->cooked.data(), decoded->cooked.size())) {
+        return nullptr;
+    }
+    return decoded;
+}
+
+bool AsyncTextureLoader::ensureResources() {
+    if (!m_placeholder) {
+        unsigned char transparent[4] = { 0, 0, 0, 0 };
+        m_placeholder = std::make_unique<Texture>();
+        if (!m_placeholder->createFromData(transparent, 1, 1, 4)) {
+            m_placeholder.reset();
+            return false;
+        }
+    }
+
+    if (!m_pool) {
+        m_cancelled = false;
+        m_pool = std::make_unique<ThreadPool>(m_workerCount);
+    }
+
+    if (!m_pixelRing) {
+        m_pixelRing = std::make_unique<StreamBuffer>(GL_PIXEL_UNPACK_BUFFER, m_uploadBudget);
+        if (!m_pixelRing->initialize()) {
+            std::cerr << "AsyncTextureLoader: Failed to create pixel buffer ring" << std::endl;
+            m_pixelRing.reset();
+        }
+        // An unpack buffer left bound would turn every other texture upload into a PBO read
+        RenderBackend::getActive().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    return true;
+}
+
+void AsyncTextureLoader::load(std::shared_ptr<Texture> texture, const std::string& filepath) {
+    if (!texture) return;
+    if (!ensureResources()) {
+        std::cerr << "AsyncTextureLoader: Cannot create placeholder texture" << std::endl;
+        texture->setFailed();
+        return;
+    }
+
+    texture->setPlaceholder(m_placeholder->getID());
+
+    auto job = std::make_shared<UploadJob>();
+    job->texture = std::move(texture);
+    job->filepath = filepath;
+
+    m_decoding++;
+    m_pool->submit([this, job]() {
+        auto result = std::make_unique<UploadJob>();
+        result->texture = std::move(job->texture);
+        result->filepath = std::move(job->filepath);
+        if (!m_cancelled) {
+            result->decoded = decode(result->filepath);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.push_back(std::move(result));
+        m_decoding--;
+    });
+}
+
+void AsyncTextureLoader::collectDecoded() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_decoded.empty()) {
+        std::unique_ptr<UploadJob> job = std::move(m_decoded.front());
+        m_decoded.pop_front();
+
+        if (!job->decoded) {
+            std::cerr << "AsyncTextureLoader: Failed to load texture: " << job->filepath << std::endl;
+            job->texture->setFailed();
+            continue;
+        }
+        m_uploads.push_back(std::move(job));
+    }
+}
+
+bool AsyncTextureLoader::uploadStep(UploadJob& job, size_t& budget) {
+    RenderBackend& backend = RenderBackend::getActive();
+    GLStateCache& state = GLStateCache::getInstance();
+    const CookedTexture& image = job.decoded->image;
+    GLenum format = glFormat(image.getFormat());
+    int levelCount = image.getLevelCount();
+    size_t channels = static_cast<size_t>(image.getChannels());
+
+    if (job.target == 0) {
+        job.target = backend.createTexture();
+    }
+    state.bindTexture(0, job.target);
+
+    while (job.level < levelCount && budget > 0) {
+        const OTexLevel& level = image.getLevel(job.level);
+        int width = static_cast<int>(level.width);
+        int height = static_cast<int>(level.height);
+        size_t rowBytes = width * channels;
+
+        // Whole rows only; a frame that has uploaded nothing yet takes at least
+        // one so rows larger than the budget still make progress
+        size_t limit = std::min(budget, m_pixelRing ? m_pixelRing->getSegmentSize() : budget);
+        size_t fit = limit / rowBytes;
+        if (fit == 0) {
+            if (m_uploadedLastFrame > 0) break;
+            fit = 1;
+        }
+
+        // Storage first, filled band by band
+        if (job.row == 0) {
+            backend.textureLevel(job.level, levelCount, width, height, format, nullptr);
+        }
+
+        int rows = static_cast<int>(std::min<size_t>(static_cast<size_t>(height - job.row), fit));
+        size_t bytes = rows * rowBytes;
+        const unsigned char* source = image.getLevelData(job.level) + job.row * rowBytes;
+
+        size_t offset = StreamBuffer::INVALID_OFFSET;
+        if (m_pixelRing && bytes <= m_pixelRing->getSegmentSize()) {
+            offset = m_pixelRing->write(source, bytes, 4);
+        }
+
+        if (offset != StreamBuffer::INVALID_OFFSET) {
+            backend.bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelRing->getBuffer());
+            backend.textureSubImage(0, job.row, width, rows, format, reinterpret_cast<const void*>(offset), job.level);
+            backend.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        } else {
+            // Band larger than the ring (or no ring): plain client-memory upload
+            backend.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            backend.textureSubImage(0, job.row, width, rows, format, source, job.level);
+        }
+
+        budget -= std::min(budget, bytes);
+        m_uploadedLastFrame += bytes;
+        job.row += rows;
+        if (job.row >= height) {
+            job.level++;
+            job.row = 0;
+        }
+    }
+
+    state.bindTexture(0, 0);
+    return job.level >= levelCount;
+}
+
+void AsyncTextureLoader::complete(UploadJob& job) {
+    const CookedTexture& image = job.decoded->image;
+
+    if (job.texture.use_count() == 1) {
+        // Unloaded while in flight; nobody will ever see it
+        GLStateCache::getInstance().onTextureDeleted(job.target);
+        RenderBackend::getActive().deleteTexture(job.target);
+    } else {
+        job.texture->adopt(job.target, image.getWidth(), image.getHeight(), image.isPremultiplied());
+        std::cout << "AsyncTextureLoader: Texture resident: " << job.filepath << " (" << image.getWidth()
+                  << "x" << image.getHeight() << ", " << image.getLevelCount() << " levels)" << std::endl;
+    }
+    job.target = 0;
+}
+
+void AsyncTextureLoader::update() {
+    m_uploadedLastFrame = 0;
+    if (!m_pool) return;
+
+    collectDecoded();
+
+    size_t budget = m_uploadBudget;
+    while (!m_uploads.empty() && budget > 0) {
+        UploadJob& job = *m_uploads.front();
+        if (!uploadStep(job, budget)) break;
+
+        complete(job);
+        m_uploads.pop_front();
+    }
+
+    if (m_pixelRing) {
+        m_pixelRing->endFrame();
+    }
+}
+
+void AsyncTextureLoader::finishAll() {
+    if (!m_pool) return;
+
+    m_pool->waitIdle();
+    collectDecoded();
+
+    size_t unlimited = static_cast<size_t>(-1);
+    while (!m_uploads.empty()) {
+        UploadJob& job = *m_uploads.front();
+        uploadStep(job, unlimited);
+        complete(job);
+        m_uploads.pop_front();
+    }
+}
+
+void AsyncTextureLoader::shutdown() {
+    m_cancelled = true;
+    m_pool.reset(); // Joins; cancelled jobs finish without decoding
+
+    RenderBackend& backend = RenderBackend::getActive();
+    for (auto& job : m_uploads) {
+        if (job->target != 0) {
+            GLStateCache::getInstance().onTextureDeleted(job->target);
+            backend.deleteTexture(job->target);
+        }
+        job->texture->setFailed();
+    }
+    m_uploads.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& job : m_decoded) {
+            job->texture->setFailed();
+        }
+        m_decoded.clear();
+    }
+
+    m_pixelRing.reset();
+    m_placeholder.reset();
+}
+
+size_t AsyncTextureLoader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(m_decoding.load()) + m_decoded.size() + m_uploads.size();
+}
@@ -0,0 +1,86 @@
+#ifndef OMEGA_ASYNC_TEXTURE_LOADER_H
+#define OMEGA_ASYNC_TEXTURE_LOADER_H
+
+#include <GL/glew.h>
+#include <string>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+class Texture;
+class ThreadPool;
+class StreamBuffer;
+class MappedFile;
+class CookedTexture;
+
+// Loads textures without stalling the frame. Files are read and decoded on a
+// thread pool (.otex is mapped, other images are decoded and get a CPU-built
+// mip chain); the render thread then streams the levels through a pixel
+// buffer ring, at most getUploadBudget() bytes per frame, splitting large
+// levels into row bands across frames.
+// The Texture handed to load() shows a shared transparent placeholder until
+// its last band is uploaded, then switches to the real texture in place, so
+// sprites can hold on to it from the start.
+// load(), update(), finishAll() and shutdown() belong to the render thread.
+class AsyncTextureLoader {
+public:
+    static AsyncTextureLoader& getInstance();
+
+    static const size_t DEFAULT_UPLOAD_BUDGET = 4 * 1024 * 1024;
+    static const int DEFAULT_WORKER_COUNT = 2;
+
+    // Returns immediately; texture enters TextureState::Loading
+    void load(std::shared_ptr<Texture> texture, const std::string& filepath);
+
+    // Once per frame (Renderer::present): picks up decoded images and uploads within the budget
+    void update();
+
+    // Blocks until everything queued so far is resident (loading screens, tests)
+    void finishAll();
+
+    // Drops outstanding work and releases GL objects; call before the context goes away
+    void shutdown();
+
+    // Takes effect for the next frame; the pixel ring is sized from the budget when first created
+    void setUploadBudget(size_t bytesPerFrame) { m_uploadBudget = bytesPerFrame > 0 ? bytesPerFrame : 1; }
+    size_t getUploadBudget() const { return m_uploadBudget; }
+
+    // Before the first load()
+    void setWorkerCount(int count) { m_workerCount = count; }
+
+    size_t getPendingCount() const;     // Decoding + waiting for upload + uploading
+    size_t getUploadedBytesLastFrame() const { return m_uploadedLastFrame; }
+
+private:
+    struct DecodedImage;
+    struct UploadJob;
+
+    AsyncTextureLoader();
+    ~AsyncTextureLoader();
+    AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+    AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+    static std::unique_ptr<DecodedImage> decode(const std::string& filepath);
+
+    bool ensureResources();
+    void collectDecoded();
+    bool uploadStep(UploadJob& job, size_t& budget);
+    void complete(UploadJob& job);
+
+    std::unique_ptr<ThreadPool> m_pool;
+    std::unique_ptr<StreamBuffer> m_pixelRing;
+    std::unique_ptr<Texture> m_placeholder;
+
+    mutable std::mutex m_mutex;
+    std::deque<std::unique_ptr<UploadJob>> m_decoded;  // Filled by workers
+    std::deque<std::unique_ptr<UploadJob>> m_uploads;  // Render thread only
+    std::atomic<int> m_decoding;
+    std::atomic<bool> m_cancelled;
+
+    size_t m_uploadBudget;
+    int m_workerCount;
+    size_t m_uploadedLastFrame;
+};
+
+#endif // OMEGA_ASYNC_TEXTURE_LOADER_H
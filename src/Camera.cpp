@@ -108,6 +108,24 @@ Vector2 Camera::worldToScreen(const Vector2& worldPos) const {
     );
 }
 
+ViewBounds Camera::getVisibleBounds(float margin) const {
+    Vector2 offset = getViewOffset();
+    ViewBounds bounds;
+    bounds.left = offset.x - margin;
+    bounds.top = offset.y - margin;
+    bounds.right = offset.x + m_screenWidth / m_zoom + margin;
+    bounds.bottom = offset.y + m_screenHeight / m_zoom + margin;
+    return bounds;
+}
+
+bool Camera::isInView(const Vector2& position, const Vector2& size, float margin) const {
+    return getVisibleBounds(margin).intersects(position, size);
+}
+
+bool Camera::isInView(const Vector2& point) const {
+    return getVisibleBounds().contains(point);
+}
+
 Vector2 Camera::getViewOffset() const {
     // Calculate top-left corner of camera view
     Vector2 finalPos = m_position;
@@ -4,6 +4,19 @@
 #include "Sprite.h"
 #include <cmath>
 
+// World-space rectangle seen by a camera
+struct ViewBounds {
+    float left, top, right, bottom;
+    
+    bool contains(const Vector2& point) const {
+        return point.x >= left && point.x <= right && point.y >= top && point.y <= bottom;
+    }
+    bool intersects(const Vector2& position, const Vector2& size) const {
+        return position.x <= right && position.x + size.x >= left &&
+               position.y <= bottom && position.y + size.y >= top;
+    }
+};
+
 class Camera {
 public:
     Camera(float screenWidth, float screenHeight);
@@ -43,6 +56,11 @@ public:
     Vector2 getViewOffset() const;
     float getViewScale() const { return m_zoom; }
     
+    // Visibility (world space, includes zoom and shake)
+    ViewBounds getVisibleBounds(float margin = 0.0f) const;
+    bool isInView(const Vector2& position, const Vector2& size, float margin = 0.0f) const;
+    bool isInView(const Vector2& point) const;
+    
     // Reset camera
     void reset();
 
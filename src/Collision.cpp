@@ -238,6 +238,10 @@ void CollisionSystem::resolveCollision(Entity a, Entity b, const CollisionInfo&
         transformB->position.x += info.normal.x * info.penetration;
         transformB->position.y += info.normal.y * info.penetration;
     }
+    
+    // Moved transforms need re-bucketing by the culling grid
+    if (!colliderA->isStatic) transformA->dirty = true;
+    if (!colliderB->isStatic) transformB->dirty = true;
 }
 
 Vector2 CollisionSystem::getEntityPosition(Entity entity) {
@@ -0,0 +1,105 @@
+#include "CommandList.h"
+#include <new>
+
+// ============================================================================
+// LinearAllocator Implementation
+// ============================================================================
+
+LinearAllocator::LinearAllocator(size_t blockSize)
+    : m_blockSize(blockSize)
+    , m_blockIndex(0)
+    , m_blockOffset(0)
+    , m_usedBytes(0) {
+}
+
+void* LinearAllocator::allocate(size_t size, size_t alignment) {
+    if (size > m_blockSize) {
+        return nullptr;
+    }
+    
+    while (true) {
+        if (m_blockIndex == m_blocks.size()) {
+            m_blocks.push_back(std::unique_ptr<unsigned char[]>(new unsigned char[m_blockSize]));
+        }
+        
+        unsigned char* base = m_blocks[m_blockIndex].get();
+        uintptr_t address = reinterpret_cast<uintptr_t>(base + m_blockOffset);
+        size_t padding = (alignment - (address % alignment)) % alignment;
+        
+        if (m_blockOffset + padding + size <= m_blockSize) {
+            void* result = base + m_blockOffset + padding;
+            m_blockOffset += padding + size;
+            m_usedBytes += size;
+            return result;
+        }
+        
+        // Current block is full, move to the next (reusing it if it exists)
+        m_blockIndex++;
+        m_blockOffset = 0;
+    }
+}
+
+void LinearAllocator::reset() {
+    m_blockIndex = 0;
+    m_blockOffset = 0;
+    m_usedBytes = 0;
+}
+
+// ============================================================================
+// CommandList Implementation
+// ============================================================================
+
+CommandList::CommandList(LinearAllocator* allocator)
+    : m_allocator(allocator)
+    , m_head(nullptr)
+    , m_tail(nullptr)
+    , m_count(0) {
+}
+
+template<typename T>
+T* CommandList::append(CommandType type) {
+    void* memory = m_allocator->allocate(sizeof(T), alignof(T));
+    if (!memory) return nullptr;
+    
+    // Payloads are trivially destructible; the allocator reset reclaims them
+    T* command = new (memory) T();
+    command->header.type = type;
+    command->header.next = nullptr;
+    
+    if (m_tail) {
+        m_tail->next = &command->header;
+    } else {
+        m_head = &command->header;
+    }
+    m_tail = &command->header;
+    m_count++;
+    return command;
+}
+
+void CommandList::setCamera(Camera* camera) {
+    SetCameraCommand* command = append<SetCameraCommand>(CommandType::SetCamera);
+    if (command) {
+        command->camera = camera;
+    }
+}
+
+void CommandList::drawSprite(const RenderCommand& renderCommand, uint8_t layer, float depth) {
+    DrawSpriteCommand* command = append<DrawSpriteCommand>(CommandType::DrawSprite);
+    if (!command) return;
+    
+    command->key = RenderQueue::makeKey(renderCommand, layer, depth);
+    command->command = renderCommand;
+}
+
+void CommandList::drawSprite(const Sprite& sprite, uint8_t layer, float depth) {
+    RenderCommand command;
+    command.texture = sprite.getTexture();
+    command.position = sprite.getPosition();
+    command.size = sprite.getSize();
+    command.color = sprite.getColor();
+    command.rotation = sprite.getRotation();
+    command.uv0 = sprite.getUV0();
+    command.uv1 = sprite.getUV1();
+    command.blendMode = BlendMode::Alpha; // Sprites draw blended, as Sprite::draw does
+    drawSprite(command, layer, depth);
+}
@@ -0,0 +1,81 @@
+#ifndef OMEGA_COMMAND_LIST_H
+#define OMEGA_COMMAND_LIST_H
+
+#include "RenderQueue.h"
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+class Camera;
+
+// Bump allocator for per-frame recording. Not thread-safe: each recording
+// thread owns one. reset() keeps the blocks for the next frame.
+class LinearAllocator {
+public:
+    LinearAllocator(size_t blockSize = 64 * 1024);
+    ~LinearAllocator() = default;
+    
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    void reset();
+    
+    size_t getUsedBytes() const { return m_usedBytes; }
+    size_t getCapacity() const { return m_blocks.size() * m_blockSize; }
+
+private:
+    size_t m_blockSize;
+    std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+    size_t m_blockIndex;
+    size_t m_blockOffset;
+    size_t m_usedBytes;
+};
+
+enum class CommandType : uint8_t {
+    SetCamera,
+    DrawSprite
+};
+
+// Header shared by every recorded command; payload follows in the same allocation
+struct CommandHeader {
+    CommandType type;
+    CommandHeader* next;
+};
+
+struct SetCameraCommand {
+    CommandHeader header;
+    Camera* camera;
+};
+
+struct DrawSpriteCommand {
+    CommandHeader header;
+    RenderKey key;
+    RenderCommand command;
+};
+
+// API-agnostic list of draw commands, recorded on any thread and executed later
+// on the GL thread. Commands live in the recording thread's LinearAllocator and
+// are only valid until that allocator is reset.
+class CommandList {
+public:
+    explicit CommandList(LinearAllocator* allocator);
+    
+    // Draws after this use the camera (nullptr = screen space); a list starts in screen space
+    void setCamera(Camera* camera);
+    void drawSprite(const RenderCommand& command, uint8_t layer = 0, float depth = 0.0f);
+    void drawSprite(const Sprite& sprite, uint8_t layer = 0, float depth = 0.0f);
+    
+    const CommandHeader* begin() const { return m_head; }
+    size_t getCommandCount() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+
+private:
+    template<typename T>
+    T* append(CommandType type);
+    
+    LinearAllocator* m_allocator;
+    CommandHeader* m_head;
+    CommandHeader* m_tail;
+    size_t m_count;
+};
+
+#endif // OMEGA_COMMAND_LIST_H
@@ -0,0 +1,136 @@
+#include "CommandRecorder.h"
+#include "RenderQueue.h"
+#include "SpriteBatch.h"
+#include <algorithm>
+
+CommandRecorder::CommandRecorder(int workerCount)
+    : m_outstanding(0)
+    , m_shutdown(false) {
+    
+    if (workerCount <= 0) {
+        // Leave a core for the GL thread
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::min(std::max(hardware - 1, 1), 4);
+    }
+    
+    for (int i = 0; i <= workerCount; i++) {
+        m_allocators.push_back(std::make_unique<LinearAllocator>());
+    }
+    for (int i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&CommandRecorder::workerLoop, this, i);
+    }
+}
+
+CommandRecorder::~CommandRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_jobAvailable.notify_all();
+    
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void CommandRecorder::recordAsync(RecordJob job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_slots.emplace_back();
+        m_jobs.push_back({ std::move(job), m_slots.size() - 1 });
+        m_outstanding++;
+    }
+    m_jobAvailable.notify_one();
+}
+
+CommandList& CommandRecorder::createCommandList() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots.emplace_back();
+    Slot& slot = m_slots.back();
+    slot.list = std::make_unique<CommandList>(m_allocators.back().get());
+    return *slot.list;
+}
+
+void CommandRecorder::workerLoop(int workerIndex) {
+    LinearAllocator* allocator = m_allocators[workerIndex].get();
+    
+    while (true) {
+        PendingJob pending;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] { return m_shutdown || !m_jobs.empty(); });
+            if (m_shutdown && m_jobs.empty()) return;
+            
+            pending = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        
+        // Record outside the lock; only this worker touches its allocator
+        auto list = std::make_unique<CommandList>(allocator);
+        pending.job(*list);
+        
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Slot& slot = m_slots[pending.slot];
+            slot.list = std::move(list);
+            m_outstanding--;
+        }
+        m_jobDone.notify_all();
+    }
+}
+
+void CommandRecorder::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDone.wait(lock, [this] { return m_outstanding == 0; });
+}
+
+void CommandRecorder::execute(RenderQueue& queue, SpriteBatch& batch, int screenWidth, int screenHeight) {
+    waitIdle();
+    
+    // Workers are idle now, so the slots can be read without the lock.
+    // Consecutive draws under the same camera are merged into one sorted flush.
+    Camera* camera = nullptr;
+    auto useCamera = [&](Camera* next) {
+        if (next == camera) return;
+        if (queue.getCommandCount() > 0) {
+            queue.execute(batch, screenWidth, screenHeight, camera);
+        }
+        camera = next;
+    };
+    
+    for (Slot& slot : m_slots) {
+        if (!slot.list) continue;
+        
+        // Every list starts in screen space, whatever the previous one left set
+        useCamera(nullptr);
+        for (const CommandHeader* header = slot.list->begin(); header; header = header->next) {
+            switch (header->type) {
+                case CommandType::SetCamera: {
+                    useCamera(reinterpret_cast<const SetCameraCommand*>(header)->camera);
+                    break;
+                }
+                case CommandType::DrawSprite: {
+                    const DrawSpriteCommand* draw = reinterpret_cast<const DrawSpriteCommand*>(header);
+                    queue.submit(draw->key, draw->command);
+                    break;
+                }
+            }
+        }
+    }
+    if (queue.getCommandCount() > 0) {
+        queue.execute(batch, screenWidth, screenHeight, camera);
+    }
+    
+    m_slots.clear();
+    for (auto& allocator : m_allocators) {
+        allocator->reset();
+    }
+}
+
+size_t CommandRecorder::getRecordedBytes() const {
+    size_t total = 0;
+    for (const auto& allocator : m_allocators) {
+        total += allocator->getUsedBytes();
+    }
+    return total;
+}
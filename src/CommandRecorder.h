@@ -0,0 +1,63 @@
+#ifndef OMEGA_COMMAND_RECORDER_H
+#define OMEGA_COMMAND_RECORDER_H
+
+#include "CommandList.h"
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class RenderQueue;
+class SpriteBatch;
+
+using RecordJob = std::function<void(CommandList&)>;
+
+// Runs command-list recording jobs on worker threads. Each worker records into
+// its own LinearAllocator; execute() on the GL thread waits for the frame's jobs,
+// merges their lists in submission order through the RenderQueue and draws them.
+class CommandRecorder {
+public:
+    CommandRecorder(int workerCount = 0); // 0 = pick from hardware concurrency
+    ~CommandRecorder();
+    
+    // Any thread except the workers themselves
+    void recordAsync(RecordJob job);
+    
+    // GL thread: recording directly, without a worker
+    CommandList& createCommandList();
+    
+    // GL thread: wait, merge, draw, then recycle all allocators
+    void execute(RenderQueue& queue, SpriteBatch& batch, int screenWidth, int screenHeight);
+    void waitIdle();
+    
+    int getWorkerCount() const { return static_cast<int>(m_workers.size()); }
+    size_t getRecordedBytes() const;
+
+private:
+    struct Slot {
+        std::unique_ptr<CommandList> list;  // Null until the job finishes
+    };
+    
+    struct PendingJob {
+        RecordJob job;
+        size_t slot;
+    };
+    
+    void workerLoop(int workerIndex);
+    
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<LinearAllocator>> m_allocators; // One per worker, last = GL thread
+    
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_jobDone;
+    std::deque<PendingJob> m_jobs;
+    std::deque<Slot> m_slots;   // Submission order; deque keeps references stable
+    size_t m_outstanding;
+    bool m_shutdown;
+};
+
+#endif // OMEGA_COMMAND_RECORDER_H
@@ -0,0 +1,177 @@
+#include "CookedTexture.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+namespace {
+
+const size_t LEVEL_ALIGNMENT = 16;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+CookedTexture::CookedTexture()
+    : m_data(nullptr) {
+    std::memset(&m_header, 0, sizeof(m_header));
+}
+
+bool CookedTexture::parse(const unsigned char* data, size_t size) {
+    m_data = nullptr;
+    m_levels.clear();
+
+    if (!data || size < sizeof(OTexHeader)) {
+        std::cerr << "CookedTexture: File too small for a header" << std::endl;
+        return false;
+    }
+
+    std::memcpy(&m_header, data, sizeof(OTexHeader));
+    if (m_header.magic != OTEX_MAGIC) {
+        std::cerr << "CookedTexture: Not an .otex file" << std::endl;
+        return false;
+    }
+    if (m_header.version != OTEX_VERSION) {
+        std::cerr << "CookedTexture: Unsupported version " << m_header.version << std::endl;
+        return false;
+    }
+    if (m_header.pixelFormat < static_cast<uint32_t>(OTexPixelFormat::R8) ||
+        m_header.pixelFormat > static_cast<uint32_t>(OTexPixelFormat::RGBA8)) {
+        std::cerr << "CookedTexture: Unknown pixel format " << m_header.pixelFormat << std::endl;
+        return false;
+    }
+    if (m_header.width == 0 || m_header.height == 0 || m_header.mipCount == 0 || m_header.mipCount > 32) {
+        std::cerr << "CookedTexture: Invalid dimensions or mip count" << std::endl;
+        return false;
+    }
+
+    size_t tableOffset = m_header.headerSize;
+    size_t tableSize = m_header.mipCount * sizeof(OTexLevel);
+    if (tableOffset < sizeof(OTexHeader) || tableOffset + tableSize > size) {
+        std::cerr << "CookedTexture: Truncated level table" << std::endl;
+        return false;
+    }
+
+    m_levels.resize(m_header.mipCount);
+    std::memcpy(m_levels.data(), data + tableOffset, tableSize);
+
+    size_t channels = m_header.pixelFormat;
+    for (const OTexLevel& level : m_levels) {
+        uint64_t expected = static_cast<uint64_t>(level.width) * level.height * channels;
+        if (level.width == 0 || level.height == 0 || level.size != expected ||
+            level.offset > size || level.size > size - level.offset) {
+            std::cerr << "CookedTexture: Corrupt mip level" << std::endl;
+            m_levels.clear();
+            return false;
+        }
+    }
+
+    m_data = data;
+    return true;
+}
+
+void CookedTexture::premultiplyAlpha(unsigned char* rgba, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; i++) {
+        unsigned char* p = rgba + i * 4;
+        unsigned int a = p[3];
+        // Rounded x * a / 255
+        for (int c = 0; c < 3; c++) {
+            unsigned int v = p[c] * a + 128;
+            p[c] = static_cast<unsigned char>((v + (v >> 8)) >> 8);
+        }
+    }
+}
+
+void CookedTexture::downsample(const unsigned char* src, int width, int height, int channels, unsigned char* dst) {
+    int dstWidth = width > 1 ? width / 2 : 1;
+    int dstHeight = height > 1 ? height / 2 : 1;
+
+    for (int y = 0; y < dstHeight; y++) {
+        int y0 = y * 2;
+        int y1 = (y0 + 1 < height) ? y0 + 1 : y0;
+        for (int x = 0; x < dstWidth; x++) {
+            int x0 = x * 2;
+            int x1 = (x0 + 1 < width) ? x0 + 1 : x0;
+            const unsigned char* p00 = src + (static_cast<size_t>(y0) * width + x0) * channels;
+            const unsigned char* p10 = src + (static_cast<size_t>(y0) * width + x1) * channels;
+            const unsigned char* p01 = src + (static_cast<size_t>(y1) * width + x0) * channels;
+            const unsigned char* p11 = src + (static_cast<size_t>(y1) * width + x1) * channels;
+            unsigned char* out = dst + (static_cast<size_t>(y) * dstWidth + x) * channels;
+            for (int c = 0; c < channels; c++) {
+                out[c] = static_cast<unsigned char>((p00[c] + p10[c] + p01[c] + p11[c] + 2) / 4);
+            }
+        }
+    }
+}
+
+bool CookedTexture::cook(const unsigned char* pixels, int width, int height, int channels,
+                         const CookedTextureOptions& options, std::vector<unsigned char>& out) {
+    if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+        std::cerr << "CookedTexture: Invalid source image" << std::endl;
+        return false;
+    }
+
+    bool premultiply = options.premultiplyAlpha && channels == 4;
+
+    // Level 0, premultiplied before filtering so mips don't bleed colour from transparent texels
+    std::vector<std::vector<unsigned char>> levels;
+    levels.emplace_back(pixels, pixels + static_cast<size_t>(width) * height * channels);
+    if (premultiply) {
+        premultiplyAlpha(levels[0].data(), static_cast<size_t>(width) * height);
+    }
+
+    std::vector<OTexLevel> table;
+    table.push_back({ static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0, levels[0].size() });
+
+    if (options.mipmaps) {
+        int w = width;
+        int h = height;
+        while (w > 1 || h > 1) {
+            int nextW = w > 1 ? w / 2 : 1;
+            int nextH = h > 1 ? h / 2 : 1;
+            std::vector<unsigned char> next(static_cast<size_t>(nextW) * nextH * channels);
+            downsample(levels.back().data(), w, h, channels, next.data());
+            table.push_back({ static_cast<uint32_t>(nextW), static_cast<uint32_t>(nextH), 0, next.size() });
+            levels.push_back(std::move(next));
+            w = nextW;
+            h = nextH;
+        }
+    }
+
+    OTexHeader header;
+    header.magic = OTEX_MAGIC;
+    header.version = OTEX_VERSION;
+    header.headerSize = sizeof(OTexHeader);
+    header.pixelFormat = static_cast<uint32_t>(channels);
+    header.flags = premultiply ? OTEX_FLAG_PREMULTIPLIED_ALPHA : 0;
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.mipCount = static_cast<uint32_t>(table.size());
+    header.reserved = 0;
+
+    size_t offset = alignUp(sizeof(OTexHeader) + table.size() * sizeof(OTexLevel), LEVEL_ALIGNMENT);
+    for (OTexLevel& level : table) {
+        level.offset = offset;
+        offset = alignUp(offset + level.size, LEVEL_ALIGNMENT);
+    }
+
+    out.assign(offset, 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), table.data(), table.size() * sizeof(OTexLevel));
+    for (size_t i = 0; i < table.size(); i++) {
+        std::memcpy(out.data() + table[i].offset, levels[i].data(), levels[i].size());
+    }
+    return true;
+}
+
+bool CookedTexture::writeFile(const std::string& filepath, const std::vector<unsigned char>& image) {
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "CookedTexture: Cannot write " << filepath << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return file.good();
+}
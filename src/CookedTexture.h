@@ -0,0 +1,89 @@
+#ifndef OMEGA_COOKED_TEXTURE_H
+#define OMEGA_COOKED_TEXTURE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// .otex: texture data in the exact layout the GPU wants, written by the asset
+// pipeline (TextureProcessor) and uploaded by Texture without decoding.
+//
+// Layout (little-endian):
+//   OTexHeader
+//   OTexLevel[mipCount]     largest level first
+//   level data              each level 16-byte aligned, rows tightly packed
+enum class OTexPixelFormat : uint32_t {
+    R8 = 1,
+    RG8 = 2,
+    RGB8 = 3,
+    RGBA8 = 4
+};
+
+const uint32_t OTEX_MAGIC = 0x5845544F;     // "OTEX"
+const uint16_t OTEX_VERSION = 1;
+const uint32_t OTEX_FLAG_PREMULTIPLIED_ALPHA = 1u << 0;
+
+struct OTexHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;        // sizeof(OTexHeader), for forward compatibility
+    uint32_t pixelFormat;       // OTexPixelFormat
+    uint32_t flags;
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+    uint32_t reserved;
+};
+
+struct OTexLevel {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;            // From the start of the file
+    uint64_t size;
+};
+
+static_assert(sizeof(OTexHeader) == 32, "OTexHeader layout changed");
+static_assert(sizeof(OTexLevel) == 24, "OTexLevel layout changed");
+
+struct CookedTextureOptions {
+    bool premultiplyAlpha = true;   // RGBA only
+    bool mipmaps = true;
+};
+
+// Read-only view of an .otex image held in memory (usually a MappedFile)
+class CookedTexture {
+public:
+    CookedTexture();
+
+    // Validates the header and level table against size; level data is not copied
+    bool parse(const unsigned char* data, size_t size);
+
+    int getWidth() const { return static_cast<int>(m_header.width); }
+    int getHeight() const { return static_cast<int>(m_header.height); }
+    int getChannels() const { return static_cast<int>(m_header.pixelFormat); }
+    OTexPixelFormat getFormat() const { return static_cast<OTexPixelFormat>(m_header.pixelFormat); }
+    bool isPremultiplied() const { return (m_header.flags & OTEX_FLAG_PREMULTIPLIED_ALPHA) != 0; }
+
+    int getLevelCount() const { return static_cast<int>(m_levels.size()); }
+    const OTexLevel& getLevel(int level) const { return m_levels[level]; }
+    const unsigned char* getLevelData(int level) const { return m_data + m_levels[level].offset; }
+
+    // Builds a complete .otex image from 8-bit pixels (1-4 channels)
+    static bool cook(const unsigned char* pixels, int width, int height, int channels,
+                     const CookedTextureOptions& options, std::vector<unsigned char>& out);
+    static bool writeFile(const std::string& filepath, const std::vector<unsigned char>& image);
+
+    // In-place straight -> premultiplied alpha
+    static void premultiplyAlpha(unsigned char* rgba, size_t pixelCount);
+
+    // 2x2 box filter; odd edges reuse the last row/column. dst is max(1, w/2) x max(1, h/2)
+    static void downsample(const unsigned char* src, int width, int height, int channels, unsigned char* dst);
+
+private:
+    const unsigned char* m_data;
+    OTexHeader m_header;
+    std::vector<OTexLevel> m_levels;
+};
+
+#endif // OMEGA_COOKED_TEXTURE_H
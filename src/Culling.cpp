@@ -0,0 +1,207 @@
+#include "Culling.h"
+#include <cmath>
+#include <algorithm>
+#include <typeinfo>
+
+// ============================================================================
+// SpatialGrid Implementation
+// ============================================================================
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 256.0f)
+    , m_inverseCellSize(1.0f / m_cellSize)
+    , m_queryStamp(0) {
+}
+
+uint64_t SpatialGrid::cellKey(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+SpatialGrid::CellRange SpatialGrid::computeRange(const Vector2& position, const Vector2& size) const {
+    CellRange range;
+    range.minX = static_cast<int>(std::floor(position.x * m_inverseCellSize));
+    range.minY = static_cast<int>(std::floor(position.y * m_inverseCellSize));
+    range.maxX = static_cast<int>(std::floor((position.x + size.x) * m_inverseCellSize));
+    range.maxY = static_cast<int>(std::floor((position.y + size.y) * m_inverseCellSize));
+    return range;
+}
+
+void SpatialGrid::insertCells(Entity entity, const CellRange& range) {
+    for (int y = range.minY; y <= range.maxY; y++) {
+        for (int x = range.minX; x <= range.maxX; x++) {
+            m_cells[cellKey(x, y)].push_back(entity);
+        }
+    }
+}
+
+void SpatialGrid::removeCells(Entity entity, const CellRange& range) {
+    for (int y = range.minY; y <= range.maxY; y++) {
+        for (int x = range.minX; x <= range.maxX; x++) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it == m_cells.end()) continue;
+            
+            std::vector<Entity>& cell = it->second;
+            auto pos = std::find(cell.begin(), cell.end(), entity);
+            if (pos != cell.end()) {
+                *pos = cell.back();
+                cell.pop_back();
+            }
+            if (cell.empty()) {
+                m_cells.erase(it);
+            }
+        }
+    }
+}
+
+void SpatialGrid::update(Entity entity, const Vector2& position, const Vector2& size) {
+    CellRange range = computeRange(position, size);
+    
+    auto it = m_entries.find(entity);
+    if (it == m_entries.end()) {
+        m_entries[entity] = { position, size, range, 0 };
+        insertCells(entity, range);
+        return;
+    }
+    
+    Entry& entry = it->second;
+    entry.position = position;
+    entry.size = size;
+    if (entry.cells == range) return;
+    
+    removeCells(entity, entry.cells);
+    insertCells(entity, range);
+    entry.cells = range;
+}
+
+void SpatialGrid::remove(Entity entity) {
+    auto it = m_entries.find(entity);
+    if (it == m_entries.end()) return;
+    
+    removeCells(entity, it->second.cells);
+    m_entries.erase(it);
+}
+
+void SpatialGrid::clear() {
+    m_cells.clear();
+    m_entries.clear();
+}
+
+void SpatialGrid::query(const ViewBounds& bounds, std::vector<Entity>& out) {
+    m_queryStamp++;
+    
+    CellRange range = computeRange(Vector2(bounds.left, bounds.top),
+                                   Vector2(bounds.right - bounds.left, bounds.bottom - bounds.top));
+    for (int y = range.minY; y <= range.maxY; y++) {
+        for (int x = range.minX; x <= range.maxX; x++) {
+            auto cellIt = m_cells.find(cellKey(x, y));
+            if (cellIt == m_cells.end()) continue;
+            
+            for (Entity entity : cellIt->second) {
+                Entry& entry = m_entries[entity];
+                if (entry.queryStamp == m_queryStamp) continue; // Already seen via another cell
+                entry.queryStamp = m_queryStamp;
+                
+                if (bounds.intersects(entry.position, entry.size)) {
+                    out.push_back(entity);
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// CullingSystem Implementation
+// ============================================================================
+
+CullingSystem::CullingSystem(ECS* ecs, float cellSize)
+    : m_ecs(ecs)
+    , m_grid(cellSize)
+    , m_componentCallbackId(0)
+    , m_lastVisibleCount(0) {
+    
+    if (m_ecs) {
+        m_componentCallbackId = m_ecs->addComponentCallback([this](Entity entity, std::type_index type) {
+            if (type == typeid(Transform) || type == typeid(RenderBounds) || type == typeid(SpriteComponent)) {
+                m_changed.push_back(entity);
+            }
+        });
+        
+        // Entities created before the system are picked up by the first update
+        m_changed = m_ecs->getEntities();
+    }
+}
+
+CullingSystem::~CullingSystem() {
+    if (m_ecs) {
+        m_ecs->removeComponentCallback(m_componentCallbackId);
+    }
+}
+
+void CullingSystem::update() {
+    if (!m_ecs) return;
+    
+    // Structural changes first: a removed component leaves a dangling pointer in m_tracked
+    for (Entity entity : m_changed) {
+        refresh(entity);
+    }
+    m_changed.clear();
+    
+    for (const Tracked& tracked : m_tracked) {
+        if (tracked.transform->dirty) {
+            updateGrid(tracked);
+        }
+    }
+}
+
+void CullingSystem::refresh(Entity entity) {
+    Tracked tracked = { entity, m_ecs->getComponent<Transform>(entity), nullptr, nullptr };
+    if (tracked.transform) {
+        tracked.bounds = m_ecs->getComponent<RenderBounds>(entity);
+        tracked.sprite = m_ecs->getComponent<SpriteComponent>(entity);
+    }
+    
+    auto it = m_trackedIndex.find(entity);
+    if (!tracked.transform || (!tracked.bounds && !tracked.sprite)) {
+        // Destroyed or no longer renderable
+        if (it == m_trackedIndex.end()) return;
+        
+        size_t index = it->second;
+        m_trackedIndex.erase(it);
+        if (index + 1 < m_tracked.size()) {
+            m_tracked[index] = m_tracked.back();
+            m_trackedIndex[m_tracked[index].entity] = index;
+        }
+        m_tracked.pop_back();
+        m_grid.remove(entity);
+        return;
+    }
+    
+    if (it == m_trackedIndex.end()) {
+        m_trackedIndex[entity] = m_tracked.size();
+        m_tracked.push_back(tracked);
+    } else {
+        m_tracked[it->second] = tracked;
+    }
+    updateGrid(tracked);
+}
+
+void CullingSystem::updateGrid(const Tracked& tracked) {
+    Vector2 position = tracked.transform->position;
+    Vector2 size;
+    if (tracked.bounds) {
+        position.x += tracked.bounds->offset.x;
+        position.y += tracked.bounds->offset.y;
+        size = tracked.bounds->size;
+    } else {
+        size = tracked.sprite->sprite.getSize();
+    }
+    
+    m_grid.update(tracked.entity, position, size);
+    tracked.transform->dirty = false;
+}
+
+void CullingSystem::cull(const Camera& camera, std::vector<Entity>& visible, float margin) {
+    size_t start = visible.size();
+    m_grid.query(camera.getVisibleBounds(margin), visible);
+    m_lastVisibleCount = visible.size() - start;
+}
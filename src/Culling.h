@@ -0,0 +1,96 @@
+#ifndef OMEGA_CULLING_H
+#define OMEGA_CULLING_H
+
+#include "ECS.h"
+#include "Camera.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Uniform grid over world space. Each entry is stored in every cell its rect
+// touches; queries dedupe with a per-query stamp.
+class SpatialGrid {
+public:
+    SpatialGrid(float cellSize = 256.0f);
+    
+    // Insert or move; cheap when the rect stays within the same cells
+    void update(Entity entity, const Vector2& position, const Vector2& size);
+    void remove(Entity entity);
+    void clear();
+    
+    // Entities whose rect intersects the bounds (exact test, not just cell overlap)
+    void query(const ViewBounds& bounds, std::vector<Entity>& out);
+    
+    size_t getEntryCount() const { return m_entries.size(); }
+    size_t getCellCount() const { return m_cells.size(); }
+
+private:
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+        bool operator==(const CellRange& o) const {
+            return minX == o.minX && minY == o.minY && maxX == o.maxX && maxY == o.maxY;
+        }
+    };
+    
+    struct Entry {
+        Vector2 position;
+        Vector2 size;
+        CellRange cells;
+        uint32_t queryStamp;
+    };
+    
+    CellRange computeRange(const Vector2& position, const Vector2& size) const;
+    static uint64_t cellKey(int x, int y);
+    void insertCells(Entity entity, const CellRange& range);
+    void removeCells(Entity entity, const CellRange& range);
+    
+    float m_cellSize;
+    float m_inverseCellSize;
+    std::unordered_map<uint64_t, std::vector<Entity>> m_cells;
+    std::unordered_map<Entity, Entry> m_entries;
+    uint32_t m_queryStamp;
+};
+
+// Keeps a SpatialGrid in sync with the ECS and returns the renderable entities
+// inside a camera's view. An entity is renderable when it has a Transform and
+// either RenderBounds or a SpriteComponent. The ECS must outlive the system.
+class CullingSystem {
+public:
+    CullingSystem(ECS* ecs, float cellSize = 256.0f);
+    ~CullingSystem();
+    
+    CullingSystem(const CullingSystem&) = delete;
+    CullingSystem& operator=(const CullingSystem&) = delete;
+    
+    // Apply component adds/removes since the last call and re-bucket entities whose
+    // Transform is dirty (call once per frame before cull); static entities are not touched
+    void update();
+    
+    // Visible renderables, in no particular order
+    void cull(const Camera& camera, std::vector<Entity>& visible, float margin = 0.0f);
+    
+    size_t getTrackedCount() const { return m_grid.getEntryCount(); }
+    size_t getLastVisibleCount() const { return m_lastVisibleCount; }
+
+private:
+    // Renderable with its components, re-fetched whenever one is added or removed
+    struct Tracked {
+        Entity entity;
+        Transform* transform;
+        RenderBounds* bounds;       // Wins over the sprite's size when present
+        SpriteComponent* sprite;
+    };
+    
+    void refresh(Entity entity);
+    void updateGrid(const Tracked& tracked);
+    
+    ECS* m_ecs;
+    SpatialGrid m_grid;
+    std::vector<Tracked> m_tracked;
+    std::unordered_map<Entity, size_t> m_trackedIndex;  // Into m_tracked
+    std::vector<Entity> m_changed;                      // Renderable components added/removed since update
+    int m_componentCallbackId;
+    size_t m_lastVisibleCount;
+};
+
+#endif // OMEGA_CULLING_H
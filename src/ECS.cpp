@@ -1,6 +1,7 @@
 #include "ECS.h"
+#include <algorithm>
 
-ECS::ECS() : m_nextEntityID(1) {
+ECS::ECS() : m_nextEntityID(1), m_nextComponentCallbackId(1) {
 }
 
 ECS::~ECS() {
@@ -22,5 +23,36 @@ void ECS::destroyEntity(Entity entity) {
     }
 
     // Remove all components
-    m_components.erase(entity);
+    auto componentsIt = m_components.find(entity);
+    if (componentsIt == m_components.end()) return;
+    
+    std::vector<std::type_index> removed;
+    if (!m_componentCallbacks.empty()) {
+        for (const auto& component : componentsIt->second) {
+            removed.push_back(component.first);
+        }
+    }
+    m_components.erase(componentsIt);
+    
+    for (std::type_index type : removed) {
+        notifyComponentChanged(entity, type);
+    }
+}
+
+int ECS::addComponentCallback(ComponentCallback callback) {
+    int id = m_nextComponentCallbackId++;
+    m_componentCallbacks.push_back({ id, std::move(callback) });
+    return id;
+}
+
+void ECS::removeComponentCallback(int id) {
+    m_componentCallbacks.erase(std::remove_if(m_componentCallbacks.begin(), m_componentCallbacks.end(),
+        [id](const std::pair<int, ComponentCallback>& entry) { return entry.first == id; }),
+        m_componentCallbacks.end());
+}
+
+void ECS::notifyComponentChanged(Entity entity, std::type_index type) {
+    for (const auto& entry : m_componentCallbacks) {
+        entry.second(entity, type);
+    }
 }
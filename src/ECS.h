@@ -5,6 +5,7 @@
 #include <memory>
 #include <unordered_map>
 #include <typeindex>
+#include <functional>
 #include "Sprite.h"
 
 // Entity is just an ID
@@ -15,13 +16,15 @@ struct Component {
     virtual ~Component() = default;
 };
 
-// Transform component
+// Transform component. Whoever moves or resizes an entity after adding it sets dirty;
+// CullingSystem::update re-buckets dirty transforms and clears the flag.
 struct Transform : public Component {
     Vector2 position;
     Vector2 scale;
     float rotation;
+    bool dirty;
     
-    Transform() : position(0, 0), scale(1, 1), rotation(0) {}
+    Transform() : position(0, 0), scale(1, 1), rotation(0), dirty(true) {}
 };
 
 // Sprite component
@@ -32,6 +35,15 @@ struct SpriteComponent : public Component {
     SpriteComponent() : visible(true) {}
 };
 
+// Render bounds component - local rect used for visibility culling.
+// Entities without one fall back to their SpriteComponent's size.
+struct RenderBounds : public Component {
+    Vector2 offset;     // From Transform position
+    Vector2 size;
+    
+    RenderBounds() : offset(0, 0), size(0, 0) {}
+};
+
 // Simple ECS Manager
 class ECS {
 public:
@@ -47,6 +59,10 @@ public:
     template<typename T>
     T* getComponent(Entity entity);
 
+    // Owning handle, for systems that keep a component beyond the current frame
+    template<typename T>
+    std::shared_ptr<T> getSharedComponent(Entity entity);
+
     template<typename T>
     bool hasComponent(Entity entity);
 
@@ -55,10 +71,20 @@ public:
 
     std::vector<Entity> getEntities() const { return m_entities; }
 
+    // Called with the entity and component type after a component is added or removed
+    // (destroyEntity removes them all); add returns an id for remove
+    using ComponentCallback = std::function<void(Entity, std::type_index)>;
+    int addComponentCallback(ComponentCallback callback);
+    void removeComponentCallback(int id);
+
 private:
+    void notifyComponentChanged(Entity entity, std::type_index type);
+
     unsigned int m_nextEntityID;
     std::vector<Entity> m_entities;
     std::unordered_map<Entity, std::unordered_map<std::type_index, std::shared_ptr<Component>>> m_components;
+    std::vector<std::pair<int, ComponentCallback>> m_componentCallbacks;
+    int m_nextComponentCallbackId;
 };
 
 // Template implementations
@@ -66,6 +92,7 @@ template<typename T>
 T* ECS::addComponent(Entity entity) {
     auto component = std::make_shared<T>();
     m_components[entity][std::type_index(typeid(T))] = component;
+    notifyComponentChanged(entity, std::type_index(typeid(T)));
     return component.get();
 }
 
@@ -80,6 +107,17 @@ T* ECS::getComponent(Entity entity) {
     return static_cast<T*>(compIt->second.get());
 }
 
+template<typename T>
+std::shared_ptr<T> ECS::getSharedComponent(Entity entity) {
+    auto entityIt = m_components.find(entity);
+    if (entityIt == m_components.end()) return nullptr;
+
+    auto compIt = entityIt->second.find(std::type_index(typeid(T)));
+    if (compIt == entityIt->second.end()) return nullptr;
+
+    return std::static_pointer_cast<T>(compIt->second);
+}
+
 template<typename T>
 bool ECS::hasComponent(Entity entity) {
     return getComponent<T>(entity) != nullptr;
@@ -88,8 +126,8 @@ bool ECS::hasComponent(Entity entity) {
 template<typename T>
 void ECS::removeComponent(Entity entity) {
     auto entityIt = m_components.find(entity);
-    if (entityIt != m_components.end()) {
-        entityIt->second.erase(std::type_index(typeid(T)));
+    if (entityIt != m_components.end() && entityIt->second.erase(std::type_index(typeid(T))) > 0) {
+        notifyComponentChanged(entity, std::type_index(typeid(T)));
     }
 }
 
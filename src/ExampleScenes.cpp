@@ -1,6 +1,7 @@
 #include "ExampleScenes.h"
 #include "SceneManager.h"
 #include "Audio.h"
+#include "CommandList.h"
 #include <iostream>
 #include <cmath>
 
@@ -113,6 +114,7 @@ void GameScene::onEnter() {
     
     // Initialize collision system
     m_collisionSystem = std::make_unique<CollisionSystem>(m_ecs.get());
+    m_cullingSystem = std::make_unique<CullingSystem>(m_ecs.get());
     
     // Get texture from asset manager
     AssetManager& assets = AssetManager::getInstance();
@@ -212,6 +214,9 @@ void GameScene::handleInput(Input& input) {
     // Keep in bounds
     playerTransform->position.x = std::max(0.0f, std::min(1600.0f - 64.0f, playerTransform->position.x));
     playerTransform->position.y = std::max(0.0f, std::min(1200.0f - 64.0f, playerTransform->position.y));
+    if (m_isMoving) {
+        playerTransform->dirty = true;
+    }
 }
 
 void GameScene::update(float deltaTime) {
@@ -235,24 +240,38 @@ void GameScene::update(float deltaTime) {
 void GameScene::render(Renderer& renderer) {
     renderer.clear(0.1f, 0.1f, 0.15f, 1.0f);
     
-    Shader* shader = AssetManager::getInstance().getShader("sprite_shader");
-    if (!shader) return;
+    // Recorded on worker threads, drawn by the SceneManager once this returns
+    Camera* camera = m_camera.get();
     
-    // Render player
-    m_playerAnimSprite.drawWithCamera(shader, m_camera.get(), 800, 600);
+    // Render player (layer 1, above obstacles)
+    renderer.recordAsync([this, camera](CommandList& list) {
+        list.setCamera(camera);
+        list.drawSprite(m_playerAnimSprite.getSprite(), 1);
+    });
+    
+    // Only obstacles inside the view are recorded
+    m_visibleEntities.clear();
+    if (m_cullingSystem) {
+        m_cullingSystem->update();
+        m_cullingSystem->cull(*camera, m_visibleEntities);
+    }
     
     // Render obstacles
-    for (Entity entity : m_ecs->getEntities()) {
-        if (entity == m_player) continue;
-        
-        auto* transform = m_ecs->getComponent<Transform>(entity);
-        auto* spriteComp = m_ecs->getComponent<SpriteComponent>(entity);
-        
-        if (transform && spriteComp && spriteComp->visible) {
-            spriteComp->sprite.setPosition(transform->position);
-            spriteComp->sprite.drawWithCamera(shader, m_camera.get(), 800, 600);
+    renderer.recordAsync([this, camera](CommandList& list) {
+        list.setCamera(camera);
+        for (Entity entity : m_visibleEntities) {
+            if (entity == m_player) continue;
+            
+            auto* transform = m_ecs->getComponent<Transform>(entity);
+            auto* spriteComp = m_ecs->getComponent<SpriteComponent>(entity);
+            
+            if (transform && spriteComp && spriteComp->visible) {
+                Sprite sprite = spriteComp->sprite;
+                sprite.setPosition(transform->position);
+                list.drawSprite(sprite);
+            }
         }
-    }
+    });
 }
 
 // ============================================================================
@@ -4,6 +4,7 @@
 #include "Scene.h"
 #include "AnimatedSprite.h"
 #include "UI.h"
+#include "Culling.h"
 #include <vector>
 
 // Main Menu Scene
@@ -46,6 +47,8 @@ private:
     Entity m_player;
     std::vector<Entity> m_obstacles;
     AnimatedSprite m_playerAnimSprite;
+    std::unique_ptr<CullingSystem> m_cullingSystem;
+    std::vector<Entity> m_visibleEntities;
     float m_time;
     bool m_isMoving;
 };
@@ -0,0 +1,429 @@
+#include "FieldOfView.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+enum Quadrant { QUADRANT_NORTH, QUADRANT_SOUTH, QUADRANT_EAST, QUADRANT_WEST };
+
+// Index of the lowest set bit; value must not be 0
+int countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+uint64_t lowMask(int count) {
+    return count >= 64 ? ~0ULL : (1ULL << count) - 1;
+}
+
+int floorDivide(int numerator, int denominator) {
+    int quotient = numerator / denominator;
+    return (numerator % denominator != 0 && (numerator < 0) != (denominator < 0)) ? quotient - 1 : quotient;
+}
+
+int ceilDivide(int numerator, int denominator) {
+    return -floorDivide(-numerator, denominator);
+}
+
+// Widest column offset still inside the disc at this depth
+int discHalfWidth(int radius, int depth) {
+    int limit = radius * (radius + 1) - depth * depth;
+    int width = static_cast<int>(std::sqrt(static_cast<double>(limit)));
+    while (width * width > limit) width--;
+    while ((width + 1) * (width + 1) <= limit) width++;
+    return width;
+}
+
+void setBitRange(uint64_t* words, int first, int last) {
+    for (int bit = first; bit <= last; ) {
+        int count = std::min(64 - bit % 64, last - bit + 1);
+        words[bit / 64] |= lowMask(count) << (bit % 64);
+        bit += count;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Viewshed
+// ============================================================================
+
+int Viewshed::countVisible() const {
+    int count = 0;
+    for (uint64_t word : m_bits) {
+        for (uint64_t bits = word; bits != 0; bits &= bits - 1) count++;
+    }
+    return count;
+}
+
+void Viewshed::clear() {
+    m_radius = -1;
+    m_size = 0;
+    m_bits.clear();
+    m_source = nullptr;
+}
+
+// ============================================================================
+// FieldOfView
+// ============================================================================
+
+FieldOfView::FieldOfView(Tilemap* tilemap)
+    : m_tilemap(tilemap)
+    , m_solidityCallbackId(0)
+    , m_width(0)
+    , m_height(0)
+    , m_resized(false)
+    , m_columnWords(0)
+    , m_regionsX(0)
+    , m_regionsY(0)
+    , m_changeCounter(0) {
+
+    if (m_tilemap) {
+        m_solidityCallbackId = m_tilemap->addSolidityCallback([this](int x, int y, int width, int height) {
+            markDirty(x, y, width, height);
+        });
+    }
+
+    refresh();
+}
+
+FieldOfView::~FieldOfView() {
+    if (m_tilemap) {
+        m_tilemap->removeSolidityCallback(m_solidityCallbackId);
+    }
+}
+
+void FieldOfView::refresh() {
+    m_width = m_tilemap ? m_tilemap->getWidth() : 0;
+    m_height = m_tilemap ? m_tilemap->getHeight() : 0;
+    m_resized = false;
+
+    // Column-major copy of the Tilemap's row bitset
+    m_columnWords = (m_height + 63) / 64;
+    m_columnBits.assign(static_cast<size_t>(m_width) * m_columnWords, 0);
+    for (int y = 0; y < m_height; y++) {
+        for (int x = 0; x < m_width; x += 64) {
+            for (uint64_t bits = m_tilemap->getSolidBits(x, y, 64); bits != 0; bits &= bits - 1) {
+                int column = x + countTrailingZeros(bits);
+                m_columnBits[static_cast<size_t>(column) * m_columnWords + y / 64] |= 1ULL << (y % 64);
+            }
+        }
+    }
+
+    // Every viewshed computed before is stale
+    m_changeCounter++;
+    m_regionsX = (m_width + REGION_SIZE - 1) / REGION_SIZE;
+    m_regionsY = (m_height + REGION_SIZE - 1) / REGION_SIZE;
+    m_regionChangedAt.assign(static_cast<size_t>(m_regionsX) * m_regionsY, m_changeCounter);
+}
+
+void FieldOfView::update() {
+    if (!m_tilemap) return;
+
+    // A resized map (e.g. loadFromFile) is copied again as a whole
+    if (m_resized || m_tilemap->getWidth() != m_width || m_tilemap->getHeight() != m_height) {
+        refresh();
+    }
+}
+
+void FieldOfView::markDirty(int x, int y, int width, int height) {
+    if (!m_tilemap) return;
+
+    if (m_tilemap->getWidth() != m_width || m_tilemap->getHeight() != m_height) {
+        m_resized = true;
+        return;
+    }
+
+    int startX = std::max(0, x);
+    int startY = std::max(0, y);
+    int endX = std::min(m_width, x + width);
+    int endY = std::min(m_height, y + height);
+    if (startX >= endX || startY >= endY) return;
+
+    for (int tx = startX; tx < endX; tx++) {
+        uint64_t* column = &m_columnBits[static_cast<size_t>(tx) * m_columnWords];
+        for (int ty = startY; ty < endY; ty++) {
+            uint64_t bit = 1ULL << (ty % 64);
+            if (m_tilemap->isTileSolid(tx, ty)) {
+                column[ty / 64] |= bit;
+            } else {
+                column[ty / 64] &= ~bit;
+            }
+        }
+    }
+
+    m_changeCounter++;
+    for (int ry = startY / REGION_SIZE; ry <= (endY - 1) / REGION_SIZE; ry++) {
+        for (int rx = startX / REGION_SIZE; rx <= (endX - 1) / REGION_SIZE; rx++) {
+            m_regionChangedAt[ry * m_regionsX + rx] = m_changeCounter;
+        }
+    }
+}
+
+uint64_t FieldOfView::opaqueBits(bool mapRow, int line, int start, int count) {
+    int lineLimit = mapRow ? m_height : m_width;
+    int limit = mapRow ? m_width : m_height;
+    uint64_t mask = lowMask(count);
+    if (line < 0 || line >= lineLimit || start >= limit || start + count <= 0) return mask;
+    m_stats.wordsTested++;
+
+    uint64_t bits;
+    if (mapRow) {
+        bits = m_tilemap->getSolidBits(start, line, count);
+    } else {
+        // Same extraction as Tilemap::getSolidBits, over this column's words
+        const uint64_t* column = &m_columnBits[static_cast<size_t>(line) * m_columnWords];
+        int first = std::max(0, start);
+        int word = first / 64;
+        int shift = first % 64;
+        bits = column[word] >> shift;
+        if (shift != 0 && word + 1 < m_columnWords) {
+            bits |= column[word + 1] << (64 - shift);
+        }
+        bits = start < 0 ? bits << -start : bits;
+    }
+
+    // Off-map tiles before and after the line
+    if (start < 0) bits |= lowMask(-start);
+    if (start + count > limit) bits |= ~lowMask(limit - start);
+    return bits & mask;
+}
+
+// ============================================================================
+// Field of View
+// ============================================================================
+
+bool FieldOfView::isCurrent(const Viewshed& viewshed, int viewerX, int viewerY, int radius) const {
+    if (viewshed.m_source != this || viewshed.m_radius != radius ||
+        viewshed.m_originX != viewerX || viewshed.m_originY != viewerY) {
+        return false;
+    }
+
+    int startX = std::max(0, viewerX - radius) / REGION_SIZE;
+    int startY = std::max(0, viewerY - radius) / REGION_SIZE;
+    int endX = std::min(m_width - 1, viewerX + radius) / REGION_SIZE;
+    int endY = std::min(m_height - 1, viewerY + radius) / REGION_SIZE;
+    for (int ry = startY; ry <= endY; ry++) {
+        for (int rx = startX; rx <= endX; rx++) {
+            if (m_regionChangedAt[ry * m_regionsX + rx] > viewshed.m_computedAt) return false;
+        }
+    }
+    return true;
+}
+
+bool FieldOfView::compute(Viewshed& viewshed, int viewerX, int viewerY, int radius) {
+    update();
+    radius = std::max(0, radius);
+
+    if (isCurrent(viewshed, viewerX, viewerY, radius)) {
+        m_stats.viewshedsReused++;
+        return false;
+    }
+
+    viewshed.m_originX = viewerX;
+    viewshed.m_originY = viewerY;
+    viewshed.m_radius = radius;
+    viewshed.m_size = 2 * radius + 1;
+    viewshed.m_wordsPerRow = (viewshed.m_size + 63) / 64;
+    viewshed.m_bits.assign(static_cast<size_t>(viewshed.m_size) * viewshed.m_wordsPerRow, 0);
+    viewshed.m_source = this;
+    viewshed.m_computedAt = m_changeCounter;
+    m_stats.viewshedsComputed++;
+
+    if (viewerX < 0 || viewerX >= m_width || viewerY < 0 || viewerY >= m_height) return true;
+
+    viewshed.m_bits[radius * viewshed.m_wordsPerRow + radius / 64] |= 1ULL << (radius % 64);
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        castQuadrant(viewshed, quadrant, radius);
+    }
+    return true;
+}
+
+// Rows at increasing depth from the viewer; a row spans the columns between
+// its start and end slopes. Each wall run inside a row narrows what lies
+// beyond it: the floor before it continues as its own row, and the floor
+// after it starts at a new slope.
+void FieldOfView::castQuadrant(Viewshed& viewshed, int quadrant, int radius) {
+    bool mapRow = quadrant == QUADRANT_NORTH || quadrant == QUADRANT_SOUTH;
+    int sign = (quadrant == QUADRANT_NORTH || quadrant == QUADRANT_WEST) ? -1 : 1;
+    int lineOrigin = mapRow ? viewshed.m_originY : viewshed.m_originX;
+    int columnOrigin = mapRow ? viewshed.m_originX : viewshed.m_originY;
+
+    m_rows.clear();
+    m_rows.push_back({ 1, -1, 1, 1, 1 });
+    while (!m_rows.empty()) {
+        Row row = m_rows.back();
+        m_rows.pop_back();
+        if (row.depth > radius) continue;
+
+        // Columns whose centre lies within the slopes, ties rounding inwards, clipped to the disc
+        int depth = row.depth;
+        int halfWidth = discHalfWidth(radius, depth);
+        int firstColumn = floorDivide(2 * depth * row.startNumerator + row.startDenominator, 2 * row.startDenominator);
+        int lastColumn = ceilDivide(2 * depth * row.endNumerator - row.endDenominator, 2 * row.endDenominator);
+        firstColumn = std::max(firstColumn, -halfWidth);
+        lastColumn = std::min(lastColumn, halfWidth);
+        if (firstColumn > lastColumn) continue;
+
+        int line = lineOrigin + sign * depth;
+        int startNumerator = row.startNumerator;
+        int startDenominator = row.startDenominator;
+        bool previousWall = false;
+        bool firstWall = false;
+        bool lastWall = false;
+
+        for (int column = firstColumn; column <= lastColumn; ) {
+            int remaining = lastColumn - column + 1;
+            uint64_t bits = opaqueBits(mapRow, line, columnOrigin + column, std::min(64, remaining));
+            bool wall = (bits & 1) != 0;
+            uint64_t runEnd = wall ? ~bits : bits;
+            int length = std::min(runEnd == 0 ? 64 : countTrailingZeros(runEnd), remaining);
+
+            if (column == firstColumn) firstWall = wall;
+            if (column + length > lastColumn) lastWall = wall;
+
+            if (wall && !previousWall && column > firstColumn) {
+                // Floor before this wall goes on as a narrower row
+                m_rows.push_back({ depth + 1, startNumerator, startDenominator, 2 * column - 1, 2 * depth });
+            } else if (!wall && previousWall) {
+                startNumerator = 2 * column - 1;
+                startDenominator = 2 * depth;
+            }
+            previousWall = wall;
+            column += length;
+        }
+
+        if (!previousWall) {
+            m_rows.push_back({ depth + 1, startNumerator, startDenominator, row.endNumerator, row.endDenominator });
+        }
+
+        // Walls always show; floor only when its centre is within the slopes, which can
+        // fail for the first and last column alone
+        int revealFirst = firstColumn;
+        int revealLast = lastColumn;
+        if (!firstWall && firstColumn * row.startDenominator < depth * row.startNumerator) revealFirst++;
+        if (!lastWall && lastColumn * row.endDenominator > depth * row.endNumerator) revealLast--;
+        if (revealFirst <= revealLast) {
+            reveal(viewshed, quadrant, depth, revealFirst, revealLast);
+        }
+    }
+}
+
+void FieldOfView::reveal(Viewshed& viewshed, int quadrant, int depth, int firstColumn, int lastColumn) {
+    bool mapRow = quadrant == QUADRANT_NORTH || quadrant == QUADRANT_SOUTH;
+    int sign = (quadrant == QUADRANT_NORTH || quadrant == QUADRANT_WEST) ? -1 : 1;
+    int radius = viewshed.m_radius;
+
+    // Clip to the map, then to viewshed-local coordinates
+    int line = (mapRow ? viewshed.m_originY : viewshed.m_originX) + sign * depth;
+    int columnOrigin = mapRow ? viewshed.m_originX : viewshed.m_originY;
+    if (line < 0 || line >= (mapRow ? m_height : m_width)) return;
+    firstColumn = std::max(firstColumn, -columnOrigin);
+    lastColumn = std::min(lastColumn, (mapRow ? m_width : m_height) - 1 - columnOrigin);
+    if (firstColumn > lastColumn) return;
+
+    int localLine = radius + sign * depth;
+    if (mapRow) {
+        uint64_t* words = &viewshed.m_bits[localLine * viewshed.m_wordsPerRow];
+        setBitRange(words, radius + firstColumn, radius + lastColumn);
+    } else {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            viewshed.m_bits[(radius + column) * viewshed.m_wordsPerRow + localLine / 64] |= 1ULL << (localLine % 64);
+        }
+    }
+}
+
+// ============================================================================
+// Line of Sight
+// ============================================================================
+
+bool FieldOfView::hasLineOfSight(int fromX, int fromY, int toX, int toY) {
+    update();
+    m_stats.lineQueries++;
+    return lineClear(fromX, fromY, toX, toY);
+}
+
+void FieldOfView::testLinesOfSight(const std::vector<LineOfSightQuery>& queries, std::vector<char>& results) {
+    update();
+    m_stats.lineQueries += queries.size();
+
+    results.resize(queries.size());
+    for (size_t i = 0; i < queries.size(); i++) {
+        const LineOfSightQuery& query = queries[i];
+        results[i] = lineClear(query.fromX, query.fromY, query.toX, query.toY) ? 1 : 0;
+    }
+}
+
+bool FieldOfView::lineClear(int fromX, int fromY, int toX, int toY) {
+    if (fromX < 0 || fromX >= m_width || fromY < 0 || fromY >= m_height ||
+        toX < 0 || toX >= m_width || toY < 0 || toY >= m_height) {
+        return false;
+    }
+
+    // Always walked from the same end, so both directions see the same tiles
+    if (toX < fromX || (toX == fromX && toY < fromY)) {
+        std::swap(fromX, toX);
+        std::swap(fromY, toY);
+    }
+
+    // Major axis along map rows (shallow lines) or map columns (steep ones)
+    bool mapRow = std::abs(toX - fromX) >= std::abs(toY - fromY);
+    int majorFrom = mapRow ? fromX : fromY;
+    int minorFrom = mapRow ? fromY : fromX;
+    int majorDelta = mapRow ? toX - fromX : toY - fromY;
+    int minorDelta = mapRow ? toY - fromY : toX - fromX;
+    int majorStep = majorDelta < 0 ? -1 : 1;
+    int minorStep = minorDelta < 0 ? -1 : 1;
+    int majorLength = std::abs(majorDelta);
+    int minorLength = std::abs(minorDelta);
+    if (majorLength <= 1) return true;
+
+    // Step t of the major axis sits at minor offset round(t * minorLength / majorLength), ties up;
+    // minor offset k covers steps [runStart(k), runStart(k + 1))
+    auto runStart = [&](int k) {
+        if (k == 0) return 0;
+        if (k > minorLength) return majorLength + 1;
+        return ceilDivide((2 * k - 1) * majorLength, 2 * minorLength);
+    };
+
+    auto opaqueAt = [&](int k, int t) {
+        return opaqueBits(mapRow, minorFrom + minorStep * k, majorFrom + majorStep * t, 1) != 0;
+    };
+
+    // A tie means the line passes exactly between offsets k - 1 and k. As with
+    // the shadowcast's tile edges, it may graze opaque tiles on one side, but
+    // not both tiles of a tie nor walls on both sides of the line
+    bool grazedNear = false;
+    bool grazedFar = false;
+
+    for (int k = 0; k <= minorLength; k++) {
+        // The two end tiles don't block
+        int first = std::max(runStart(k), 1);
+        int last = std::min(runStart(k + 1) - 1, majorLength - 1);
+        if (first > last) continue;
+
+        if (k > 0 && first == runStart(k) && (2 * k - 1) * majorLength % (2 * minorLength) == 0) {
+            grazedNear = grazedNear || opaqueAt(k - 1, first);
+            grazedFar = grazedFar || opaqueAt(k, first);
+            if (grazedNear && grazedFar) return false;
+            if (++first > last) continue;
+        }
+
+        int line = minorFrom + minorStep * k;
+        int low = majorStep > 0 ? majorFrom + first : majorFrom - last;
+        int high = majorStep > 0 ? majorFrom + last : majorFrom - first;
+        for (int start = low; start <= high; start += 64) {
+            if (opaqueBits(mapRow, line, start, std::min(64, high - start + 1)) != 0) return false;
+        }
+    }
+    return true;
+}
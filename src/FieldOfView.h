@@ -0,0 +1,136 @@
+#ifndef OMEGA_FIELD_OF_VIEW_H
+#define OMEGA_FIELD_OF_VIEW_H
+
+#include "Tilemap.h"
+#include <vector>
+#include <cstdint>
+
+class FieldOfView;
+
+// Tiles one viewer can see, filled in by FieldOfView::compute. Owned by the
+// viewer (player, enemy) so the result carries over between frames and is
+// only recomputed when something that affects it changed.
+class Viewshed {
+public:
+    Viewshed() = default;
+
+    int getOriginX() const { return m_originX; }
+    int getOriginY() const { return m_originY; }
+    int getRadius() const { return m_radius; }
+    bool isEmpty() const { return m_radius < 0; }
+
+    bool isVisible(int x, int y) const {
+        int localX = x - m_originX + m_radius;
+        int localY = y - m_originY + m_radius;
+        if (m_radius < 0 || localX < 0 || localX >= m_size || localY < 0 || localY >= m_size) return false;
+        return (m_bits[localY * m_wordsPerRow + localX / 64] >> (localX % 64)) & 1;
+    }
+    int countVisible() const;
+
+    void clear();
+
+private:
+    friend class FieldOfView;
+
+    int m_originX = 0;
+    int m_originY = 0;
+    int m_radius = -1;
+    int m_size = 0;                     // 2 * radius + 1 tiles square, centred on the origin
+    int m_wordsPerRow = 0;
+    std::vector<uint64_t> m_bits;
+    const FieldOfView* m_source = nullptr;
+    uint64_t m_computedAt = 0;          // FieldOfView change counter at compute time
+};
+
+struct LineOfSightQuery {
+    int fromX, fromY;
+    int toX, toY;
+};
+
+struct FieldOfViewStats {
+    uint64_t viewshedsComputed = 0;
+    uint64_t viewshedsReused = 0;
+    uint64_t lineQueries = 0;
+    uint64_t wordsTested = 0;       // Solidity words read by FOV and line-of-sight scans
+};
+
+// Field of view and line of sight over the solid tiles of a Tilemap.
+//
+// compute() is symmetric shadowcasting, four quadrants of rows: each row
+// reads the solidity of its tiles 64 at a time and walks wall and floor runs
+// with bit scans instead of tile by tile, so a row costs a few word reads.
+// Rows of the north and south quadrants are map rows, read straight from the
+// Tilemap's solidity bitset; east and west rows are map columns, read from a
+// column-major copy kept here. A tile the viewer sees also sees the viewer.
+//
+// Line of sight walks the tiles of a Bresenham line, which fall in one run
+// per row (or column, for steep lines), and tests each run as a masked word.
+// Where the line passes exactly between two tiles it may graze opaque ones,
+// as it may graze tile edges in compute(), so the two agree on every open
+// tile within the radius (compute() lights walls as soon as any part of them
+// shows). It is symmetric as well, and only the tiles between the two ends count.
+//
+// Solidity changes arrive through Tilemap's solidity callback; they keep the
+// column copy current and stamp the REGION_SIZE regions they touch, which is
+// how compute() tells a viewshed that still holds. Off-map tiles are opaque.
+class FieldOfView {
+public:
+    static const int REGION_SIZE = 16;
+
+    explicit FieldOfView(Tilemap* tilemap);
+    ~FieldOfView();
+    FieldOfView(const FieldOfView&) = delete;
+    FieldOfView& operator=(const FieldOfView&) = delete;
+
+    // Tiles within radius (a disc) of the viewer's tile that the viewer can see.
+    // Returns false, leaving viewshed as it was, when the viewer and radius are
+    // unchanged and no tile within radius changed solidity since it was computed
+    bool compute(Viewshed& viewshed, int viewerX, int viewerY, int radius);
+
+    // False when either end is off the map
+    bool hasLineOfSight(int fromX, int fromY, int toX, int toY);
+    // One result per query (1 = clear), e.g. every enemy against the player
+    void testLinesOfSight(const std::vector<LineOfSightQuery>& queries, std::vector<char>& results);
+
+    void markDirty(int x, int y, int width, int height);
+
+    const FieldOfViewStats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = FieldOfViewStats(); }
+
+private:
+    struct Row {
+        int depth;
+        int startNumerator, startDenominator;   // Slopes as column / depth fractions
+        int endNumerator, endDenominator;
+    };
+
+    void refresh();
+    void update();
+    bool isCurrent(const Viewshed& viewshed, int viewerX, int viewerY, int radius) const;
+
+    void castQuadrant(Viewshed& viewshed, int quadrant, int radius);
+    void reveal(Viewshed& viewshed, int quadrant, int depth, int firstColumn, int lastColumn);
+    // Opacity of count (<= 64) consecutive tiles of a map row or column, bit 0 first; off-map tiles are set
+    uint64_t opaqueBits(bool mapRow, int line, int start, int count);
+    bool lineClear(int fromX, int fromY, int toX, int toY);
+
+    Tilemap* m_tilemap;
+    int m_solidityCallbackId;
+
+    int m_width;
+    int m_height;
+    bool m_resized;
+    int m_columnWords;
+    std::vector<uint64_t> m_columnBits;     // Solidity, one run of words per map column
+
+    int m_regionsX;
+    int m_regionsY;
+    std::vector<uint64_t> m_regionChangedAt;
+    uint64_t m_changeCounter;
+
+    std::vector<Row> m_rows;                // Scratch stack for compute()
+
+    FieldOfViewStats m_stats;
+};
+
+#endif // OMEGA_FIELD_OF_VIEW_H
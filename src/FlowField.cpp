@@ -0,0 +1,384 @@
+#include "FlowField.h"
+#include <algorithm>
+
+namespace {
+
+const int BUCKET_COUNT = FlowField::DIAGONAL_COST + 1;
+
+// Same order as Pathfinder: straight moves first, so 4-way movement uses the first four
+const int NEIGHBOR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+const int NEIGHBOR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+const uint8_t OPPOSITE[8] = { 1, 0, 3, 2, 7, 6, 5, 4 };
+const uint32_t STEP_COST[8] = {
+    FlowField::STRAIGHT_COST, FlowField::STRAIGHT_COST, FlowField::STRAIGHT_COST, FlowField::STRAIGHT_COST,
+    FlowField::DIAGONAL_COST, FlowField::DIAGONAL_COST, FlowField::DIAGONAL_COST, FlowField::DIAGONAL_COST
+};
+
+const float DIAGONAL = 0.70710678f;
+
+enum TileMark : uint8_t { MARK_NONE, MARK_INVALIDATED, MARK_SEEDED };
+
+} // namespace
+
+const int FlowField::STRAIGHT_COST;
+const int FlowField::DIAGONAL_COST;
+const uint32_t FlowField::UNREACHABLE;
+const uint8_t FlowField::NO_DIRECTION;
+
+const Vector2 FlowField::s_directions[FlowField::NO_DIRECTION + 1] = {
+    Vector2(1, 0), Vector2(-1, 0), Vector2(0, 1), Vector2(0, -1),
+    Vector2(DIAGONAL, DIAGONAL), Vector2(DIAGONAL, -DIAGONAL),
+    Vector2(-DIAGONAL, DIAGONAL), Vector2(-DIAGONAL, -DIAGONAL),
+    Vector2(0, 0)
+};
+
+FlowFieldService::FlowFieldService(Tilemap* tilemap)
+    : m_tilemap(tilemap)
+    , m_solidityCallbackId(0)
+    , m_diagonal(true)
+    , m_width(0)
+    , m_height(0)
+    , m_resized(false)
+    , m_cacheCapacity(DEFAULT_CACHE_CAPACITY) {
+
+    if (m_tilemap) {
+        m_solidityCallbackId = m_tilemap->addSolidityCallback([this](int x, int y, int width, int height) {
+            markDirty(x, y, width, height);
+        });
+    }
+
+    refreshWalkable();
+}
+
+FlowFieldService::~FlowFieldService() {
+    if (m_tilemap) {
+        m_tilemap->removeSolidityCallback(m_solidityCallbackId);
+    }
+}
+
+// ============================================================================
+// Fields
+// ============================================================================
+
+std::shared_ptr<const FlowField> FlowFieldService::getField(int goalX, int goalY) {
+    update();
+    if (goalX < 0 || goalX >= m_width || goalY < 0 || goalY >= m_height) return nullptr;
+
+    int key = goalY * m_width + goalX;
+    auto it = m_cache.find(key);
+    if (it != m_cache.end()) {
+        m_cacheLru.splice(m_cacheLru.begin(), m_cacheLru, it->second.lruPosition);
+        m_stats.cacheHits++;
+        return it->second.field;
+    }
+
+    std::shared_ptr<FlowField> field(new FlowField());
+    field->m_goalX = goalX;
+    field->m_goalY = goalY;
+    buildField(*field);
+
+    CacheEntry& entry = m_cache[key];
+    entry.field = field;
+    m_cacheLru.push_front(key);
+    entry.lruPosition = m_cacheLru.begin();
+    evictUnused();
+    return field;
+}
+
+std::shared_ptr<const FlowField> FlowFieldService::getField(const Vector2& goal) {
+    if (!m_tilemap) return nullptr;
+
+    int goalX, goalY;
+    if (!m_tilemap->worldToTile(goal.x, goal.y, goalX, goalY)) return nullptr;
+    return getField(goalX, goalY);
+}
+
+void FlowFieldService::buildField(FlowField& field) {
+    size_t tileCount = static_cast<size_t>(m_width) * m_height;
+    field.m_width = m_width;
+    field.m_height = m_height;
+    field.m_inverseTileWidth = m_tilemap ? 1.0f / m_tilemap->getTileWidth() : 1.0f;
+    field.m_inverseTileHeight = m_tilemap ? 1.0f / m_tilemap->getTileHeight() : 1.0f;
+    field.m_costs.assign(tileCount, FlowField::UNREACHABLE);
+    field.m_directions.assign(tileCount, FlowField::NO_DIRECTION);
+    m_stats.fieldsBuilt++;
+
+    int goal = field.m_goalY * m_width + field.m_goalX;
+    if (!m_walkable[goal]) return;
+
+    field.m_costs[goal] = 0;
+    m_seeds.clear();
+    m_seeds.push_back(std::make_pair(0u, goal));
+    propagate(field, m_seeds);
+}
+
+// Costs only rise where a tile's route to the goal breaks, and every such tile
+// hangs below a broken move in the direction tree. Resetting those subtrees
+// and expanding them again from their intact neighbours gives the same field
+// as a fresh build; the neighbours of each change are seeded as well, so moves
+// that just opened up lower costs through the same expansion.
+void FlowFieldService::repairField(FlowField& field, const std::vector<int>& changed) {
+    std::vector<uint32_t>& costs = field.m_costs;
+    std::vector<uint8_t>& directions = field.m_directions;
+    int directionCount = m_diagonal ? 8 : 4;
+
+    m_invalidated.clear();
+    auto invalidate = [&](int index) {
+        if (m_marks[index] == MARK_NONE) {
+            m_marks[index] = MARK_INVALIDATED;
+            m_invalidated.push_back(index);
+        }
+    };
+
+    for (int index : changed) {
+        invalidate(index);
+
+        // Neighbours whose own step now runs into a wall or around a solid corner
+        int x = index % m_width;
+        int y = index / m_width;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = x + dx;
+                int ny = y + dy;
+                if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height) continue;
+                int neighbor = ny * m_width + nx;
+                uint8_t direction = directions[neighbor];
+                if (direction != FlowField::NO_DIRECTION && !isMoveOpen(nx, ny, direction)) {
+                    invalidate(neighbor);
+                }
+            }
+        }
+    }
+
+    // Everything downstream of an invalidated tile
+    for (size_t i = 0; i < m_invalidated.size(); i++) {
+        int index = m_invalidated[i];
+        int x = index % m_width;
+        int y = index / m_width;
+        for (int k = 0; k < directionCount; k++) {
+            int nx = x + NEIGHBOR_X[k];
+            int ny = y + NEIGHBOR_Y[k];
+            if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height) continue;
+            int neighbor = ny * m_width + nx;
+            if (directions[neighbor] == OPPOSITE[k]) {
+                invalidate(neighbor);
+            }
+        }
+    }
+
+    for (int index : m_invalidated) {
+        costs[index] = FlowField::UNREACHABLE;
+        directions[index] = FlowField::NO_DIRECTION;
+    }
+
+    // Intact, reachable tiles bordering the reset area expand into it again
+    m_seeds.clear();
+    int goal = field.m_goalY * m_width + field.m_goalX;
+    if (m_walkable[goal] && costs[goal] == FlowField::UNREACHABLE) {
+        costs[goal] = 0;
+        m_seeds.push_back(std::make_pair(0u, goal));
+    }
+    for (int index : m_invalidated) {
+        int x = index % m_width;
+        int y = index / m_width;
+        for (int k = 0; k < directionCount; k++) {
+            int nx = x + NEIGHBOR_X[k];
+            int ny = y + NEIGHBOR_Y[k];
+            if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height) continue;
+            int neighbor = ny * m_width + nx;
+            if (m_marks[neighbor] == MARK_NONE && costs[neighbor] != FlowField::UNREACHABLE) {
+                m_marks[neighbor] = MARK_SEEDED;
+                m_seeds.push_back(std::make_pair(costs[neighbor], neighbor));
+            }
+        }
+    }
+
+    m_stats.tilesInvalidated += m_invalidated.size();
+    m_stats.fieldsRepaired++;
+
+    for (int index : m_invalidated) {
+        m_marks[index] = MARK_NONE;
+    }
+    for (const std::pair<uint32_t, int>& seed : m_seeds) {
+        m_marks[seed.second] = MARK_NONE;
+    }
+
+    if (m_seeds.empty()) return;
+    std::sort(m_seeds.begin(), m_seeds.end());
+    propagate(field, m_seeds);
+}
+
+void FlowFieldService::propagate(FlowField& field, std::vector<std::pair<uint32_t, int>>& seeds) {
+    std::vector<uint32_t>& costs = field.m_costs;
+    std::vector<uint8_t>& directions = field.m_directions;
+    int directionCount = m_diagonal ? 8 : 4;
+
+    // Steps cost at most DIAGONAL_COST, so BUCKET_COUNT buckets hold every tile still queued
+    size_t nextSeed = 0;
+    size_t queued = 0;
+    uint32_t current = seeds.front().first;
+    while (true) {
+        while (nextSeed < seeds.size() && seeds[nextSeed].first == current) {
+            m_buckets[current % BUCKET_COUNT].push_back(seeds[nextSeed].second);
+            queued++;
+            nextSeed++;
+        }
+        if (queued == 0) {
+            if (nextSeed == seeds.size()) break;
+            current = seeds[nextSeed].first;
+            continue;
+        }
+
+        std::vector<int>& bucket = m_buckets[current % BUCKET_COUNT];
+        for (size_t i = 0; i < bucket.size(); i++) {
+            int index = bucket[i];
+            queued--;
+            if (costs[index] != current) continue; // Lowered again after being queued
+
+            m_stats.tilesExpanded++;
+            int x = index % m_width;
+            int y = index / m_width;
+            for (int k = 0; k < directionCount; k++) {
+                int nx = x + NEIGHBOR_X[k];
+                int ny = y + NEIGHBOR_Y[k];
+                if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height) continue;
+                int neighbor = ny * m_width + nx;
+                if (!m_walkable[neighbor]) continue;
+                if (k >= 4 && (!m_walkable[y * m_width + nx] || !m_walkable[ny * m_width + x])) continue;
+
+                uint32_t cost = current + STEP_COST[k];
+                if (cost < costs[neighbor]) {
+                    costs[neighbor] = cost;
+                    directions[neighbor] = OPPOSITE[k];
+                    m_buckets[cost % BUCKET_COUNT].push_back(neighbor);
+                    queued++;
+                } else if (cost == costs[neighbor] && OPPOSITE[k] < directions[neighbor]) {
+                    // Ties go to the lowest direction, whatever the expansion order,
+                    // so a repaired field points the same way as a fresh build
+                    directions[neighbor] = OPPOSITE[k];
+                }
+            }
+        }
+        bucket.clear();
+        current++;
+    }
+}
+
+bool FlowFieldService::isMoveOpen(int fromX, int fromY, int direction) const {
+    int toX = fromX + NEIGHBOR_X[direction];
+    int toY = fromY + NEIGHBOR_Y[direction];
+    if (!m_walkable[fromY * m_width + fromX] || !m_walkable[toY * m_width + toX]) return false;
+    if (direction < 4) return true;
+    return m_walkable[fromY * m_width + toX] && m_walkable[toY * m_width + fromX];
+}
+
+// ============================================================================
+// Map Changes
+// ============================================================================
+
+void FlowFieldService::markDirty(int x, int y, int width, int height) {
+    if (!m_tilemap) return;
+
+    if (m_tilemap->getWidth() != m_width || m_tilemap->getHeight() != m_height) {
+        m_resized = true;
+        return;
+    }
+    m_pendingRects.push_back({ x, y, width, height });
+}
+
+void FlowFieldService::refreshWalkable() {
+    m_width = m_tilemap ? m_tilemap->getWidth() : 0;
+    m_height = m_tilemap ? m_tilemap->getHeight() : 0;
+
+    size_t tileCount = static_cast<size_t>(m_width) * m_height;
+    m_walkable.resize(tileCount);
+    for (int y = 0; y < m_height; y++) {
+        for (int x = 0; x < m_width; x++) {
+            m_walkable[y * m_width + x] = !m_tilemap->isTileSolid(x, y);
+        }
+    }
+    m_marks.assign(tileCount, MARK_NONE);
+}
+
+void FlowFieldService::update() {
+    if (!m_tilemap) return;
+
+    // A resized map (e.g. loadFromFile) invalidates every goal index; start over
+    if (m_resized || m_tilemap->getWidth() != m_width || m_tilemap->getHeight() != m_height) {
+        m_resized = false;
+        m_pendingRects.clear();
+        clearCache();
+        refreshWalkable();
+        return;
+    }
+    if (m_pendingRects.empty()) return;
+
+    // Overlapping or repeated rects are harmless: a tile counts as changed only once
+    std::vector<int> changed;
+    for (const Rect& rect : m_pendingRects) {
+        int startX = std::max(0, rect.x);
+        int startY = std::max(0, rect.y);
+        int endX = std::min(m_width, rect.x + rect.width);
+        int endY = std::min(m_height, rect.y + rect.height);
+        for (int y = startY; y < endY; y++) {
+            for (int x = startX; x < endX; x++) {
+                int index = y * m_width + x;
+                uint8_t walkable = !m_tilemap->isTileSolid(x, y);
+                if (walkable != m_walkable[index]) {
+                    m_walkable[index] = walkable;
+                    changed.push_back(index);
+                }
+            }
+        }
+    }
+    m_pendingRects.clear();
+    if (changed.empty()) return;
+
+    for (auto& entry : m_cache) {
+        repairField(*entry.second.field, changed);
+    }
+}
+
+void FlowFieldService::setDiagonalMovement(bool enabled) {
+    if (enabled == m_diagonal) return;
+    m_diagonal = enabled;
+
+    update();
+    for (auto& entry : m_cache) {
+        buildField(*entry.second.field);
+    }
+}
+
+void FlowFieldService::resetStats() {
+    m_stats = FlowFieldStats();
+    m_stats.cachedFields = static_cast<int>(m_cache.size());
+}
+
+// ============================================================================
+// Field Cache
+// ============================================================================
+
+void FlowFieldService::setCacheCapacity(size_t fields) {
+    m_cacheCapacity = fields;
+    evictUnused();
+}
+
+void FlowFieldService::clearCache() {
+    m_cache.clear();
+    m_cacheLru.clear();
+    m_stats.cachedFields = 0;
+}
+
+void FlowFieldService::evictUnused() {
+    // Least recently used first, skipping fields an agent still holds
+    auto it = m_cacheLru.end();
+    while (m_cache.size() > m_cacheCapacity && it != m_cacheLru.begin()) {
+        --it;
+        auto entry = m_cache.find(*it);
+        if (entry->second.field.use_count() > 1) continue;
+
+        m_cache.erase(entry);
+        it = m_cacheLru.erase(it);
+    }
+    m_stats.cachedFields = static_cast<int>(m_cache.size());
+}
@@ -0,0 +1,154 @@
+#ifndef OMEGA_FLOW_FIELD_H
+#define OMEGA_FLOW_FIELD_H
+
+#include "Tilemap.h"
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+
+// Steering towards one goal tile, shared by every agent heading there.
+// The integration field holds each tile's walking cost to the goal
+// (STRAIGHT_COST per step, DIAGONAL_COST per diagonal); the direction field
+// points every reachable tile at its next tile on a shortest path. Both are
+// owned and kept current by FlowFieldService.
+class FlowField {
+public:
+    static const int STRAIGHT_COST = 10;
+    static const int DIAGONAL_COST = 14;
+    static const uint32_t UNREACHABLE = 0xFFFFFFFF;
+    static const uint8_t NO_DIRECTION = 8;  // Goal tile, solid or unreachable
+
+    int getGoalX() const { return m_goalX; }
+    int getGoalY() const { return m_goalY; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+    uint32_t getCost(int x, int y) const {
+        if (!isValidCoord(x, y)) return UNREACHABLE;
+        return m_costs[y * m_width + x];
+    }
+    bool isReachable(int x, int y) const { return getCost(x, y) != UNREACHABLE; }
+    uint8_t getDirectionIndex(int x, int y) const {
+        if (!isValidCoord(x, y)) return NO_DIRECTION;
+        return m_directions[y * m_width + x];
+    }
+    // Unit vector towards the next tile; zero at the goal and where the goal can't be reached
+    const Vector2& getDirection(int x, int y) const { return s_directions[getDirectionIndex(x, y)]; }
+
+    // Steering for an agent at a world position; one table lookup per call
+    const Vector2& sample(const Vector2& position) const {
+        return getDirection(static_cast<int>(std::floor(position.x * m_inverseTileWidth)),
+                            static_cast<int>(std::floor(position.y * m_inverseTileHeight)));
+    }
+
+private:
+    friend class FlowFieldService;
+
+    FlowField() = default;
+    bool isValidCoord(int x, int y) const { return x >= 0 && x < m_width && y >= 0 && y < m_height; }
+
+    static const Vector2 s_directions[NO_DIRECTION + 1];
+
+    int m_goalX = 0;
+    int m_goalY = 0;
+    int m_width = 0;
+    int m_height = 0;
+    float m_inverseTileWidth = 1.0f;
+    float m_inverseTileHeight = 1.0f;
+    std::vector<uint32_t> m_costs;
+    std::vector<uint8_t> m_directions;  // Index into the neighbour table, towards the goal
+};
+
+struct FlowFieldStats {
+    uint64_t fieldsBuilt = 0;
+    uint64_t fieldsRepaired = 0;
+    uint64_t cacheHits = 0;
+    uint64_t tilesExpanded = 0;     // Over every build and repair
+    uint64_t tilesInvalidated = 0;  // Reset by repairs before being expanded again
+    int cachedFields = 0;
+};
+
+// Flow fields over the solid tiles of a Tilemap, one per goal tile, cached so
+// every group of agents chasing the same goal shares a single field. Fields
+// are built with a bucketed Dijkstra and, when tiles change, repaired in
+// place: only tiles whose shortest path ran through a change are reset and
+// expanded again, from the intact tiles around them.
+//
+// Movement is 8-way without cutting solid corners, or 4-way. Each field costs
+// five bytes per tile. Fields still referenced by an agent are never evicted,
+// so the capacity can be exceeded while every cached goal is in use.
+// Main thread only; agents may sample fields freely between update() calls.
+class FlowFieldService {
+public:
+    static const size_t DEFAULT_CACHE_CAPACITY = 8;
+
+    explicit FlowFieldService(Tilemap* tilemap);
+    ~FlowFieldService();
+    FlowFieldService(const FlowFieldService&) = delete;
+    FlowFieldService& operator=(const FlowFieldService&) = delete;
+
+    // Null when the goal is outside the map. A solid goal gives a field with
+    // every tile unreachable, which fills in once the goal opens up. Fields
+    // held across a map resize are dropped from the cache and must be fetched again
+    std::shared_ptr<const FlowField> getField(int goalX, int goalY);
+    std::shared_ptr<const FlowField> getField(const Vector2& goal);
+
+    // Repairs cached fields after Tilemap changes; getField calls it as well
+    void update();
+    void markDirty(int x, int y, int width, int height);
+
+    // Rebuilds every cached field
+    void setDiagonalMovement(bool enabled);
+    bool hasDiagonalMovement() const { return m_diagonal; }
+
+    void setCacheCapacity(size_t fields);
+    void clearCache();
+
+    const FlowFieldStats& getStats() const { return m_stats; }
+    void resetStats();
+
+private:
+    struct Rect {
+        int x, y, width, height;
+    };
+
+    struct CacheEntry {
+        std::shared_ptr<FlowField> field;
+        std::list<int>::iterator lruPosition;
+    };
+
+    void refreshWalkable();
+    void buildField(FlowField& field);
+    void repairField(FlowField& field, const std::vector<int>& changed);
+    // Bucketed Dijkstra from seeds sorted by cost; only ever lowers costs
+    void propagate(FlowField& field, std::vector<std::pair<uint32_t, int>>& seeds);
+    bool isMoveOpen(int fromX, int fromY, int direction) const;
+    void evictUnused();
+
+    Tilemap* m_tilemap;
+    int m_solidityCallbackId;
+    bool m_diagonal;
+
+    int m_width;
+    int m_height;
+    std::vector<uint8_t> m_walkable;    // As of the last update(); diffed against the map to find changes
+    std::vector<Rect> m_pendingRects;
+    bool m_resized;
+
+    // Scratch, reused between fields
+    std::vector<uint8_t> m_marks;
+    std::vector<int> m_invalidated;
+    std::vector<std::pair<uint32_t, int>> m_seeds;
+    std::vector<int> m_buckets[FlowField::DIAGONAL_COST + 1];
+
+    std::unordered_map<int, CacheEntry> m_cache;
+    std::list<int> m_cacheLru;          // Most recently used first
+    size_t m_cacheCapacity;
+
+    FlowFieldStats m_stats;
+};
+
+#endif // OMEGA_FLOW_FIELD_H
@@ -0,0 +1,188 @@
+#include "FramePacer.h"
+#include <thread>
+#include <algorithm>
+
+namespace {
+
+double toMilliseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::chrono::steady_clock::duration fromMilliseconds(double milliseconds) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(milliseconds));
+}
+
+// Keyboard, mouse, joystick, controller and touch events; window and system events don't count
+bool isInputEvent(const SDL_Event& event) {
+    return event.type >= SDL_KEYDOWN && event.type < SDL_CLIPBOARDUPDATE;
+}
+
+} // namespace
+
+const char* presentModeName(PresentMode mode) {
+    switch (mode) {
+        case PresentMode::VSync: return "vsync";
+        case PresentMode::AdaptiveVSync: return "adaptive-vsync";
+        case PresentMode::Immediate: return "immediate";
+    }
+    return "unknown";
+}
+
+FramePacer::FramePacer()
+    : m_targetFrameRate(0.0)
+    , m_refreshRate(0.0)
+    , m_displaySynced(false)
+    , m_lateInputSampling(false)
+    , m_lateMarginMs(1.0)
+    , m_spinThresholdMs(2.0)
+    , m_oversleepMs(0.0)
+    , m_hasDeadline(false)
+    , m_hasLastPresent(false)
+    , m_frameStarted(false)
+    , m_inputSampledThisFrame(false)
+    , m_oldestEventTicks(0)
+    , m_hasInputEvent(false)
+    , m_workIndex(0) {
+    std::fill(m_workHistory, m_workHistory + WORK_HISTORY, 0.0);
+}
+
+void FramePacer::setTargetFrameRate(double framesPerSecond) {
+    m_targetFrameRate = framesPerSecond > 0.0 ? framesPerSecond : 0.0;
+    m_hasDeadline = false; // Restart the cadence
+}
+
+void FramePacer::setDisplaySync(bool synced, double refreshRate) {
+    m_displaySynced = synced;
+    m_refreshRate = refreshRate > 0.0 ? refreshRate : 0.0;
+}
+
+double FramePacer::getFramePeriodMs() const {
+    if (m_targetFrameRate > 0.0) return 1000.0 / m_targetFrameRate;
+    if (m_displaySynced && m_refreshRate > 0.0) return 1000.0 / m_refreshRate;
+    return 0.0;
+}
+
+double FramePacer::predictWorkMs() const {
+    // Slowest of the recent frames: one late frame costs a whole refresh, an early one only a little latency
+    return *std::max_element(m_workHistory, m_workHistory + WORK_HISTORY);
+}
+
+void FramePacer::waitUntil(Clock::time_point target) {
+    // Let the overshoot estimate recover after a single bad sleep
+    m_oversleepMs *= 0.98;
+
+    Clock::time_point now = Clock::now();
+    double spinMs = std::max(m_spinThresholdMs, m_oversleepMs);
+
+    if (toMilliseconds(target - now) > spinMs) {
+        Clock::duration request = (target - now) - fromMilliseconds(spinMs);
+        std::this_thread::sleep_for(request);
+
+        Clock::time_point woke = Clock::now();
+        m_oversleepMs = std::max(m_oversleepMs, toMilliseconds((woke - now) - request));
+    }
+
+    while (Clock::now() < target) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::beginFrame() {
+    Clock::time_point now = Clock::now();
+    Clock::time_point start = now;
+    double periodMs = getFramePeriodMs();
+    Clock::duration period = fromMilliseconds(periodMs);
+
+    if (m_targetFrameRate > 0.0) {
+        // Fixed cadence; after a hitch of more than a frame, restart from now instead of rushing to catch up
+        if (!m_hasDeadline || now > m_deadline + period) {
+            m_deadline = now + period;
+        } else {
+            start = m_deadline;
+            m_deadline += period;
+        }
+        m_hasDeadline = true;
+    } else if (periodMs > 0.0 && m_hasLastPresent) {
+        // Synced swap returned at (about) the last vblank; the next one is a period later
+        m_deadline = m_lastPresent + period;
+        m_hasDeadline = true;
+    } else {
+        m_hasDeadline = false;
+    }
+
+    if (m_lateInputSampling && m_hasDeadline) {
+        Clock::time_point late = m_deadline - fromMilliseconds(predictWorkMs() + m_lateMarginMs);
+        start = std::max(start, late);
+    }
+
+    if (start > now) {
+        waitUntil(start);
+    }
+
+    m_frameStart = Clock::now();
+    m_frameStarted = true;
+    m_stats.waitTimeMs = toMilliseconds(m_frameStart - now);
+}
+
+void FramePacer::pollEvents(const std::function<void(const SDL_Event&)>& handler) {
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        if (isInputEvent(event)) {
+            // Ticks wrap after ~49 days; compare by difference
+            if (!m_hasInputEvent || static_cast<Sint32>(event.common.timestamp - m_oldestEventTicks) < 0) {
+                m_oldestEventTicks = event.common.timestamp;
+                m_hasInputEvent = true;
+            }
+        }
+        handler(event);
+    }
+
+    m_inputSampled = Clock::now();
+    m_inputSampledThisFrame = true;
+}
+
+void FramePacer::beforePresent() {
+    m_presentBegin = Clock::now();
+
+    if (m_inputSampledThisFrame || m_frameStarted) {
+        Clock::time_point workStart = m_inputSampledThisFrame ? m_inputSampled : m_frameStart;
+        m_stats.workTimeMs = toMilliseconds(m_presentBegin - workStart);
+        m_workHistory[m_workIndex] = m_stats.workTimeMs;
+        m_workIndex = (m_workIndex + 1) % WORK_HISTORY;
+    }
+}
+
+void FramePacer::afterPresent() {
+    Clock::time_point now = Clock::now();
+
+    if (m_hasLastPresent) {
+        m_stats.frameTimeMs = toMilliseconds(now - m_lastPresent);
+    }
+
+    if (m_inputSampledThisFrame) {
+        m_stats.inputLatencyMs = toMilliseconds(now - m_inputSampled);
+        m_stats.inputLatencySumMs += m_stats.inputLatencyMs;
+        m_stats.maxInputLatencyMs = std::max(m_stats.maxInputLatencyMs, m_stats.inputLatencyMs);
+        m_stats.inputFrames++;
+    }
+
+    if (m_hasInputEvent) {
+        double eventLatencyMs = static_cast<double>(static_cast<Uint32>(SDL_GetTicks() - m_oldestEventTicks));
+        m_stats.eventLatencySumMs += eventLatencyMs;
+        m_stats.maxEventLatencyMs = std::max(m_stats.maxEventLatencyMs, eventLatencyMs);
+        m_stats.inputEventFrames++;
+    }
+
+    // Half a period of slack: a synced swap returns a little after the vblank it was aimed at
+    if (m_hasDeadline && now > m_deadline + fromMilliseconds(getFramePeriodMs() * 0.5)) {
+        m_stats.missedDeadlines++;
+    }
+
+    m_stats.frames++;
+    m_lastPresent = now;
+    m_hasLastPresent = true;
+    m_frameStarted = false;
+    m_inputSampledThisFrame = false;
+    m_hasInputEvent = false;
+}
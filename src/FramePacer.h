@@ -0,0 +1,126 @@
+#ifndef OMEGA_FRAME_PACER_H
+#define OMEGA_FRAME_PACER_H
+
+#include <SDL.h>
+#include <chrono>
+#include <functional>
+
+// How the back buffer reaches the screen (Renderer::setPresentMode)
+enum class PresentMode {
+    VSync,          // Swap waits for vertical blank
+    AdaptiveVSync,  // Waits for vblank, tears instead of halving the rate on a late frame
+    Immediate       // Swap right away; pair with a frame rate cap
+};
+
+const char* presentModeName(PresentMode mode);
+
+struct FramePacingStats {
+    unsigned long long frames = 0;
+    unsigned long long missedDeadlines = 0;   // Frames that presented after their deadline
+
+    double frameTimeMs = 0.0;                 // Present to present, last frame
+    double workTimeMs = 0.0;                  // Input sample to swap, last frame
+    double waitTimeMs = 0.0;                  // Spent in beginFrame, last frame
+
+    // Input sampled (pollEvents) to present returned
+    unsigned long long inputFrames = 0;
+    double inputLatencyMs = 0.0;
+    double inputLatencySumMs = 0.0;
+    double maxInputLatencyMs = 0.0;
+
+    // Oldest input event of the frame to present returned; SDL event
+    // timestamps are whole milliseconds, so this is only as precise as that
+    unsigned long long inputEventFrames = 0;
+    double eventLatencySumMs = 0.0;
+    double maxEventLatencyMs = 0.0;
+
+    double getAverageInputLatencyMs() const { return inputFrames ? inputLatencySumMs / inputFrames : 0.0; }
+    double getAverageEventLatencyMs() const { return inputEventFrames ? eventLatencySumMs / inputEventFrames : 0.0; }
+};
+
+// Paces the main loop and measures how old input is when it reaches the screen.
+// Owned by the Renderer; the loop calls beginFrame() and pollEvents() at the
+// top of the frame, Renderer::present() reports the swap.
+//
+// Frame rate cap: beginFrame() sleeps until shortly before the next frame
+// slot, then spins the rest so the cadence is not at the mercy of the OS
+// scheduler (sleeps commonly overshoot by a millisecond or more).
+//
+// Late input sampling: instead of sampling input right after the previous
+// present and then waiting on the swap, beginFrame() delays the start of the
+// frame so that update + render end just before the deadline (next vblank or
+// next capped frame slot). The delay is the frame period minus the slowest
+// recent work time and a safety margin, so a heavy frame shrinks it on its own.
+class FramePacer {
+public:
+    FramePacer();
+
+    // 0 = uncapped (VSync still limits to the refresh rate)
+    void setTargetFrameRate(double framesPerSecond);
+    double getTargetFrameRate() const { return m_targetFrameRate; }
+
+    void setLateInputSampling(bool enabled) { m_lateInputSampling = enabled; }
+    bool isLateInputSampling() const { return m_lateInputSampling; }
+
+    // Headroom kept between the predicted end of the frame and the deadline
+    void setLateSamplingMargin(double milliseconds) { m_lateMarginMs = milliseconds; }
+
+    // Sleeps shorter than this are replaced by spinning
+    void setSpinThreshold(double milliseconds) { m_spinThresholdMs = milliseconds; }
+
+    // Set by the Renderer from the present mode and the display
+    void setDisplaySync(bool synced, double refreshRate);
+    bool isDisplaySynced() const { return m_displaySynced; }
+
+    // Top of the loop, before input: waits out the frame cap / late sampling delay
+    void beginFrame();
+
+    // Drains the SDL event queue into handler and timestamps the input sample
+    void pollEvents(const std::function<void(const SDL_Event&)>& handler);
+
+    // Renderer::present, around the buffer swap
+    void beforePresent();
+    void afterPresent();
+
+    const FramePacingStats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = FramePacingStats(); }
+
+    // Time between deadlines; 0 when neither capped nor synced
+    double getFramePeriodMs() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static const int WORK_HISTORY = 16;
+
+    void waitUntil(Clock::time_point target);
+    double predictWorkMs() const;
+
+    double m_targetFrameRate;
+    double m_refreshRate;
+    bool m_displaySynced;
+    bool m_lateInputSampling;
+    double m_lateMarginMs;
+    double m_spinThresholdMs;
+    double m_oversleepMs;           // Worst recent sleep overshoot, decays slowly
+
+    Clock::time_point m_deadline;   // When this frame should be on screen
+    Clock::time_point m_frameStart;
+    Clock::time_point m_inputSampled;
+    Clock::time_point m_presentBegin;
+    Clock::time_point m_lastPresent;
+    bool m_hasDeadline;
+    bool m_hasLastPresent;
+    bool m_frameStarted;
+    bool m_inputSampledThisFrame;
+
+    Uint32 m_oldestEventTicks;
+    bool m_hasInputEvent;
+
+    double m_workHistory[WORK_HISTORY];
+    int m_workIndex;
+
+    FramePacingStats m_stats;
+};
+
+#endif // OMEGA_FRAME_PACER_H
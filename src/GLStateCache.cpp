@@ -0,0 +1,127 @@
+#include "GLStateCache.h"
+#include "RenderBackend.h"
+
+GLStateCache& GLStateCache::getInstance() {
+    static GLStateCache instance;
+    return instance;
+}
+
+GLStateCache::GLStateCache() {
+    invalidate();
+}
+
+void GLStateCache::invalidate() {
+    m_programKnown = false;
+    m_program = 0;
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        m_textureKnown[i] = false;
+        m_textures[i] = 0;
+    }
+    m_activeUnit = -1;
+    m_blendEnabled = -1;
+    m_blendFuncKnown = false;
+    m_blendSrc = GL_ONE;
+    m_blendDst = GL_ZERO;
+    m_vertexArrayKnown = false;
+    m_vertexArray = 0;
+}
+
+void GLStateCache::useProgram(GLuint program) {
+    if (m_programKnown && m_program == program) {
+        m_stats.program.elided++;
+        return;
+    }
+    
+    RenderBackend::getActive().useProgram(program);
+    m_program = program;
+    m_programKnown = true;
+    m_stats.program.issued++;
+}
+
+void GLStateCache::activateUnit(unsigned int unit) {
+    if (m_activeUnit != static_cast<int>(unit)) {
+        RenderBackend::getActive().activeTexture(unit);
+        m_activeUnit = static_cast<int>(unit);
+    }
+}
+
+void GLStateCache::bindTexture(unsigned int unit, GLuint texture) {
+    if (unit >= static_cast<unsigned int>(MAX_TEXTURE_UNITS)) {
+        // Untracked unit, always issue
+        RenderBackend& backend = RenderBackend::getActive();
+        backend.activeTexture(unit);
+        backend.bindTexture(texture);
+        m_activeUnit = static_cast<int>(unit);
+        m_stats.texture.issued++;
+        return;
+    }
+    
+    if (m_textureKnown[unit] && m_textures[unit] == texture) {
+        m_stats.texture.elided++;
+        return;
+    }
+    
+    activateUnit(unit);
+    RenderBackend::getActive().bindTexture(texture);
+    m_textures[unit] = texture;
+    m_textureKnown[unit] = true;
+    m_stats.texture.issued++;
+}
+
+void GLStateCache::setBlendEnabled(bool enabled) {
+    int state = enabled ? 1 : 0;
+    if (m_blendEnabled == state) {
+        m_stats.blend.elided++;
+        return;
+    }
+    
+    RenderBackend::getActive().setBlendEnabled(enabled);
+    m_blendEnabled = state;
+    m_stats.blend.issued++;
+}
+
+void GLStateCache::setBlendFunc(GLenum src, GLenum dst) {
+    if (m_blendFuncKnown && m_blendSrc == src && m_blendDst == dst) {
+        m_stats.blend.elided++;
+        return;
+    }
+    
+    RenderBackend::getActive().setBlendFunc(src, dst);
+    m_blendSrc = src;
+    m_blendDst = dst;
+    m_blendFuncKnown = true;
+    m_stats.blend.issued++;
+}
+
+void GLStateCache::bindVertexArray(GLuint vao) {
+    if (m_vertexArrayKnown && m_vertexArray == vao) {
+        m_stats.vertexArray.elided++;
+        return;
+    }
+    
+    RenderBackend::getActive().bindVertexArray(vao);
+    m_vertexArray = vao;
+    m_vertexArrayKnown = true;
+    m_stats.vertexArray.issued++;
+}
+
+void GLStateCache::onProgramDeleted(GLuint program) {
+    // A deleted program stays in use until another is bound, but its name may be reused
+    if (m_program == program) {
+        m_programKnown = false;
+    }
+}
+
+void GLStateCache::onTextureDeleted(GLuint texture) {
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        if (m_textures[i] == texture) {
+            m_textures[i] = 0;
+        }
+    }
+}
+
+void GLStateCache::onVertexArrayDeleted(GLuint vao) {
+    if (m_vertexArray == vao) {
+        m_vertexArray = 0;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef OMEGA_GL_STATE_CACHE_H
+#define OMEGA_GL_STATE_CACHE_H
+
+#include <GL/glew.h>
+
+// Counters for one kind of state change
+struct GLStateCounter {
+    int issued = 0;     // Calls that reached the render backend
+    int elided = 0;     // Calls skipped because the state was already set
+};
+
+struct GLStateStats {
+    GLStateCounter program;
+    GLStateCounter texture;
+    GLStateCounter blend;
+    GLStateCounter vertexArray;
+    
+    int totalElided() const { return program.elided + texture.elided + blend.elided + vertexArray.elided; }
+};
+
+// Shadows the bound program, 2D textures, blend state and VAO so redundant
+// binds never reach the render backend. Anything that changes this state with raw GL
+// calls must call invalidate() afterwards.
+class GLStateCache {
+public:
+    static GLStateCache& getInstance();
+    
+    static const int MAX_TEXTURE_UNITS = 16;
+    
+    void useProgram(GLuint program);
+    void bindTexture(unsigned int unit, GLuint texture);
+    void setBlendEnabled(bool enabled);
+    void setBlendFunc(GLenum src, GLenum dst);
+    void bindVertexArray(GLuint vao);
+    
+    GLuint getProgram() const { return m_program; }
+    GLuint getVertexArray() const { return m_vertexArray; }
+    
+    // Object deletion (GL unbinds deleted objects implicitly)
+    void onProgramDeleted(GLuint program);
+    void onTextureDeleted(GLuint texture);
+    void onVertexArrayDeleted(GLuint vao);
+    
+    // Forget everything, e.g. after context creation or external GL code
+    void invalidate();
+    
+    const GLStateStats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = GLStateStats(); }
+
+private:
+    GLStateCache();
+    ~GLStateCache() = default;
+    GLStateCache(const GLStateCache&) = delete;
+    GLStateCache& operator=(const GLStateCache&) = delete;
+    
+    void activateUnit(unsigned int unit);
+    
+    // Known state; "unknown" forces the next call through
+    bool m_programKnown;
+    GLuint m_program;
+    bool m_textureKnown[MAX_TEXTURE_UNITS];
+    GLuint m_textures[MAX_TEXTURE_UNITS];
+    int m_activeUnit;               // -1 = unknown
+    int m_blendEnabled;             // -1 = unknown, 0 = off, 1 = on
+    bool m_blendFuncKnown;
+    GLenum m_blendSrc;
+    GLenum m_blendDst;
+    bool m_vertexArrayKnown;
+    GLuint m_vertexArray;
+    
+    GLStateStats m_stats;
+};
+
+#endif // OMEGA_GL_STATE_CACHE_H
@@ -0,0 +1,121 @@
+#include "MappedFile.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : m_data(nullptr)
+    , m_size(0)
+#ifdef _WIN32
+    , m_file(nullptr)
+    , m_mapping(nullptr)
+#else
+    , m_fd(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filepath) {
+    close();
+
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "MappedFile: Cannot open " << filepath << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        std::cerr << "MappedFile: Empty or unreadable file " << filepath << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "MappedFile: Cannot map " << filepath << std::endl;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const unsigned char*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filepath) {
+    close();
+
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "MappedFile: Cannot open " << filepath << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        std::cerr << "MappedFile: Empty or unreadable file " << filepath << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        std::cerr << "MappedFile: Cannot map " << filepath << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    // Loaders consume the whole file right away; start reading ahead now
+    madvise(data, static_cast<size_t>(info.st_size), MADV_WILLNEED);
+
+    m_fd = fd;
+    m_data = static_cast<const unsigned char*>(data);
+    m_size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fd = -1;
+}
+
+#endif
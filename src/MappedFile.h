@@ -0,0 +1,36 @@
+#ifndef OMEGA_MAPPED_FILE_H
+#define OMEGA_MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file. Pages are faulted in by the OS as
+// they are touched, so loaders can hand sub-ranges straight to the GPU or
+// parse them in place without an intermediate copy.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filepath);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const unsigned char* getData() const { return m_data; }
+    size_t getSize() const { return m_size; }
+
+private:
+    const unsigned char* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#else
+    int m_fd;
+#endif
+};
+
+#endif // OMEGA_MAPPED_FILE_H
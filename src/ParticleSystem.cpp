@@ -1,4 +1,5 @@
 #include "ParticleSystem.h"
+#include "SpriteBatch.h"
 #include <cmath>
 #include <algorithm>
 
@@ -129,6 +130,15 @@ void ParticleEmitter::render(Shader* shader, int screenWidth, int screenHeight)
     }
 }
 
+void ParticleEmitter::render(SpriteBatch& batch) {
+    for (const auto& particle : m_particles) {
+        if (!particle.active) continue;
+        
+        batch.draw(nullptr, particle.position, Vector2(particle.size, particle.size),
+                   particle.color, particle.rotation);
+    }
+}
+
 bool ParticleEmitter::isActive() const {
     return getActiveParticleCount() > 0;
 }
@@ -181,6 +191,12 @@ void ParticleSystem::render(Shader* shader, int screenWidth, int screenHeight) {
     }
 }
 
+void ParticleSystem::render(SpriteBatch& batch) {
+    for (auto& emitter : m_emitters) {
+        emitter->render(batch);
+    }
+}
+
 int ParticleSystem::getTotalParticleCount() const {
     int count = 0;
     for (const auto& emitter : m_emitters) {
@@ -5,6 +5,9 @@
 #include "Shader.h"
 #include <vector>
 #include <random>
+#include <memory>
+
+class SpriteBatch;
 
 // Single particle
 struct Particle {
@@ -86,6 +89,7 @@ public:
     
     void update(float deltaTime);
     void render(Shader* shader, int screenWidth, int screenHeight);
+    void render(SpriteBatch& batch);
     
     void setPosition(const Vector2& pos) { m_config.position = pos; }
     void emit(int count = 1);
@@ -120,6 +124,7 @@ public:
     
     void update(float deltaTime);
     void render(Shader* shader, int screenWidth, int screenHeight);
+    void render(SpriteBatch& batch);
     
     size_t getEmitterCount() const { return m_emitters.size(); }
     int getTotalParticleCount() const;
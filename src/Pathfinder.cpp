@@ -0,0 +1,668 @@
+#include "Pathfinder.h"
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+namespace {
+
+// Entrances at least this wide get a transition at each end instead of one in the middle
+const int WIDE_ENTRANCE = 6;
+
+const int NEIGHBOR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+const int NEIGHBOR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+enum ClusterSide { SIDE_LEFT, SIDE_RIGHT, SIDE_TOP, SIDE_BOTTOM };
+
+void pushHeap(std::vector<std::pair<int, int>>& heap, int priority, int index) {
+    heap.push_back(std::make_pair(priority, index));
+    std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<int, int>>());
+}
+
+std::pair<int, int> popHeap(std::vector<std::pair<int, int>>& heap) {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<int, int>>());
+    std::pair<int, int> top = heap.back();
+    heap.pop_back();
+    return top;
+}
+
+} // namespace
+
+Pathfinder::Pathfinder(Tilemap* tilemap, int clusterSize)
+    : m_tilemap(tilemap)
+    , m_solidityCallbackId(0)
+    , m_clusterSize(std::max(4, clusterSize))
+    , m_diagonal(true)
+    , m_width(0)
+    , m_height(0)
+    , m_clustersX(0)
+    , m_clustersY(0)
+    , m_dirty(false)
+    , m_gridStamp(0)
+    , m_nodeStamp(0)
+    , m_cacheCapacity(DEFAULT_CACHE_CAPACITY) {
+
+    if (m_tilemap) {
+        m_solidityCallbackId = m_tilemap->addSolidityCallback([this](int x, int y, int width, int height) {
+            markDirty(x, y, width, height);
+        });
+    }
+
+    build();
+}
+
+Pathfinder::~Pathfinder() {
+    if (m_tilemap) {
+        m_tilemap->removeSolidityCallback(m_solidityCallbackId);
+    }
+}
+
+// ============================================================================
+// Abstraction
+// ============================================================================
+
+void Pathfinder::build() {
+    m_clusters.clear();
+    m_borders.clear();
+    m_nodes.clear();
+    m_freeNodes.clear();
+    clearCache();
+    m_dirty = false;
+    if (!m_tilemap) return;
+
+    m_width = m_tilemap->getWidth();
+    m_height = m_tilemap->getHeight();
+    m_clustersX = (m_width + m_clusterSize - 1) / m_clusterSize;
+    m_clustersY = (m_height + m_clusterSize - 1) / m_clusterSize;
+
+    m_clusters.resize(static_cast<size_t>(m_clustersX) * m_clustersY);
+    for (int cy = 0; cy < m_clustersY; cy++) {
+        for (int cx = 0; cx < m_clustersX; cx++) {
+            Cluster& cluster = m_clusters[cy * m_clustersX + cx];
+            cluster.rect.x = cx * m_clusterSize;
+            cluster.rect.y = cy * m_clusterSize;
+            cluster.rect.width = std::min(m_clusterSize, m_width - cluster.rect.x);
+            cluster.rect.height = std::min(m_clusterSize, m_height - cluster.rect.y);
+            cluster.dirty = true;
+            std::fill(cluster.borders, cluster.borders + 4, -1);
+        }
+    }
+
+    // Borders between each cluster and its right and bottom neighbours
+    for (int cy = 0; cy < m_clustersY; cy++) {
+        for (int cx = 0; cx < m_clustersX; cx++) {
+            int index = cy * m_clustersX + cx;
+            if (cx + 1 < m_clustersX) {
+                m_clusters[index].borders[SIDE_RIGHT] = static_cast<int>(m_borders.size());
+                m_clusters[index + 1].borders[SIDE_LEFT] = static_cast<int>(m_borders.size());
+                m_borders.push_back({ index, index + 1, true, true, {} });
+            }
+            if (cy + 1 < m_clustersY) {
+                m_clusters[index].borders[SIDE_BOTTOM] = static_cast<int>(m_borders.size());
+                m_clusters[index + m_clustersX].borders[SIDE_TOP] = static_cast<int>(m_borders.size());
+                m_borders.push_back({ index, index + m_clustersX, false, true, {} });
+            }
+        }
+    }
+
+    size_t clusterArea = static_cast<size_t>(m_clusterSize) * m_clusterSize;
+    m_gridWalkable.assign(clusterArea, 0);
+    m_gridVisited.assign(clusterArea, 0);
+    m_gridCost.assign(clusterArea, 0);
+    m_gridParent.assign(clusterArea, -1);
+    m_gridStamp = 0;
+
+    m_dirty = true;
+    update();
+}
+
+void Pathfinder::markDirty(int x, int y, int width, int height) {
+    if (!m_tilemap) return;
+
+    // A resized map (e.g. loadFromFile) is rebuilt as a whole by update()
+    if (m_tilemap->getWidth() != m_width || m_tilemap->getHeight() != m_height) {
+        m_dirty = true;
+        return;
+    }
+
+    int startX = std::max(0, x);
+    int startY = std::max(0, y);
+    int endX = std::min(m_width, x + width) - 1;
+    int endY = std::min(m_height, y + height) - 1;
+    if (startX > endX || startY > endY) return;
+
+    for (int cy = startY / m_clusterSize; cy <= endY / m_clusterSize; cy++) {
+        for (int cx = startX / m_clusterSize; cx <= endX / m_clusterSize; cx++) {
+            Cluster& cluster = m_clusters[cy * m_clustersX + cx];
+            cluster.dirty = true;
+
+            // Entrances only depend on the outermost rows and columns
+            const Rect& rect = cluster.rect;
+            if (startX <= rect.x && cluster.borders[SIDE_LEFT] >= 0) {
+                m_borders[cluster.borders[SIDE_LEFT]].dirty = true;
+            }
+            if (endX >= rect.x + rect.width - 1 && cluster.borders[SIDE_RIGHT] >= 0) {
+                m_borders[cluster.borders[SIDE_RIGHT]].dirty = true;
+            }
+            if (startY <= rect.y && cluster.borders[SIDE_TOP] >= 0) {
+                m_borders[cluster.borders[SIDE_TOP]].dirty = true;
+            }
+            if (endY >= rect.y + rect.height - 1 && cluster.borders[SIDE_BOTTOM] >= 0) {
+                m_borders[cluster.borders[SIDE_BOTTOM]].dirty = true;
+            }
+        }
+    }
+    m_dirty = true;
+}
+
+void Pathfinder::update() {
+    if (!m_dirty || !m_tilemap) return;
+
+    if (m_tilemap->getWidth() != m_width || m_tilemap->getHeight() != m_height) {
+        build();
+        return;
+    }
+    m_dirty = false;
+
+    for (size_t i = 0; i < m_borders.size(); i++) {
+        if (m_borders[i].dirty) {
+            rebuildBorder(static_cast<int>(i));
+        }
+    }
+
+    std::vector<char> rebuilt(m_clusters.size(), 0);
+    for (size_t i = 0; i < m_clusters.size(); i++) {
+        if (m_clusters[i].dirty) {
+            rebuildCluster(static_cast<int>(i));
+            rebuilt[i] = 1;
+        }
+    }
+    invalidateCache(rebuilt);
+    labelComponents();
+
+    m_stats.abstractNodes = static_cast<int>(m_nodes.size() - m_freeNodes.size());
+}
+
+int Pathfinder::allocateNode(int x, int y, int cluster) {
+    int index;
+    if (!m_freeNodes.empty()) {
+        index = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    } else {
+        index = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    Node& node = m_nodes[index];
+    node.x = x;
+    node.y = y;
+    node.cluster = cluster;
+    node.partner = -1;
+    node.edges.clear();
+    return index;
+}
+
+void Pathfinder::rebuildBorder(int index) {
+    Border& border = m_borders[index];
+    border.dirty = false;
+    m_stats.bordersRebuilt++;
+
+    for (int node : border.nodes) {
+        m_nodes[node].cluster = -1;
+        m_nodes[node].edges.clear();
+        m_freeNodes.push_back(node);
+    }
+    border.nodes.clear();
+
+    // Both sides' node sets change
+    m_clusters[border.first].dirty = true;
+    m_clusters[border.second].dirty = true;
+
+    // Walk the shared edge: tile i on the first side faces tile i on the second
+    const Rect& rect = m_clusters[border.first].rect;
+    int length = border.vertical ? rect.height : rect.width;
+    auto firstTile = [&](int i) {
+        return border.vertical ? TileCoord{ rect.x + rect.width - 1, rect.y + i } : TileCoord{ rect.x + i, rect.y + rect.height - 1 };
+    };
+    auto secondTile = [&](int i) {
+        return border.vertical ? TileCoord{ rect.x + rect.width, rect.y + i } : TileCoord{ rect.x + i, rect.y + rect.height };
+    };
+    auto open = [&](int i) {
+        TileCoord a = firstTile(i);
+        TileCoord b = secondTile(i);
+        return isWalkable(a.x, a.y) && isWalkable(b.x, b.y);
+    };
+    auto addTransition = [&](int i) {
+        TileCoord a = firstTile(i);
+        TileCoord b = secondTile(i);
+        int nodeA = allocateNode(a.x, a.y, border.first);
+        int nodeB = allocateNode(b.x, b.y, border.second);
+        m_nodes[nodeA].partner = nodeB;
+        m_nodes[nodeB].partner = nodeA;
+        border.nodes.push_back(nodeA);
+        border.nodes.push_back(nodeB);
+    };
+
+    for (int i = 0; i < length; ) {
+        if (!open(i)) {
+            i++;
+            continue;
+        }
+        int start = i;
+        while (i < length && open(i)) {
+            i++;
+        }
+
+        if (i - start >= WIDE_ENTRANCE) {
+            addTransition(start);
+            addTransition(i - 1);
+        } else {
+            addTransition((start + i - 1) / 2);
+        }
+    }
+}
+
+void Pathfinder::rebuildCluster(int index) {
+    Cluster& cluster = m_clusters[index];
+    cluster.dirty = false;
+    m_stats.clustersRebuilt++;
+
+    cluster.nodes.clear();
+    for (int side = 0; side < 4; side++) {
+        if (cluster.borders[side] < 0) continue;
+        for (int node : m_borders[cluster.borders[side]].nodes) {
+            if (m_nodes[node].cluster == index) {
+                cluster.nodes.push_back(node);
+            }
+        }
+    }
+
+    for (int node : cluster.nodes) {
+        m_nodes[node].edges.clear();
+    }
+
+    // One flood per node gives its distance to every other node of the cluster
+    for (size_t i = 0; i < cluster.nodes.size(); i++) {
+        Node& from = m_nodes[cluster.nodes[i]];
+        searchRect(cluster.rect, TileCoord{ from.x, from.y }, nullptr);
+
+        for (size_t j = i + 1; j < cluster.nodes.size(); j++) {
+            Node& to = m_nodes[cluster.nodes[j]];
+            int cost = rectDistance(cluster.rect, to.x, to.y);
+            if (cost < 0) continue;
+            from.edges.push_back({ cluster.nodes[j], cost });
+            to.edges.push_back({ cluster.nodes[i], cost });
+        }
+    }
+}
+
+void Pathfinder::labelComponents() {
+    // Flood fill over the whole abstract graph; cheap next to the cluster rebuilds that trigger it
+    m_nodeComponent.assign(m_nodes.size(), -1);
+    std::vector<int> stack;
+    int component = 0;
+
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        if (m_nodes[i].cluster < 0 || m_nodeComponent[i] >= 0) continue;
+
+        m_nodeComponent[i] = component;
+        stack.push_back(static_cast<int>(i));
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            auto visit = [&](int target) {
+                if (m_nodeComponent[target] < 0) {
+                    m_nodeComponent[target] = component;
+                    stack.push_back(target);
+                }
+            };
+            for (const Edge& edge : node.edges) {
+                visit(edge.target);
+            }
+            if (node.partner >= 0) {
+                visit(node.partner);
+            }
+        }
+        component++;
+    }
+}
+
+// ============================================================================
+// Searches
+// ============================================================================
+
+int Pathfinder::heuristic(int dx, int dy) const {
+    dx = std::abs(dx);
+    dy = std::abs(dy);
+    if (!m_diagonal) return STRAIGHT_COST * (dx + dy);
+    return STRAIGHT_COST * std::abs(dx - dy) + DIAGONAL_COST * std::min(dx, dy);
+}
+
+int Pathfinder::searchRect(const Rect& rect, TileCoord start, const TileCoord* goal) {
+    if (++m_gridStamp == 0) {
+        std::fill(m_gridVisited.begin(), m_gridVisited.end(), 0);
+        m_gridStamp = 1;
+    }
+
+    auto local = [&](int x, int y) { return (y - rect.y) * rect.width + (x - rect.x); };
+    auto inside = [&](int x, int y) {
+        return x >= rect.x && x < rect.x + rect.width && y >= rect.y && y < rect.y + rect.height;
+    };
+
+    // One solidity lookup per tile instead of one per neighbour test
+    for (int y = 0; y < rect.height; y++) {
+        for (int x = 0; x < rect.width; x++) {
+            m_gridWalkable[y * rect.width + x] = isWalkable(rect.x + x, rect.y + y);
+        }
+    }
+    auto walkable = [&](int x, int y) { return m_gridWalkable[local(x, y)] != 0; };
+
+    int startIndex = local(start.x, start.y);
+    int goalIndex = goal ? local(goal->x, goal->y) : -1;
+    m_gridVisited[startIndex] = m_gridStamp;
+    m_gridCost[startIndex] = 0;
+    m_gridParent[startIndex] = -1;
+
+    m_heap.clear();
+    pushHeap(m_heap, goal ? heuristic(goal->x - start.x, goal->y - start.y) : 0, startIndex);
+    int directions = m_diagonal ? 8 : 4;
+
+    while (!m_heap.empty()) {
+        std::pair<int, int> top = popHeap(m_heap);
+        int current = top.second;
+        int x = rect.x + current % rect.width;
+        int y = rect.y + current / rect.width;
+        int cost = m_gridCost[current];
+
+        // Stale entry: the tile was reached more cheaply after this was queued
+        int estimate = goal ? heuristic(goal->x - x, goal->y - y) : 0;
+        if (top.first > cost + estimate) continue;
+        if (current == goalIndex) return cost;
+        m_stats.nodesExpanded++;
+
+        for (int d = 0; d < directions; d++) {
+            int nx = x + NEIGHBOR_X[d];
+            int ny = y + NEIGHBOR_Y[d];
+            if (!inside(nx, ny) || !walkable(nx, ny)) continue;
+
+            bool diagonal = d >= 4;
+            if (diagonal && (!walkable(nx, y) || !walkable(x, ny))) continue; // No corner cutting
+
+            int next = local(nx, ny);
+            int nextCost = cost + (diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+            if (m_gridVisited[next] == m_gridStamp && m_gridCost[next] <= nextCost) continue;
+
+            m_gridVisited[next] = m_gridStamp;
+            m_gridCost[next] = nextCost;
+            m_gridParent[next] = current;
+            pushHeap(m_heap, nextCost + (goal ? heuristic(goal->x - nx, goal->y - ny) : 0), next);
+        }
+    }
+    return -1;
+}
+
+int Pathfinder::rectDistance(const Rect& rect, int x, int y) const {
+    int index = (y - rect.y) * rect.width + (x - rect.x);
+    return m_gridVisited[index] == m_gridStamp ? m_gridCost[index] : -1;
+}
+
+void Pathfinder::appendRectPath(const Rect& rect, TileCoord goal, std::vector<TileCoord>& path) const {
+    // Walk the parents back from goal; the search's start tile is already in path
+    size_t insertAt = path.size();
+    for (int index = (goal.y - rect.y) * rect.width + (goal.x - rect.x); m_gridParent[index] >= 0; index = m_gridParent[index]) {
+        path.push_back(TileCoord{ rect.x + index % rect.width, rect.y + index / rect.width });
+    }
+    std::reverse(path.begin() + insertAt, path.end());
+}
+
+bool Pathfinder::searchAbstract(TileCoord start, TileCoord goal, std::vector<int>& chain) {
+    chain.clear();
+
+    size_t goalNode = m_nodes.size(); // Virtual node for the goal tile
+    if (m_nodeVisited.size() < goalNode + 1) {
+        m_nodeVisited.resize(goalNode + 1, 0);
+        m_nodeCost.resize(goalNode + 1, 0);
+        m_nodeParent.resize(goalNode + 1, -1);
+        m_goalVisited.resize(goalNode + 1, 0);
+        m_goalCost.resize(goalNode + 1, 0);
+    }
+    if (++m_nodeStamp == 0) {
+        std::fill(m_nodeVisited.begin(), m_nodeVisited.end(), 0);
+        std::fill(m_goalVisited.begin(), m_goalVisited.end(), 0);
+        m_nodeStamp = 1;
+    }
+
+    // Goal tile to the nodes of its cluster (walking costs are symmetric)
+    const Cluster& goalCluster = m_clusters[clusterAt(goal.x, goal.y)];
+    searchRect(goalCluster.rect, goal, nullptr);
+    std::vector<int> goalComponents;
+    for (int node : goalCluster.nodes) {
+        int cost = rectDistance(goalCluster.rect, m_nodes[node].x, m_nodes[node].y);
+        if (cost >= 0) {
+            m_goalVisited[node] = m_nodeStamp;
+            m_goalCost[node] = cost;
+            goalComponents.push_back(m_nodeComponent[node]);
+        }
+    }
+
+    // Start tile to the nodes of its cluster seeds the open list
+    const Cluster& startCluster = m_clusters[clusterAt(start.x, start.y)];
+    searchRect(startCluster.rect, start, nullptr);
+    m_heap.clear();
+    for (int node : startCluster.nodes) {
+        int cost = rectDistance(startCluster.rect, m_nodes[node].x, m_nodes[node].y);
+        if (cost < 0) continue;
+
+        // Nodes that can't lead to the goal; with none left an unreachable goal
+        // fails here instead of after exhausting the graph
+        if (std::find(goalComponents.begin(), goalComponents.end(), m_nodeComponent[node]) == goalComponents.end()) continue;
+
+        m_nodeVisited[node] = m_nodeStamp;
+        m_nodeCost[node] = cost;
+        m_nodeParent[node] = -1;
+        pushHeap(m_heap, cost + heuristic(goal.x - m_nodes[node].x, goal.y - m_nodes[node].y), node);
+    }
+
+    auto relax = [&](int target, int cost, int parent, int estimate) {
+        if (m_nodeVisited[target] == m_nodeStamp && m_nodeCost[target] <= cost) return;
+        m_nodeVisited[target] = m_nodeStamp;
+        m_nodeCost[target] = cost;
+        m_nodeParent[target] = parent;
+        pushHeap(m_heap, cost + estimate, target);
+    };
+
+    while (!m_heap.empty()) {
+        std::pair<int, int> top = popHeap(m_heap);
+        int current = top.second;
+
+        if (current == static_cast<int>(goalNode)) {
+            for (int node = m_nodeParent[current]; node >= 0; node = m_nodeParent[node]) {
+                chain.push_back(node);
+            }
+            std::reverse(chain.begin(), chain.end());
+            return true;
+        }
+
+        const Node& node = m_nodes[current];
+        int cost = m_nodeCost[current];
+        if (top.first > cost + heuristic(goal.x - node.x, goal.y - node.y)) continue; // Stale
+        m_stats.nodesExpanded++;
+
+        if (m_goalVisited[current] == m_nodeStamp) {
+            relax(static_cast<int>(goalNode), cost + m_goalCost[current], current, 0);
+        }
+        for (const Edge& edge : node.edges) {
+            const Node& target = m_nodes[edge.target];
+            relax(edge.target, cost + edge.cost, current, heuristic(goal.x - target.x, goal.y - target.y));
+        }
+        if (node.partner >= 0) {
+            const Node& target = m_nodes[node.partner];
+            relax(node.partner, cost + STRAIGHT_COST, current, heuristic(goal.x - target.x, goal.y - target.y));
+        }
+    }
+    return false;
+}
+
+bool Pathfinder::findPath(int startX, int startY, int goalX, int goalY, std::vector<TileCoord>& path) {
+    path.clear();
+    if (!m_tilemap) return false;
+    update();
+
+    if (startX < 0 || startX >= m_width || startY < 0 || startY >= m_height ||
+        goalX < 0 || goalX >= m_width || goalY < 0 || goalY >= m_height ||
+        !isWalkable(startX, startY) || !isWalkable(goalX, goalY)) {
+        return false;
+    }
+
+    m_stats.searches++;
+    TileCoord start = { startX, startY };
+    TileCoord goal = { goalX, goalY };
+
+    uint64_t key = (static_cast<uint64_t>(startY * m_width + startX) << 32) | static_cast<uint32_t>(goalY * m_width + goalX);
+    auto cached = m_cache.find(key);
+    if (cached != m_cache.end()) {
+        m_stats.cacheHits++;
+        m_cacheLru.splice(m_cacheLru.begin(), m_cacheLru, cached->second.lruPosition);
+        path = cached->second.path;
+        return true;
+    }
+
+    path.push_back(start);
+
+    // Within one cluster the bounded search is usually enough on its own
+    int startCluster = clusterAt(startX, startY);
+    if (startCluster == clusterAt(goalX, goalY)) {
+        const Rect& rect = m_clusters[startCluster].rect;
+        if (searchRect(rect, start, &goal) >= 0) {
+            appendRectPath(rect, goal, path);
+            storeInCache(key, path);
+            return true;
+        }
+    }
+
+    std::vector<int> chain;
+    if (!searchAbstract(start, goal, chain)) {
+        path.clear();
+        return false;
+    }
+
+    // Refine hop by hop: entrance crossings are single steps, the rest stay inside one cluster
+    TileCoord current = start;
+    int previous = -1;
+    for (int nodeIndex : chain) {
+        const Node& node = m_nodes[nodeIndex];
+        TileCoord target = { node.x, node.y };
+
+        if (previous >= 0 && m_nodes[previous].partner == nodeIndex) {
+            path.push_back(target);
+        } else {
+            const Rect& rect = m_clusters[node.cluster].rect;
+            searchRect(rect, current, &target);
+            appendRectPath(rect, target, path);
+        }
+        current = target;
+        previous = nodeIndex;
+    }
+
+    const Rect& goalRect = m_clusters[clusterAt(goalX, goalY)].rect;
+    searchRect(goalRect, current, &goal);
+    appendRectPath(goalRect, goal, path);
+
+    storeInCache(key, path);
+    return true;
+}
+
+bool Pathfinder::findPath(const Vector2& start, const Vector2& goal, std::vector<Vector2>& waypoints) {
+    waypoints.clear();
+    if (!m_tilemap) return false;
+
+    int startX, startY, goalX, goalY;
+    m_tilemap->worldToTile(start.x, start.y, startX, startY);
+    m_tilemap->worldToTile(goal.x, goal.y, goalX, goalY);
+
+    std::vector<TileCoord> tiles;
+    if (!findPath(startX, startY, goalX, goalY, tiles)) return false;
+
+    float halfWidth = m_tilemap->getTileWidth() * 0.5f;
+    float halfHeight = m_tilemap->getTileHeight() * 0.5f;
+    waypoints.reserve(tiles.size() - 1);
+    for (size_t i = 1; i < tiles.size(); i++) {
+        float worldX, worldY;
+        m_tilemap->tileToWorld(tiles[i].x, tiles[i].y, worldX, worldY);
+        waypoints.push_back(Vector2(worldX + halfWidth, worldY + halfHeight));
+    }
+    return true;
+}
+
+void Pathfinder::setDiagonalMovement(bool enabled) {
+    if (enabled == m_diagonal) return;
+    m_diagonal = enabled;
+
+    // Every intra-cluster distance changes
+    for (Cluster& cluster : m_clusters) {
+        cluster.dirty = true;
+    }
+    m_dirty = true;
+    clearCache();
+}
+
+void Pathfinder::resetStats() {
+    int nodes = m_stats.abstractNodes;
+    m_stats = PathfinderStats();
+    m_stats.abstractNodes = nodes;
+}
+
+// ============================================================================
+// Path Cache
+// ============================================================================
+
+void Pathfinder::setCacheCapacity(size_t paths) {
+    m_cacheCapacity = paths;
+    while (m_cache.size() > m_cacheCapacity) {
+        m_cache.erase(m_cacheLru.back());
+        m_cacheLru.pop_back();
+    }
+}
+
+void Pathfinder::clearCache() {
+    m_cache.clear();
+    m_cacheLru.clear();
+}
+
+void Pathfinder::storeInCache(uint64_t key, const std::vector<TileCoord>& path) {
+    if (m_cacheCapacity == 0) return;
+
+    if (m_cache.size() >= m_cacheCapacity) {
+        m_cache.erase(m_cacheLru.back());
+        m_cacheLru.pop_back();
+    }
+
+    CacheEntry& entry = m_cache[key];
+    entry.path = path;
+    for (const TileCoord& tile : path) {
+        int cluster = clusterAt(tile.x, tile.y);
+        if (entry.clusters.empty() || entry.clusters.back() != cluster) {
+            entry.clusters.push_back(cluster);
+        }
+    }
+    m_cacheLru.push_front(key);
+    entry.lruPosition = m_cacheLru.begin();
+}
+
+void Pathfinder::invalidateCache(const std::vector<char>& rebuiltClusters) {
+    for (auto it = m_cache.begin(); it != m_cache.end(); ) {
+        bool stale = false;
+        for (int cluster : it->second.clusters) {
+            if (rebuiltClusters[cluster]) {
+                stale = true;
+                break;
+            }
+        }
+
+        if (stale) {
+            m_cacheLru.erase(it->second.lruPosition);
+            it = m_cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
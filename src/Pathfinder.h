@@ -0,0 +1,166 @@
+#ifndef OMEGA_PATHFINDER_H
+#define OMEGA_PATHFINDER_H
+
+#include "Tilemap.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+
+struct TileCoord {
+    int x, y;
+};
+
+struct PathfinderStats {
+    uint64_t searches = 0;
+    uint64_t cacheHits = 0;
+    uint64_t nodesExpanded = 0;     // Abstract nodes and tiles, over all searches
+    uint64_t clustersRebuilt = 0;
+    uint64_t bordersRebuilt = 0;
+    int abstractNodes = 0;
+};
+
+// Hierarchical pathfinding (HPA*) over the solid tiles of a Tilemap.
+// The map is cut into clusterSize x clusterSize clusters. Where walkable tiles
+// face each other across a cluster border, each entrance gets a pair of
+// abstract nodes, one per side, and the nodes of a cluster are linked by their
+// walking distance inside it. findPath searches that small graph first, then
+// refines every hop with A* bounded to a single cluster, so the tiles a query
+// touches grow with the path's length in clusters, not with the map.
+//
+// Solidity changes arrive through Tilemap's solidity callback and only
+// rebuild the clusters and borders they touch, on the next update() or
+// findPath. Recent paths are cached until one of the clusters they cross
+// changes. Movement is 8-way without cutting solid corners, or 4-way.
+class Pathfinder {
+public:
+    static const int DEFAULT_CLUSTER_SIZE = 16;
+    static const int STRAIGHT_COST = 10;
+    static const int DIAGONAL_COST = 14;
+    static const size_t DEFAULT_CACHE_CAPACITY = 256;
+
+    explicit Pathfinder(Tilemap* tilemap, int clusterSize = DEFAULT_CLUSTER_SIZE);
+    ~Pathfinder();
+    Pathfinder(const Pathfinder&) = delete;
+    Pathfinder& operator=(const Pathfinder&) = delete;
+
+    // Whole abstraction (also called on construction and when the map changes size)
+    void build();
+
+    // Rebuild clusters marked dirty by Tilemap changes; findPath calls it as well
+    void update();
+    void markDirty(int x, int y, int width, int height);
+
+    // Tiles from start to goal, both included. False, with path cleared, when
+    // an end is outside the map, solid, or the goal can't be reached
+    bool findPath(int startX, int startY, int goalX, int goalY, std::vector<TileCoord>& path);
+    // World positions; the waypoints are tile centres after the start tile
+    bool findPath(const Vector2& start, const Vector2& goal, std::vector<Vector2>& waypoints);
+
+    void setDiagonalMovement(bool enabled);
+    bool hasDiagonalMovement() const { return m_diagonal; }
+
+    // Cached paths stay valid but may no longer be the shortest once a cluster they don't cross opens up
+    void setCacheCapacity(size_t paths);
+    void clearCache();
+
+    int getClusterSize() const { return m_clusterSize; }
+    const PathfinderStats& getStats() const { return m_stats; }
+    void resetStats();
+
+private:
+    struct Rect {
+        int x, y, width, height;
+    };
+
+    struct Edge {
+        int target;
+        int cost;
+    };
+
+    struct Node {
+        int x, y;
+        int cluster;            // -1 while on the free list
+        int partner;            // Node on the other side of the entrance
+        std::vector<Edge> edges;    // Inside the cluster
+    };
+
+    // Between two neighbouring clusters; node pairs (first cluster's side, second's)
+    struct Border {
+        int first;
+        int second;
+        bool vertical;          // Clusters side by side (true) or stacked
+        bool dirty;
+        std::vector<int> nodes;
+    };
+
+    struct Cluster {
+        Rect rect;
+        bool dirty;
+        int borders[4];         // Left, right, top, bottom; -1 at the map edge
+        std::vector<int> nodes;
+    };
+
+    struct CacheEntry {
+        std::vector<TileCoord> path;
+        std::vector<int> clusters;
+        std::list<uint64_t>::iterator lruPosition;
+    };
+
+    int allocateNode(int x, int y, int cluster);
+    void rebuildBorder(int index);
+    void rebuildCluster(int index);
+    void labelComponents();
+
+    bool isWalkable(int x, int y) const { return !m_tilemap->isTileSolid(x, y); }
+    int heuristic(int dx, int dy) const;
+    int clusterAt(int x, int y) const { return (y / m_clusterSize) * m_clustersX + x / m_clusterSize; }
+
+    // Dijkstra (goal == nullptr) or A* over the walkable tiles of rect; returns the
+    // cost to goal or -1. Distances and parents stay readable until the next search
+    int searchRect(const Rect& rect, TileCoord start, const TileCoord* goal);
+    int rectDistance(const Rect& rect, int x, int y) const;
+    void appendRectPath(const Rect& rect, TileCoord goal, std::vector<TileCoord>& path) const;
+
+    bool searchAbstract(TileCoord start, TileCoord goal, std::vector<int>& chain);
+    void storeInCache(uint64_t key, const std::vector<TileCoord>& path);
+    void invalidateCache(const std::vector<char>& rebuiltClusters);
+
+    Tilemap* m_tilemap;
+    int m_solidityCallbackId;
+    int m_clusterSize;
+    bool m_diagonal;
+
+    int m_width;
+    int m_height;
+    int m_clustersX;
+    int m_clustersY;
+    std::vector<Cluster> m_clusters;
+    std::vector<Border> m_borders;
+    std::vector<Node> m_nodes;
+    std::vector<int> m_freeNodes;
+    std::vector<int> m_nodeComponent;           // Connected part of the abstract graph
+    bool m_dirty;
+
+    // Search scratch, reused; stamps avoid clearing between searches
+    uint32_t m_gridStamp;
+    std::vector<char> m_gridWalkable;
+    std::vector<uint32_t> m_gridVisited;
+    std::vector<int> m_gridCost;
+    std::vector<int> m_gridParent;
+    uint32_t m_nodeStamp;
+    std::vector<uint32_t> m_nodeVisited;
+    std::vector<int> m_nodeCost;
+    std::vector<int> m_nodeParent;
+    std::vector<uint32_t> m_goalVisited;
+    std::vector<int> m_goalCost;
+    std::vector<std::pair<int, int>> m_heap;    // (f, index), min-heap
+
+    std::unordered_map<uint64_t, CacheEntry> m_cache;
+    std::list<uint64_t> m_cacheLru;             // Most recently used first
+    size_t m_cacheCapacity;
+
+    PathfinderStats m_stats;
+};
+
+#endif // OMEGA_PATHFINDER_H
@@ -2,6 +2,11 @@
 #include "Debug.h"
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <deque>
+#include <algorithm>
+#include <type_traits>
+#include <limits>
 
 // NOTE: This is a stub implementation. In a real project, you would link against Box2D
 // and implement these methods using the actual Box2D API.
@@ -11,6 +16,8 @@
 // Simple Physics Simulation (Box2D Stub)
 // ============================================================================
 
+// Body state is kept trivially copyable so rollback snapshots are plain memcpys.
+// Shapes live in SimpleWorld::shapes, indexed by slot.
 struct SimpleBody {
     BodyType type;
     Vector2 position;
@@ -21,16 +28,517 @@ struct SimpleBody {
     float gravityScale;
     bool fixedRotation;
     bool enabled;
+    bool alive;
+    uint32_t slot;
     void* userData;
-    std::vector<PhysicsShapeDef> shapes;
+};
+
+// Shape plus precomputed polygon data. Boxes are converted to polygons in addShape
+// so every convex shape goes through the same SAT path. Vertices/normals are SoA,
+// counter-clockwise, in body-local space; world copies are refreshed every step.
+struct SimpleShape {
+    PhysicsShapeDef def;
+    std::vector<float> localX, localY;
+    std::vector<float> localNX, localNY;
+    std::vector<float> worldX, worldY;
+    std::vector<float> worldNX, worldNY;
+    Vector2 worldCenter;
+    float minX, minY, maxX, maxY;
+    
+    bool isPolygon() const { return !localX.empty(); }
+    int vertexCount() const { return static_cast<int>(localX.size()); }
+};
+
+// Persistent pair between two shapes whose AABBs overlap, including warm-start
+// impulses and the cached SAT axis. Separated pairs are kept too so that their
+// separating axis can be tested first next step.
+struct SimpleContact {
+    uint32_t bodyA;
+    uint32_t bodyB;
+    uint16_t shapeA;
+    uint16_t shapeB;
+    Vector2 normal;             // From A to B
+    float penetration;
+    float normalImpulse;
+    float tangentImpulse;
+    Vector2 anchor;             // Contact point relative to bodyA's position
+    Vector2 relativePosition;   // Pose of the pair when last evaluated (for resting early-out)
+    float rotationA;
+    float rotationB;
+    int16_t cachedAxis;         // Edge index of the last separating/reference axis, -1 if none
+    uint8_t axisOwner;          // 0 = axis belongs to A, 1 = axis belongs to B
+    bool touching;
+};
+
+static_assert(std::is_trivially_copyable<SimpleBody>::value, "SimpleBody must stay memcpy-able for snapshots");
+static_assert(std::is_trivially_copyable<SimpleContact>::value, "SimpleContact must stay memcpy-able for snapshots");
+
+// Link from a body to the ECS transform it drives
+struct TransformBinding {
+    uint32_t slot;
+    Transform* transform;
+    std::weak_ptr<Transform> owner;     // Checked before each write; the ECS owns the transform
+    Vector2 lastPosition;   // Pose last written to the transform
+    float lastRotation;
+};
+
+// Broadphase proxy, one per shape
+struct SimpleProxy {
+    float minX, maxX, minY, maxY;
+    uint32_t body;
+    uint16_t shape;
 };
 
 // Temporary world implementation without Box2D
 struct SimpleWorld {
     Vector2 gravity;
-    std::vector<SimpleBody> bodies;
+    std::deque<SimpleBody> bodies;  // deque keeps body addresses stable on growth
+    std::vector<std::vector<SimpleShape>> shapes;
+    std::vector<PhysicsBody*> owners;
+    std::vector<uint32_t> freeSlots;
+    std::vector<SimpleContact> contacts; // Sorted by (bodyA, bodyB, shapeA, shapeB)
+    std::vector<TransformBinding> bindings; // Dense, iterated once per frame
+    std::vector<int32_t> bindingIndex;      // Per slot, -1 if unbound
+    uint32_t revision = 0;          // Bumped whenever bodies or shapes are added/removed
+    
+    // Per-step scratch, kept to avoid reallocating
+    std::vector<SimpleProxy> proxies;
+    std::vector<SimpleContact> newContacts;
+    std::vector<float> velocityBias;
+};
+
+// Snapshot header; the buffer is native-endian and only meant for in-process rollback
+struct PhysicsStateHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t revision;
+    uint32_t bodyCount;
+    uint32_t contactCount;
+    Vector2 gravity;
+    float accumulator;
 };
 
+static const uint32_t PHYSICS_STATE_MAGIC = 0x4F505353; // "OPSS"
+static const uint32_t PHYSICS_STATE_VERSION = 2;
+
+// ============================================================================
+// Narrowphase
+// ============================================================================
+
+namespace {
+
+const float LINEAR_SLOP = 0.005f;
+const float BAUMGARTE = 0.2f;
+const float RESTITUTION_THRESHOLD = 1.0f;
+const float POSE_EPSILON = 1e-6f;
+const int MAX_POLYGON_VERTICES = 16;
+
+bool contactLess(const SimpleContact& a, const SimpleContact& b) {
+    if (a.bodyA != b.bodyA) return a.bodyA < b.bodyA;
+    if (a.bodyB != b.bodyB) return a.bodyB < b.bodyB;
+    if (a.shapeA != b.shapeA) return a.shapeA < b.shapeA;
+    return a.shapeB < b.shapeB;
+}
+
+bool sameContact(const SimpleContact& a, const SimpleContact& b) {
+    return a.bodyA == b.bodyA && a.bodyB == b.bodyB && a.shapeA == b.shapeA && a.shapeB == b.shapeB;
+}
+
+float inverseMass(const SimpleBody& body) {
+    return (body.type == BodyType::Dynamic && body.mass > 0.0f) ? 1.0f / body.mass : 0.0f;
+}
+
+// Precompute local-space SoA vertices and outward edge normals
+bool buildPolygon(SimpleShape& shape) {
+    const PhysicsShapeDef& def = shape.def;
+    
+    std::vector<Vector2> verts;
+    if (def.type == ShapeType::Box) {
+        float hx = def.size.x * 0.5f;
+        float hy = def.size.y * 0.5f;
+        verts = { Vector2(-hx, -hy), Vector2(hx, -hy), Vector2(hx, hy), Vector2(-hx, hy) };
+    } else if (def.type == ShapeType::Polygon) {
+        verts = def.vertices;
+    } else {
+        return true; // Circles don't need polygon data
+    }
+    
+    if (verts.size() < 3 || verts.size() > MAX_POLYGON_VERTICES) {
+        std::cerr << "PhysicsWorld: Polygon needs 3-" << MAX_POLYGON_VERTICES
+                  << " vertices, got " << verts.size() << std::endl;
+        return false;
+    }
+    
+    // Enforce counter-clockwise winding
+    float area2 = 0.0f;
+    for (size_t i = 0; i < verts.size(); i++) {
+        const Vector2& a = verts[i];
+        const Vector2& b = verts[(i + 1) % verts.size()];
+        area2 += a.x * b.y - b.x * a.y;
+    }
+    if (area2 < 0.0f) {
+        std::reverse(verts.begin(), verts.end());
+    }
+    
+    size_t count = verts.size();
+    shape.localX.resize(count);
+    shape.localY.resize(count);
+    shape.localNX.resize(count);
+    shape.localNY.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        const Vector2& a = verts[i];
+        const Vector2& b = verts[(i + 1) % count];
+        float ex = b.x - a.x;
+        float ey = b.y - a.y;
+        float len = std::sqrt(ex * ex + ey * ey);
+        if (len < 1e-6f) {
+            std::cerr << "PhysicsWorld: Polygon has a degenerate edge" << std::endl;
+            shape.localX.clear();
+            return false;
+        }
+        
+        shape.localX[i] = a.x;
+        shape.localY[i] = a.y;
+        shape.localNX[i] = ey / len;
+        shape.localNY[i] = -ex / len;
+    }
+    
+    shape.worldX.resize(count);
+    shape.worldY.resize(count);
+    shape.worldNX.resize(count);
+    shape.worldNY.resize(count);
+    return true;
+}
+
+float polygonArea(const SimpleShape& shape) {
+    float area2 = 0.0f;
+    int count = shape.vertexCount();
+    for (int i = 0; i < count; i++) {
+        int j = (i + 1) % count;
+        area2 += shape.localX[i] * shape.localY[j] - shape.localX[j] * shape.localY[i];
+    }
+    return std::fabs(area2) * 0.5f;
+}
+
+void updateWorldShape(SimpleShape& shape, const SimpleBody& body) {
+    shape.worldCenter = body.position;
+    
+    if (!shape.isPolygon()) {
+        float r = shape.def.radius;
+        shape.minX = body.position.x - r;
+        shape.maxX = body.position.x + r;
+        shape.minY = body.position.y - r;
+        shape.maxY = body.position.y + r;
+        return;
+    }
+    
+    float c = std::cos(body.rotation);
+    float sn = std::sin(body.rotation);
+    float px = body.position.x;
+    float py = body.position.y;
+    int count = shape.vertexCount();
+    
+    const float* lx = shape.localX.data();
+    const float* ly = shape.localY.data();
+    const float* lnx = shape.localNX.data();
+    const float* lny = shape.localNY.data();
+    float* wx = shape.worldX.data();
+    float* wy = shape.worldY.data();
+    float* wnx = shape.worldNX.data();
+    float* wny = shape.worldNY.data();
+    
+    for (int i = 0; i < count; i++) {
+        wx[i] = px + c * lx[i] - sn * ly[i];
+        wy[i] = py + sn * lx[i] + c * ly[i];
+        wnx[i] = c * lnx[i] - sn * lny[i];
+        wny[i] = sn * lnx[i] + c * lny[i];
+    }
+    
+    shape.minX = *std::min_element(wx, wx + count);
+    shape.maxX = *std::max_element(wx, wx + count);
+    shape.minY = *std::min_element(wy, wy + count);
+    shape.maxY = *std::max_element(wy, wy + count);
+}
+
+// Signed distance of polygon b from edge i of polygon a
+float edgeSeparation(const SimpleShape& a, int edge, const SimpleShape& b) {
+    float nx = a.worldNX[edge];
+    float ny = a.worldNY[edge];
+    float px = a.worldX[edge];
+    float py = a.worldY[edge];
+    
+    const float* bx = b.worldX.data();
+    const float* by = b.worldY.data();
+    int count = b.vertexCount();
+    
+    float minDist = nx * (bx[0] - px) + ny * (by[0] - py);
+    for (int j = 1; j < count; j++) {
+        float d = nx * (bx[j] - px) + ny * (by[j] - py);
+        minDist = std::min(minDist, d);
+    }
+    return minDist;
+}
+
+// Largest separation over a's edge normals. The cached axis is tried first and
+// any positive separation exits immediately, so pairs that stay apart cost one axis.
+float findMaxSeparation(const SimpleShape& a, const SimpleShape& b, int cachedAxis, int& bestAxis) {
+    int count = a.vertexCount();
+    
+    if (cachedAxis >= 0 && cachedAxis < count) {
+        float sep = edgeSeparation(a, cachedAxis, b);
+        if (sep > 0.0f) {
+            bestAxis = cachedAxis;
+            return sep;
+        }
+    }
+    
+    float best = -std::numeric_limits<float>::max();
+    bestAxis = 0;
+    for (int i = 0; i < count; i++) {
+        float sep = edgeSeparation(a, i, b);
+        if (sep > best) {
+            best = sep;
+            bestAxis = i;
+            if (sep > 0.0f) break;
+        }
+    }
+    return best;
+}
+
+// Deepest vertex of poly along -normal, used as the contact point
+Vector2 deepestPoint(const SimpleShape& poly, float nx, float ny) {
+    int count = poly.vertexCount();
+    int best = 0;
+    float bestDot = std::numeric_limits<float>::max();
+    for (int i = 0; i < count; i++) {
+        float d = nx * poly.worldX[i] + ny * poly.worldY[i];
+        if (d < bestDot) {
+            bestDot = d;
+            best = i;
+        }
+    }
+    return Vector2(poly.worldX[best], poly.worldY[best]);
+}
+
+void collidePolygons(const SimpleShape& a, const SimpleShape& b, SimpleContact& contact, Vector2& point) {
+    int firstA = contact.axisOwner == 0 ? contact.cachedAxis : -1;
+    int firstB = contact.axisOwner == 1 ? contact.cachedAxis : -1;
+    int axisA = 0;
+    int axisB = 0;
+    float sepA = 0.0f;
+    float sepB = 0.0f;
+    
+    // Start with whichever polygon owned the cached axis
+    if (contact.axisOwner == 1) {
+        sepB = findMaxSeparation(b, a, firstB, axisB);
+        if (sepB > 0.0f) {
+            contact.cachedAxis = static_cast<int16_t>(axisB);
+            contact.touching = false;
+            return;
+        }
+        sepA = findMaxSeparation(a, b, firstA, axisA);
+    } else {
+        sepA = findMaxSeparation(a, b, firstA, axisA);
+        if (sepA > 0.0f) {
+            contact.cachedAxis = static_cast<int16_t>(axisA);
+            contact.axisOwner = 0;
+            contact.touching = false;
+            return;
+        }
+        sepB = findMaxSeparation(b, a, firstB, axisB);
+    }
+    
+    if (sepA > 0.0f || sepB > 0.0f) {
+        bool ownerA = sepA > 0.0f;
+        contact.cachedAxis = static_cast<int16_t>(ownerA ? axisA : axisB);
+        contact.axisOwner = ownerA ? 0 : 1;
+        contact.touching = false;
+        return;
+    }
+    
+    // Prefer A as the reference face unless B is clearly better, to avoid flip-flopping
+    if (sepB > sepA + 0.1f * LINEAR_SLOP) {
+        float nx = b.worldNX[axisB];
+        float ny = b.worldNY[axisB];
+        contact.normal = Vector2(-nx, -ny);
+        contact.penetration = -sepB;
+        contact.cachedAxis = static_cast<int16_t>(axisB);
+        contact.axisOwner = 1;
+        point = deepestPoint(a, nx, ny);
+    } else {
+        float nx = a.worldNX[axisA];
+        float ny = a.worldNY[axisA];
+        contact.normal = Vector2(nx, ny);
+        contact.penetration = -sepA;
+        contact.cachedAxis = static_cast<int16_t>(axisA);
+        contact.axisOwner = 0;
+        point = deepestPoint(b, nx, ny);
+    }
+    contact.touching = true;
+}
+
+// Normal points from the polygon towards the circle
+bool collidePolygonCircle(const SimpleShape& poly, const SimpleShape& circle, int cachedAxis,
+                          int& axis, Vector2& normal, float& penetration, Vector2& point) {
+    float cx = circle.worldCenter.x;
+    float cy = circle.worldCenter.y;
+    float radius = circle.def.radius;
+    int count = poly.vertexCount();
+    
+    if (cachedAxis >= 0 && cachedAxis < count) {
+        float sep = poly.worldNX[cachedAxis] * (cx - poly.worldX[cachedAxis]) +
+                    poly.worldNY[cachedAxis] * (cy - poly.worldY[cachedAxis]);
+        if (sep > radius) {
+            axis = cachedAxis;
+            return false;
+        }
+    }
+    
+    float best = -std::numeric_limits<float>::max();
+    int bestEdge = 0;
+    for (int i = 0; i < count; i++) {
+        float sep = poly.worldNX[i] * (cx - poly.worldX[i]) + poly.worldNY[i] * (cy - poly.worldY[i]);
+        if (sep > radius) {
+            axis = i;
+            return false;
+        }
+        if (sep > best) {
+            best = sep;
+            bestEdge = i;
+        }
+    }
+    axis = bestEdge;
+    
+    float v1x = poly.worldX[bestEdge];
+    float v1y = poly.worldY[bestEdge];
+    int next = (bestEdge + 1) % count;
+    float v2x = poly.worldX[next];
+    float v2y = poly.worldY[next];
+    
+    // Center inside the polygon
+    if (best < 1e-6f) {
+        normal = Vector2(poly.worldNX[bestEdge], poly.worldNY[bestEdge]);
+        penetration = radius - best;
+        point = Vector2(cx - normal.x * radius, cy - normal.y * radius);
+        return true;
+    }
+    
+    // Voronoi regions of the closest edge
+    float u1 = (cx - v1x) * (v2x - v1x) + (cy - v1y) * (v2y - v1y);
+    float u2 = (cx - v2x) * (v1x - v2x) + (cy - v2y) * (v1y - v2y);
+    float vx = 0.0f;
+    float vy = 0.0f;
+    if (u1 <= 0.0f) {
+        vx = v1x; vy = v1y;
+    } else if (u2 <= 0.0f) {
+        vx = v2x; vy = v2y;
+    } else {
+        normal = Vector2(poly.worldNX[bestEdge], poly.worldNY[bestEdge]);
+        penetration = radius - best;
+        point = Vector2(cx - normal.x * radius, cy - normal.y * radius);
+        return true;
+    }
+    
+    float dx = cx - vx;
+    float dy = cy - vy;
+    float distSq = dx * dx + dy * dy;
+    if (distSq > radius * radius) return false;
+    
+    float dist = std::sqrt(distSq);
+    normal = dist > 1e-6f ? Vector2(dx / dist, dy / dist) : Vector2(poly.worldNX[bestEdge], poly.worldNY[bestEdge]);
+    penetration = radius - dist;
+    point = Vector2(vx, vy);
+    return true;
+}
+
+void collideShapes(const SimpleShape& a, const SimpleShape& b, SimpleContact& contact, Vector2& point) {
+    if (a.isPolygon() && b.isPolygon()) {
+        collidePolygons(a, b, contact, point);
+        return;
+    }
+    
+    if (a.isPolygon() || b.isPolygon()) {
+        bool polyIsA = a.isPolygon();
+        const SimpleShape& poly = polyIsA ? a : b;
+        const SimpleShape& circle = polyIsA ? b : a;
+        int axis = 0;
+        Vector2 normal;
+        float penetration = 0.0f;
+        contact.touching = collidePolygonCircle(poly, circle, contact.cachedAxis, axis, normal, penetration, point);
+        contact.cachedAxis = static_cast<int16_t>(axis);
+        contact.axisOwner = polyIsA ? 0 : 1;
+        if (contact.touching) {
+            contact.normal = polyIsA ? normal : Vector2(-normal.x, -normal.y);
+            contact.penetration = penetration;
+        }
+        return;
+    }
+    
+    // Circle vs circle
+    float dx = b.worldCenter.x - a.worldCenter.x;
+    float dy = b.worldCenter.y - a.worldCenter.y;
+    float radii = a.def.radius + b.def.radius;
+    float distSq = dx * dx + dy * dy;
+    contact.cachedAxis = -1;
+    contact.touching = distSq <= radii * radii;
+    if (contact.touching) {
+        float dist = std::sqrt(distSq);
+        contact.normal = dist > 1e-6f ? Vector2(dx / dist, dy / dist) : Vector2(0.0f, 1.0f);
+        contact.penetration = radii - dist;
+        point = Vector2(a.worldCenter.x + contact.normal.x * a.def.radius,
+                        a.worldCenter.y + contact.normal.y * a.def.radius);
+    }
+}
+
+// Runs the narrowphase for a pair, reusing the previous result when neither body moved
+void evaluateContact(SimpleWorld* world, SimpleContact& contact, bool hasHistory) {
+    const SimpleBody& bodyA = world->bodies[contact.bodyA];
+    const SimpleBody& bodyB = world->bodies[contact.bodyB];
+    Vector2 relative(bodyB.position.x - bodyA.position.x, bodyB.position.y - bodyA.position.y);
+    
+    if (hasHistory &&
+        std::fabs(relative.x - contact.relativePosition.x) < POSE_EPSILON &&
+        std::fabs(relative.y - contact.relativePosition.y) < POSE_EPSILON &&
+        std::fabs(bodyA.rotation - contact.rotationA) < POSE_EPSILON &&
+        std::fabs(bodyB.rotation - contact.rotationB) < POSE_EPSILON) {
+        return;
+    }
+    
+    const SimpleShape& shapeA = world->shapes[contact.bodyA][contact.shapeA];
+    const SimpleShape& shapeB = world->shapes[contact.bodyB][contact.shapeB];
+    Vector2 point = bodyA.position;
+    collideShapes(shapeA, shapeB, contact, point);
+    
+    contact.anchor = Vector2(point.x - bodyA.position.x, point.y - bodyA.position.y);
+    contact.relativePosition = relative;
+    contact.rotationA = bodyA.rotation;
+    contact.rotationB = bodyB.rotation;
+    if (!contact.touching) {
+        contact.normalImpulse = 0.0f;
+        contact.tangentImpulse = 0.0f;
+    }
+}
+
+void unbindSlot(SimpleWorld* world, uint32_t slot) {
+    int32_t index = world->bindingIndex[slot];
+    if (index < 0) return;
+    
+    // Swap-remove to keep the binding list dense
+    TransformBinding& last = world->bindings.back();
+    world->bindingIndex[last.slot] = index;
+    world->bindings[index] = last;
+    world->bindings.pop_back();
+    world->bindingIndex[slot] = -1;
+}
+
+bool isSensorContact(const SimpleWorld* world, const SimpleContact& contact) {
+    return world->shapes[contact.bodyA][contact.shapeA].def.isSensor ||
+           world->shapes[contact.bodyB][contact.shapeB].def.isSensor;
+}
+
+} // namespace
+
 // ============================================================================
 // PhysicsBody Implementation
 // ============================================================================
@@ -224,9 +732,9 @@ void PhysicsWorld::step(float deltaTime) {
     m_accumulator += deltaTime;
     
     while (m_accumulator >= m_timeStep) {
-        // Simple physics integration
+        // Integrate velocities
         for (auto& simpleBody : world->bodies) {
-            if (!simpleBody.enabled || simpleBody.type != BodyType::Dynamic) continue;
+            if (!simpleBody.alive || !simpleBody.enabled || simpleBody.type != BodyType::Dynamic) continue;
             
             // Apply gravity
             Vector2 gravityForce(
@@ -235,6 +743,14 @@ void PhysicsWorld::step(float deltaTime) {
             );
             simpleBody.velocity.x += gravityForce.x * m_timeStep;
             simpleBody.velocity.y += gravityForce.y * m_timeStep;
+        }
+        
+        updateContacts();
+        solveContacts();
+        
+        // Integrate positions
+        for (auto& simpleBody : world->bodies) {
+            if (!simpleBody.alive || !simpleBody.enabled || simpleBody.type == BodyType::Static) continue;
             
             // Update position
             simpleBody.position.x += simpleBody.velocity.x * m_timeStep;
@@ -246,10 +762,218 @@ void PhysicsWorld::step(float deltaTime) {
             }
         }
         
+        // Push apart overlapping bodies
+        for (const SimpleContact& contact : world->contacts) {
+            if (!contact.touching || isSensorContact(world, contact)) continue;
+            
+            SimpleBody& bodyA = world->bodies[contact.bodyA];
+            SimpleBody& bodyB = world->bodies[contact.bodyB];
+            float invA = inverseMass(bodyA);
+            float invB = inverseMass(bodyB);
+            float invSum = invA + invB;
+            if (invSum <= 0.0f) continue;
+            
+            float correction = std::max(contact.penetration - LINEAR_SLOP, 0.0f) * BAUMGARTE / invSum;
+            bodyA.position.x -= contact.normal.x * correction * invA;
+            bodyA.position.y -= contact.normal.y * correction * invA;
+            bodyB.position.x += contact.normal.x * correction * invB;
+            bodyB.position.y += contact.normal.y * correction * invB;
+        }
+        
         m_accumulator -= m_timeStep;
     }
 }
 
+void PhysicsWorld::updateContacts() {
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    
+    // Refresh world-space shapes and broadphase proxies
+    world->proxies.clear();
+    for (auto& simpleBody : world->bodies) {
+        if (!simpleBody.alive || !simpleBody.enabled) continue;
+        
+        auto& shapes = world->shapes[simpleBody.slot];
+        for (size_t i = 0; i < shapes.size(); i++) {
+            SimpleShape& shape = shapes[i];
+            updateWorldShape(shape, simpleBody);
+            
+            SimpleProxy proxy;
+            proxy.minX = shape.minX;
+            proxy.maxX = shape.maxX;
+            proxy.minY = shape.minY;
+            proxy.maxY = shape.maxY;
+            proxy.body = simpleBody.slot;
+            proxy.shape = static_cast<uint16_t>(i);
+            world->proxies.push_back(proxy);
+        }
+    }
+    
+    // Sweep and prune along x
+    std::sort(world->proxies.begin(), world->proxies.end(),
+        [](const SimpleProxy& a, const SimpleProxy& b) { return a.minX < b.minX; });
+    
+    world->newContacts.clear();
+    const auto& proxies = world->proxies;
+    for (size_t i = 0; i < proxies.size(); i++) {
+        const SimpleProxy& p = proxies[i];
+        for (size_t j = i + 1; j < proxies.size() && proxies[j].minX <= p.maxX; j++) {
+            const SimpleProxy& q = proxies[j];
+            if (p.body == q.body) continue;
+            if (p.maxY < q.minY || q.maxY < p.minY) continue;
+            
+            const SimpleBody& bodyP = world->bodies[p.body];
+            const SimpleBody& bodyQ = world->bodies[q.body];
+            if (bodyP.type != BodyType::Dynamic && bodyQ.type != BodyType::Dynamic) continue;
+            
+            const PhysicsShapeDef& defP = world->shapes[p.body][p.shape].def;
+            const PhysicsShapeDef& defQ = world->shapes[q.body][q.shape].def;
+            if (!(defP.categoryBits & defQ.maskBits) || !(defQ.categoryBits & defP.maskBits)) continue;
+            
+            SimpleContact contact = {};
+            bool pFirst = p.body < q.body;
+            contact.bodyA = pFirst ? p.body : q.body;
+            contact.bodyB = pFirst ? q.body : p.body;
+            contact.shapeA = pFirst ? p.shape : q.shape;
+            contact.shapeB = pFirst ? q.shape : p.shape;
+            contact.cachedAxis = -1;
+            
+            // Carry over cached axis and warm-start impulses from last step
+            auto it = std::lower_bound(world->contacts.begin(), world->contacts.end(), contact, contactLess);
+            bool hasHistory = it != world->contacts.end() && sameContact(*it, contact);
+            if (hasHistory) {
+                contact = *it;
+            }
+            
+            evaluateContact(world, contact, hasHistory);
+            world->newContacts.push_back(contact);
+        }
+    }
+    
+    std::sort(world->newContacts.begin(), world->newContacts.end(), contactLess);
+    
+    // Begin/end events by merging the old and new sorted contact lists
+    if (m_collisionListener) {
+        const auto& oldContacts = world->contacts;
+        const auto& newContacts = world->newContacts;
+        size_t oi = 0;
+        size_t ni = 0;
+        while (oi < oldContacts.size() || ni < newContacts.size()) {
+            const SimpleContact* oldContact = nullptr;
+            const SimpleContact* newContact = nullptr;
+            if (ni >= newContacts.size() || (oi < oldContacts.size() && contactLess(oldContacts[oi], newContacts[ni]))) {
+                oldContact = &oldContacts[oi++];
+            } else if (oi >= oldContacts.size() || contactLess(newContacts[ni], oldContacts[oi])) {
+                newContact = &newContacts[ni++];
+            } else {
+                oldContact = &oldContacts[oi++];
+                newContact = &newContacts[ni++];
+            }
+            
+            bool wasTouching = oldContact && oldContact->touching;
+            bool isTouching = newContact && newContact->touching;
+            if (wasTouching == isTouching) continue;
+            
+            const SimpleContact& contact = newContact ? *newContact : *oldContact;
+            PhysicsBody* bodyA = world->owners[contact.bodyA];
+            PhysicsBody* bodyB = world->owners[contact.bodyB];
+            bool sensorA = world->shapes[contact.bodyA][contact.shapeA].def.isSensor;
+            bool sensorB = world->shapes[contact.bodyB][contact.shapeB].def.isSensor;
+            
+            if (sensorA || sensorB) {
+                PhysicsBody* sensor = sensorB ? bodyB : bodyA;
+                PhysicsBody* other = sensorB ? bodyA : bodyB;
+                if (isTouching) m_collisionListener->onSensorBegin(other, sensor);
+                else m_collisionListener->onSensorEnd(other, sensor);
+            } else {
+                if (isTouching) m_collisionListener->onCollisionBegin(bodyA, bodyB);
+                else m_collisionListener->onCollisionEnd(bodyA, bodyB);
+            }
+        }
+    }
+    
+    world->contacts.swap(world->newContacts);
+}
+
+void PhysicsWorld::solveContacts() {
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    auto& contacts = world->contacts;
+    world->velocityBias.assign(contacts.size(), 0.0f);
+    
+    // Warm start with last step's accumulated impulses
+    for (size_t i = 0; i < contacts.size(); i++) {
+        SimpleContact& contact = contacts[i];
+        if (!contact.touching || isSensorContact(world, contact)) continue;
+        
+        SimpleBody& bodyA = world->bodies[contact.bodyA];
+        SimpleBody& bodyB = world->bodies[contact.bodyB];
+        float invA = inverseMass(bodyA);
+        float invB = inverseMass(bodyB);
+        
+        Vector2 tangent(-contact.normal.y, contact.normal.x);
+        float px = contact.normal.x * contact.normalImpulse + tangent.x * contact.tangentImpulse;
+        float py = contact.normal.y * contact.normalImpulse + tangent.y * contact.tangentImpulse;
+        bodyA.velocity.x -= px * invA;
+        bodyA.velocity.y -= py * invA;
+        bodyB.velocity.x += px * invB;
+        bodyB.velocity.y += py * invB;
+        
+        // Restitution target from the approach speed before solving
+        float vn = (bodyB.velocity.x - bodyA.velocity.x) * contact.normal.x +
+                   (bodyB.velocity.y - bodyA.velocity.y) * contact.normal.y;
+        if (vn < -RESTITUTION_THRESHOLD) {
+            float restitution = std::max(world->shapes[contact.bodyA][contact.shapeA].def.restitution,
+                                         world->shapes[contact.bodyB][contact.shapeB].def.restitution);
+            world->velocityBias[i] = -restitution * vn;
+        }
+    }
+    
+    for (int iteration = 0; iteration < m_velocityIterations; iteration++) {
+        for (size_t i = 0; i < contacts.size(); i++) {
+            SimpleContact& contact = contacts[i];
+            if (!contact.touching || isSensorContact(world, contact)) continue;
+            
+            SimpleBody& bodyA = world->bodies[contact.bodyA];
+            SimpleBody& bodyB = world->bodies[contact.bodyB];
+            float invA = inverseMass(bodyA);
+            float invB = inverseMass(bodyB);
+            float invSum = invA + invB;
+            if (invSum <= 0.0f) continue;
+            
+            // Normal impulse
+            float rvx = bodyB.velocity.x - bodyA.velocity.x;
+            float rvy = bodyB.velocity.y - bodyA.velocity.y;
+            float vn = rvx * contact.normal.x + rvy * contact.normal.y;
+            float lambda = (world->velocityBias[i] - vn) / invSum;
+            float newImpulse = std::max(contact.normalImpulse + lambda, 0.0f);
+            lambda = newImpulse - contact.normalImpulse;
+            contact.normalImpulse = newImpulse;
+            
+            bodyA.velocity.x -= contact.normal.x * lambda * invA;
+            bodyA.velocity.y -= contact.normal.y * lambda * invA;
+            bodyB.velocity.x += contact.normal.x * lambda * invB;
+            bodyB.velocity.y += contact.normal.y * lambda * invB;
+            
+            // Friction impulse
+            Vector2 tangent(-contact.normal.y, contact.normal.x);
+            rvx = bodyB.velocity.x - bodyA.velocity.x;
+            rvy = bodyB.velocity.y - bodyA.velocity.y;
+            float vt = rvx * tangent.x + rvy * tangent.y;
+            float friction = std::sqrt(world->shapes[contact.bodyA][contact.shapeA].def.friction *
+                                       world->shapes[contact.bodyB][contact.shapeB].def.friction);
+            float maxFriction = friction * contact.normalImpulse;
+            float lambdaT = -vt / invSum;
+            float newTangent = std::max(-maxFriction, std::min(contact.tangentImpulse + lambdaT, maxFriction));
+            lambdaT = newTangent - contact.tangentImpulse;
+            contact.tangentImpulse = newTangent;
+            
+            bodyA.velocity.x -= tangent.x * lambdaT * invA;
+            bodyA.velocity.y -= tangent.y * lambdaT * invA;
+            bodyB.velocity.x += tangent.x * lambdaT * invB;
+            bodyB.velocity.y += tangent.y * lambdaT * invB;
+        }
+    }
+}
+
 void PhysicsWorld::setGravity(const Vector2& gravity) {
     SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
     if (world) {
@@ -276,19 +1000,60 @@ PhysicsBody* PhysicsWorld::createBody(const PhysicsBodyDef& bodyDef) {
     simpleBody.gravityScale = bodyDef.gravityScale;
     simpleBody.fixedRotation = bodyDef.fixedRotation;
     simpleBody.enabled = bodyDef.enabled;
+    simpleBody.alive = true;
     simpleBody.userData = nullptr;
     
-    world->bodies.push_back(simpleBody);
+    // Reuse a destroyed slot if one is available
+    SimpleBody* slotBody = nullptr;
+    if (!world->freeSlots.empty()) {
+        simpleBody.slot = world->freeSlots.back();
+        world->freeSlots.pop_back();
+        slotBody = &world->bodies[simpleBody.slot];
+        *slotBody = simpleBody;
+    } else {
+        simpleBody.slot = static_cast<uint32_t>(world->bodies.size());
+        world->bodies.push_back(simpleBody);
+        world->shapes.emplace_back();
+        world->owners.push_back(nullptr);
+        world->bindingIndex.push_back(-1);
+        slotBody = &world->bodies.back();
+    }
+    world->revision++;
     
-    b2Body* b2body = reinterpret_cast<b2Body*>(&world->bodies.back());
+    b2Body* b2body = reinterpret_cast<b2Body*>(slotBody);
     auto body = std::make_unique<PhysicsBody>(b2body);
     PhysicsBody* ptr = body.get();
+    world->owners[simpleBody.slot] = ptr;
     m_bodies.push_back(std::move(body));
     
     return ptr;
 }
 
 void PhysicsWorld::destroyBody(PhysicsBody* body) {
+    if (!body) return;
+    
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    SimpleBody* simpleBody = reinterpret_cast<SimpleBody*>(body->getB2Body());
+    if (world && simpleBody && simpleBody->alive) {
+        uint32_t slot = simpleBody->slot;
+        simpleBody->alive = false;
+        simpleBody->enabled = false;
+        world->shapes[slot].clear();
+        world->owners[slot] = nullptr;
+        world->freeSlots.push_back(slot);
+        unbindSlot(world, slot);
+        
+        // Drop any contacts referencing the body
+        world->contacts.erase(
+            std::remove_if(world->contacts.begin(), world->contacts.end(),
+                [slot](const SimpleContact& c) {
+                    return c.bodyA == slot || c.bodyB == slot;
+                }),
+            world->contacts.end()
+        );
+        world->revision++;
+    }
+    
     m_bodies.erase(
         std::remove_if(m_bodies.begin(), m_bodies.end(),
             [body](const std::unique_ptr<PhysicsBody>& b) {
@@ -301,20 +1066,190 @@ void PhysicsWorld::destroyBody(PhysicsBody* body) {
 void PhysicsWorld::addShape(PhysicsBody* body, const PhysicsShapeDef& shapeDef) {
     if (!body) return;
     
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
     SimpleBody* simpleBody = reinterpret_cast<SimpleBody*>(body->getB2Body());
-    if (simpleBody) {
-        simpleBody->shapes.push_back(shapeDef);
+    if (world && simpleBody) {
+        auto& shapes = world->shapes[simpleBody->slot];
+        if (shapes.size() >= std::numeric_limits<uint16_t>::max()) {
+            std::cerr << "PhysicsWorld: Too many shapes on one body" << std::endl;
+            return;
+        }
+        
+        SimpleShape shape;
+        shape.def = shapeDef;
+        if (!buildPolygon(shape)) {
+            return;
+        }
+        updateWorldShape(shape, *simpleBody);
         
         // Calculate mass based on shape
         float area = 1.0f;
-        if (shapeDef.type == ShapeType::Box) {
-            area = shapeDef.size.x * shapeDef.size.y;
+        if (shape.isPolygon()) {
+            area = polygonArea(shape);
         } else if (shapeDef.type == ShapeType::Circle) {
             area = 3.14159f * shapeDef.radius * shapeDef.radius;
         }
         
         simpleBody->mass += area * shapeDef.density;
+        shapes.push_back(std::move(shape));
+        world->revision++;
+    }
+}
+
+void PhysicsWorld::bindTransform(PhysicsBody* body, const std::shared_ptr<Transform>& transform) {
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    SimpleBody* simpleBody = body ? reinterpret_cast<SimpleBody*>(body->getB2Body()) : nullptr;
+    if (!world || !simpleBody || !simpleBody->alive) return;
+    
+    uint32_t slot = simpleBody->slot;
+    if (!transform) {
+        unbindSlot(world, slot);
+        return;
+    }
+    
+    TransformBinding binding;
+    binding.slot = slot;
+    binding.transform = transform.get();
+    binding.owner = transform;
+    binding.lastPosition = simpleBody->position;
+    binding.lastRotation = simpleBody->rotation;
+    transform->position = simpleBody->position;
+    transform->rotation = simpleBody->rotation;
+    transform->dirty = true;
+    
+    int32_t index = world->bindingIndex[slot];
+    if (index >= 0) {
+        world->bindings[index] = binding;
+    } else {
+        world->bindingIndex[slot] = static_cast<int32_t>(world->bindings.size());
+        world->bindings.push_back(binding);
+    }
+}
+
+int PhysicsWorld::syncTransforms() {
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    if (!world) return 0;
+    
+    int written = 0;
+    for (size_t i = 0; i < world->bindings.size(); ) {
+        TransformBinding& binding = world->bindings[i];
+        const SimpleBody& body = world->bodies[binding.slot];
+        if (body.position.x == binding.lastPosition.x &&
+            body.position.y == binding.lastPosition.y &&
+            body.rotation == binding.lastRotation) {
+            i++;
+            continue;
+        }
+        
+        // The entity or its Transform is gone; swap-remove moves an unvisited binding into i
+        if (binding.owner.expired()) {
+            unbindSlot(world, binding.slot);
+            continue;
+        }
+        
+        binding.lastPosition = body.position;
+        binding.lastRotation = body.rotation;
+        binding.transform->position = body.position;
+        binding.transform->rotation = body.rotation;
+        binding.transform->dirty = true;
+        written++;
+        i++;
+    }
+    
+    return written;
+}
+
+// ============================================================================
+// Snapshot / Restore
+// ============================================================================
+
+size_t PhysicsWorld::getStateSize() const {
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    if (!world) return 0;
+    
+    return sizeof(PhysicsStateHeader) +
+           world->bodies.size() * sizeof(SimpleBody) +
+           world->contacts.size() * sizeof(SimpleContact);
+}
+
+bool PhysicsWorld::saveState(std::vector<uint8_t>& buffer) const {
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    if (!world) return false;
+    
+    // resize() keeps capacity, so a reused buffer doesn't allocate after the first save
+    buffer.resize(getStateSize());
+    uint8_t* out = buffer.data();
+    
+    PhysicsStateHeader header;
+    header.magic = PHYSICS_STATE_MAGIC;
+    header.version = PHYSICS_STATE_VERSION;
+    header.revision = world->revision;
+    header.bodyCount = static_cast<uint32_t>(world->bodies.size());
+    header.contactCount = static_cast<uint32_t>(world->contacts.size());
+    header.gravity = world->gravity;
+    header.accumulator = m_accumulator;
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    
+    for (const SimpleBody& body : world->bodies) {
+        std::memcpy(out, &body, sizeof(SimpleBody));
+        out += sizeof(SimpleBody);
     }
+    
+    if (!world->contacts.empty()) {
+        std::memcpy(out, world->contacts.data(), world->contacts.size() * sizeof(SimpleContact));
+    }
+    
+    return true;
+}
+
+bool PhysicsWorld::restoreState(const std::vector<uint8_t>& buffer) {
+    SimpleWorld* world = reinterpret_cast<SimpleWorld*>(m_world);
+    if (!world) return false;
+    
+    if (buffer.size() < sizeof(PhysicsStateHeader)) {
+        std::cerr << "PhysicsWorld: State buffer too small" << std::endl;
+        return false;
+    }
+    
+    const uint8_t* in = buffer.data();
+    PhysicsStateHeader header;
+    std::memcpy(&header, in, sizeof(header));
+    in += sizeof(header);
+    
+    if (header.magic != PHYSICS_STATE_MAGIC || header.version != PHYSICS_STATE_VERSION) {
+        std::cerr << "PhysicsWorld: Invalid state buffer" << std::endl;
+        return false;
+    }
+    
+    // Snapshots hold body state only; shapes and PhysicsBody handles must still match
+    if (header.revision != world->revision || header.bodyCount != world->bodies.size()) {
+        std::cerr << "PhysicsWorld: State was saved with a different set of bodies" << std::endl;
+        return false;
+    }
+    
+    size_t expected = sizeof(PhysicsStateHeader) +
+                      header.bodyCount * sizeof(SimpleBody) +
+                      header.contactCount * sizeof(SimpleContact);
+    if (buffer.size() < expected) {
+        std::cerr << "PhysicsWorld: State buffer truncated" << std::endl;
+        return false;
+    }
+    
+    world->gravity = header.gravity;
+    m_accumulator = header.accumulator;
+    
+    for (SimpleBody& body : world->bodies) {
+        std::memcpy(&body, in, sizeof(SimpleBody));
+        in += sizeof(SimpleBody);
+    }
+    
+    world->contacts.resize(header.contactCount);
+    if (header.contactCount > 0) {
+        std::memcpy(world->contacts.data(), in, header.contactCount * sizeof(SimpleContact));
+    }
+    
+    return true;
 }
 
 void PhysicsWorld::setCollisionListener(ICollisionListener* listener) {
@@ -392,21 +1327,26 @@ void PhysicsWorld::debugDraw(DebugRenderer* debugRenderer) {
     
     // Draw all bodies
     for (auto& simpleBody : world->bodies) {
+        if (!simpleBody.alive) continue;
+        
         Color color = simpleBody.type == BodyType::Static ? Color(0.5f, 0.5f, 0.5f, 1.0f) :
                       simpleBody.type == BodyType::Dynamic ? Color(0.0f, 1.0f, 0.0f, 1.0f) :
                       Color(1.0f, 1.0f, 0.0f, 1.0f);
         
         // Draw shapes
-        for (const auto& shape : simpleBody.shapes) {
-            if (shape.type == ShapeType::Box) {
-                debugRenderer->drawRect(
-                    Vector2(simpleBody.position.x - shape.size.x * 0.5f,
-                           simpleBody.position.y - shape.size.y * 0.5f),
-                    shape.size,
-                    color
-                );
-            } else if (shape.type == ShapeType::Circle) {
-                debugRenderer->drawCircle(simpleBody.position, shape.radius, color);
+        for (const auto& shape : world->shapes[simpleBody.slot]) {
+            if (shape.isPolygon()) {
+                int count = shape.vertexCount();
+                for (int i = 0; i < count; i++) {
+                    int j = (i + 1) % count;
+                    debugRenderer->drawLine(
+                        Vector2(shape.worldX[i], shape.worldY[i]),
+                        Vector2(shape.worldX[j], shape.worldY[j]),
+                        color
+                    );
+                }
+            } else if (shape.def.type == ShapeType::Circle) {
+                debugRenderer->drawCircle(simpleBody.position, shape.def.radius, color);
             }
         }
         
@@ -430,45 +1370,57 @@ PhysicsSystem::PhysicsSystem(PhysicsWorld* world)
 }
 
 void PhysicsSystem::update(ECS& ecs, float deltaTime) {
+    (void)ecs; // Bodies write straight into their bound Transform, no per-entity lookups
     if (!m_world) return;
     
     // Step physics
     m_world->step(deltaTime);
     
-    // Sync transforms
-    for (Entity entity = 0; entity < ecs.getEntityCount(); entity++) {
-        if (!ecs.hasComponent<PhysicsComponent>(entity)) continue;
-        
-        auto* physics = ecs.getComponent<PhysicsComponent>(entity);
-        if (!physics || !physics->body || !physics->syncTransform) continue;
-        
-        // Update entity transform from physics body
-        if (ecs.hasComponent<TransformComponent>(entity)) {
-            auto* transform = ecs.getComponent<TransformComponent>(entity);
-            transform->position = physics->body->getPosition();
-            transform->rotation = physics->body->getRotation();
-        }
+    // Sync transforms of bodies that moved
+    m_world->syncTransforms();
+}
+
+void PhysicsSystem::linkEntity(ECS& ecs, Entity entity) {
+    if (!m_world) return;
+    
+    auto* physics = ecs.getComponent<PhysicsComponent>(entity);
+    if (!physics || !physics->body) return;
+    
+    std::shared_ptr<Transform> transform;
+    if (physics->syncTransform) {
+        transform = ecs.getSharedComponent<Transform>(entity);
     }
+    m_world->bindTransform(physics->body, transform);
 }
 
 Entity PhysicsSystem::createPhysicsEntity(ECS& ecs, const PhysicsBodyDef& bodyDef, const PhysicsShapeDef& shapeDef) {
     Entity entity = ecs.createEntity();
     
     // Add transform
-    TransformComponent transform;
-    transform.position = bodyDef.position;
-    transform.rotation = bodyDef.rotation;
-    ecs.addComponent(entity, transform);
+    ecs.addComponent<Transform>(entity);
+    std::shared_ptr<Transform> transform = ecs.getSharedComponent<Transform>(entity);
+    transform->position = bodyDef.position;
+    transform->rotation = bodyDef.rotation;
     
     // Create physics body
     PhysicsBody* body = m_world->createBody(bodyDef);
     m_world->addShape(body, shapeDef);
     
     // Add physics component
-    PhysicsComponent physics;
-    physics.body = body;
-    physics.syncTransform = true;
-    ecs.addComponent(entity, physics);
+    auto* physics = ecs.addComponent<PhysicsComponent>(entity);
+    physics->body = body;
+    physics->syncTransform = true;
+    
+    m_world->bindTransform(body, transform);
     
     return entity;
 }
+
+void PhysicsSystem::destroyPhysicsEntity(ECS& ecs, Entity entity) {
+    auto* physics = ecs.getComponent<PhysicsComponent>(entity);
+    if (physics && physics->body && m_world) {
+        m_world->destroyBody(physics->body); // Also drops the transform binding
+    }
+    
+    ecs.destroyEntity(entity);
+}
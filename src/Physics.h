@@ -6,6 +6,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <cstdint>
 
 // Forward declarations for Box2D (would include box2d/box2d.h in real implementation)
 class b2World;
@@ -152,10 +153,27 @@ public:
     void setPositionIterations(int iterations) { m_positionIterations = iterations; }
     void setTimeStep(float timeStep) { m_timeStep = timeStep; }
     
+    // ECS transform sync. A bound transform is written directly by syncTransforms(),
+    // which touches only bodies whose pose changed since the last sync. The binding
+    // holds the transform weakly: once the ECS frees it (destroyEntity, removeComponent,
+    // a replacing addComponent) the binding is dropped instead of written. Pass nullptr
+    // to unbind (destroyBody unbinds too).
+    void bindTransform(PhysicsBody* body, const std::shared_ptr<Transform>& transform);
+    int syncTransforms(); // Returns the number of transforms written
+    
+    // Rollback snapshots (bodies, contacts and warm-start impulses).
+    // Buffers are native-endian and only valid while the set of bodies/shapes is unchanged.
+    bool saveState(std::vector<uint8_t>& buffer) const;
+    bool restoreState(const std::vector<uint8_t>& buffer);
+    size_t getStateSize() const;
+    
     // Debug
     void debugDraw(class DebugRenderer* debugRenderer);
 
 private:
+    void updateContacts();  // Broadphase + narrowphase, fires begin/end events
+    void solveContacts();   // Warm-started sequential impulses
+    
     b2World* m_world;
     ICollisionListener* m_collisionListener;
     std::vector<std::unique_ptr<PhysicsBody>> m_bodies;
@@ -166,9 +184,9 @@ private:
 };
 
 // Physics component for ECS
-struct PhysicsComponent {
+struct PhysicsComponent : public Component {
     PhysicsBody* body = nullptr;
-    bool syncTransform = true;
+    bool syncTransform = true; // Applied when the entity is linked
 };
 
 // Physics system for ECS
@@ -179,8 +197,12 @@ public:
     
     void update(ECS& ecs, float deltaTime);
     
-    // Helper to create physics-enabled entity
+    // Helper to create physics-enabled entity (body is linked to its Transform)
     Entity createPhysicsEntity(ECS& ecs, const PhysicsBodyDef& bodyDef, const PhysicsShapeDef& shapeDef);
+    void destroyPhysicsEntity(ECS& ecs, Entity entity);
+    
+    // Link an entity with existing PhysicsComponent/Transform (re-run after changing syncTransform)
+    void linkEntity(ECS& ecs, Entity entity);
 
 private:
     PhysicsWorld* m_world;
@@ -0,0 +1,77 @@
+#include "QuadGeometry.h"
+#include "GLStateCache.h"
+#include "RenderBackend.h"
+
+QuadGeometry& QuadGeometry::getInstance() {
+    static QuadGeometry instance;
+    return instance;
+}
+
+QuadGeometry::QuadGeometry()
+    : m_vao(0)
+    , m_vbo(0)
+    , m_ebo(0)
+    , m_initialized(false) {
+}
+
+bool QuadGeometry::initialize() {
+    if (m_initialized) return true;
+
+    // Vertex data: position (2) + texCoord (2)
+    float vertices[] = {
+        // positions   // texCoords
+        0.0f, 1.0f,    0.0f, 1.0f,  // top-left
+        1.0f, 1.0f,    1.0f, 1.0f,  // top-right
+        1.0f, 0.0f,    1.0f, 0.0f,  // bottom-right
+        0.0f, 0.0f,    0.0f, 0.0f   // bottom-left
+    };
+
+    unsigned int indices[] = {
+        0, 1, 2,
+        2, 3, 0
+    };
+
+    RenderBackend& backend = RenderBackend::getActive();
+    m_vao = backend.createVertexArray();
+    m_vbo = backend.createBuffer();
+    m_ebo = backend.createBuffer();
+
+    GLStateCache& state = GLStateCache::getInstance();
+    state.bindVertexArray(m_vao);
+
+    backend.bindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    backend.bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    backend.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    backend.bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    // Position attribute
+    backend.vertexAttribute(0, 2, GL_FLOAT, false, VERTEX_STRIDE, 0);
+
+    // TexCoord attribute
+    backend.vertexAttribute(1, 2, GL_FLOAT, false, VERTEX_STRIDE, 2 * sizeof(float));
+
+    state.bindVertexArray(0);
+
+    m_initialized = true;
+    return true;
+}
+
+void QuadGeometry::shutdown() {
+    if (!m_initialized) return;
+
+    GLStateCache::getInstance().onVertexArrayDeleted(m_vao);
+    RenderBackend& backend = RenderBackend::getActive();
+    backend.deleteVertexArray(m_vao);
+    backend.deleteBuffer(m_vbo);
+    backend.deleteBuffer(m_ebo);
+    m_vao = m_vbo = m_ebo = 0;
+    m_initialized = false;
+}
+
+void QuadGeometry::draw() {
+    if (!m_initialized && !initialize()) return;
+
+    GLStateCache::getInstance().bindVertexArray(m_vao);
+    RenderBackend::getActive().drawIndexed(INDEX_COUNT);
+}
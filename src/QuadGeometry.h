@@ -0,0 +1,41 @@
+#ifndef OMEGA_QUAD_GEOMETRY_H
+#define OMEGA_QUAD_GEOMETRY_H
+
+#include <GL/glew.h>
+
+// The one static unit quad every sprite draws with.
+// Layout: attribute 0 = corner position in [0, 1], attribute 1 = texcoord,
+// interleaved as 4 floats per vertex, 6 uint indices.
+// Created by Renderer::initialize (or lazily on first use) and released by
+// the Renderer before its GL context goes away.
+class QuadGeometry {
+public:
+    static QuadGeometry& getInstance();
+    
+    static const int VERTEX_STRIDE = 4 * sizeof(float);
+    static const int INDEX_COUNT = 6;
+    
+    bool initialize();
+    void shutdown();
+    bool isInitialized() const { return m_initialized; }
+    
+    // Binds the quad VAO (through the state cache) and draws it
+    void draw();
+    
+    GLuint getVertexArray() const { return m_vao; }
+    GLuint getVertexBuffer() const { return m_vbo; }
+    GLuint getIndexBuffer() const { return m_ebo; }
+
+private:
+    QuadGeometry();
+    ~QuadGeometry() = default;
+    QuadGeometry(const QuadGeometry&) = delete;
+    QuadGeometry& operator=(const QuadGeometry&) = delete;
+    
+    GLuint m_vao;
+    GLuint m_vbo;
+    GLuint m_ebo;
+    bool m_initialized;
+};
+
+#endif // OMEGA_QUAD_GEOMETRY_H
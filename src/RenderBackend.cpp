@@ -0,0 +1,728 @@
+#include "RenderBackend.h"
+#include "GLStateCache.h"
+#include <iostream>
+#include <cctype>
+
+namespace {
+
+const char* RENDER_CALL_NAMES[] = {
+    "CreateProgram",
+    "LoadProgramBinary",
+    "DeleteProgram",
+    "CreateTexture",
+    "DeleteTexture",
+    "TextureImage",
+    "TextureSubImage",
+    "CreateBuffer",
+    "DeleteBuffer",
+    "BufferData",
+    "BufferSubData",
+    "CreateVertexArray",
+    "DeleteVertexArray",
+    "VertexAttribute",
+    "UseProgram",
+    "ActiveTexture",
+    "BindTexture",
+    "SetBlendEnabled",
+    "SetBlendFunc",
+    "BindVertexArray",
+    "BindBuffer",
+    "SetUniform",
+    "DrawIndexed",
+    "DrawIndexedInstanced",
+    "SetViewport",
+    "Clear",
+    "Present"
+};
+
+static_assert(sizeof(RENDER_CALL_NAMES) / sizeof(RENDER_CALL_NAMES[0]) == static_cast<size_t>(RenderCall::Count),
+              "RENDER_CALL_NAMES out of sync with RenderCall");
+
+size_t bytesPerPixel(GLenum format) {
+    switch (format) {
+        case GL_RED: return 1;
+        case GL_RG: return 2;
+        case GL_RGB: return 3;
+        default: return 4;
+    }
+}
+
+size_t imageBytes(int width, int height, GLenum format, bool mipmaps) {
+    size_t bytes = static_cast<size_t>(width) * height * bytesPerPixel(format);
+    // A full mip chain adds a third
+    return mipmaps ? bytes + bytes / 3 : bytes;
+}
+
+RenderBackend* s_active = nullptr;
+
+} // namespace
+
+const char* renderCallName(RenderCall call) {
+    int index = static_cast<int>(call);
+    return index < static_cast<int>(RenderCall::Count) ? RENDER_CALL_NAMES[index] : "Unknown";
+}
+
+uint64_t RenderBackendStats::stateChanges() const {
+    return getCount(RenderCall::UseProgram) + getCount(RenderCall::ActiveTexture) +
+           getCount(RenderCall::BindTexture) + getCount(RenderCall::SetBlendEnabled) +
+           getCount(RenderCall::SetBlendFunc) + getCount(RenderCall::BindVertexArray) +
+           getCount(RenderCall::BindBuffer);
+}
+
+// ============================================================================
+// RenderBackend Implementation
+// ============================================================================
+
+RenderBackend::RenderBackend()
+    : m_traceEnabled(false)
+    , m_traceLimit(0) {
+}
+
+RenderBackend& RenderBackend::get(RenderBackendType type) {
+    static GLRenderBackend glBackend;
+    static NullRenderBackend nullBackend;
+    if (type == RenderBackendType::Null) return nullBackend;
+    return glBackend;
+}
+
+RenderBackend& RenderBackend::getActive() {
+    if (!s_active) {
+        s_active = &get(RenderBackendType::OpenGL);
+    }
+    return *s_active;
+}
+
+void RenderBackend::select(RenderBackendType type) {
+    RenderBackend* backend = &get(type);
+    if (backend == s_active) return;
+
+    s_active = backend;
+    // Cached state belongs to the previous backend
+    GLStateCache::getInstance().invalidate();
+}
+
+void RenderBackend::setTraceEnabled(bool enabled, size_t maxEntries) {
+    m_traceEnabled = enabled;
+    m_traceLimit = maxEntries;
+    if (enabled) {
+        m_trace.reserve(maxEntries < 4096 ? maxEntries : 4096);
+    }
+}
+
+void RenderBackend::writeTrace(std::ostream& out) const {
+    for (const RenderTraceEntry& entry : m_trace) {
+        out << renderCallName(entry.call) << ' ' << entry.a << ' ' << entry.b << '\n';
+    }
+}
+
+// ============================================================================
+// GLRenderBackend Implementation
+// ============================================================================
+
+GLuint GLRenderBackend::compileShader(GLenum type, const std::string& source) {
+    GLuint shader = glCreateShader(type);
+    const char* sourceCStr = source.c_str();
+    glShaderSource(shader, 1, &sourceCStr, nullptr);
+    glCompileShader(shader);
+
+    // Check compilation status
+    GLint success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        GLint logLength = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+        std::vector<char> errorLog(logLength > 0 ? logLength : 1);
+        glGetShaderInfoLog(shader, static_cast<GLsizei>(errorLog.size()), &logLength, errorLog.data());
+        std::cerr << "Shader compilation failed: " << errorLog.data() << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+GLuint GLRenderBackend::createProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    if (vertexShader == 0) {
+        return 0;
+    }
+
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    if (fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    if (supportsProgramBinaries()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program);
+
+    // Shaders are no longer needed once linked
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    // Check linking status
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLint logLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+        std::vector<char> errorLog(logLength > 0 ? logLength : 1);
+        glGetProgramInfoLog(program, static_cast<GLsizei>(errorLog.size()), &logLength, errorLog.data());
+        std::cerr << "Shader linking failed: " << errorLog.data() << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    record(RenderCall::CreateProgram, program);
+    return program;
+}
+
+void GLRenderBackend::deleteProgram(GLuint program) {
+    record(RenderCall::DeleteProgram, program);
+    glDeleteProgram(program);
+}
+
+void GLRenderBackend::getUniformLocations(GLuint program, std::unordered_map<std::string, GLint>& locations) {
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::vector<char> nameBuffer(maxNameLength > 0 ? maxNameLength : 1);
+    for (GLint i = 0; i < uniformCount; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()),
+                           &length, &size, &type, nameBuffer.data());
+
+        std::string name(nameBuffer.data(), length);
+        GLint location = glGetUniformLocation(program, name.c_str());
+        if (location == -1) continue; // Uniform block members
+
+        locations[name] = location;
+
+        // Arrays are reported as "name[0]"; also register the bare name
+        size_t bracket = name.find('[');
+        if (bracket != std::string::npos) {
+            locations[name.substr(0, bracket)] = location;
+        }
+    }
+}
+
+bool GLRenderBackend::supportsProgramBinaries() const {
+    if (!GLEW_ARB_get_program_binary) return false;
+
+    // Some drivers expose the entry points but no format to save in
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+bool GLRenderBackend::getProgramBinary(GLuint program, GLenum& format, std::vector<unsigned char>& binary) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return false;
+
+    binary.resize(static_cast<size_t>(length));
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return false;
+
+    binary.resize(static_cast<size_t>(written));
+    return true;
+}
+
+GLuint GLRenderBackend::createProgramFromBinary(GLenum format, const void* data, size_t size) {
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, data, static_cast<GLsizei>(size));
+
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // An unknown format raises GL_INVALID_ENUM; don't leave it for the next glGetError
+        while (glGetError() != GL_NO_ERROR) {}
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    record(RenderCall::LoadProgramBinary, program, size);
+    return program;
+}
+
+std::string GLRenderBackend::getDriverIdentifier() const {
+    std::string identifier;
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        const GLubyte* value = glGetString(name);
+        if (!identifier.empty()) identifier += " | ";
+        identifier += value ? reinterpret_cast<const char*>(value) : "?";
+    }
+    return identifier;
+}
+
+GLuint GLRenderBackend::createTexture() {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    record(RenderCall::CreateTexture, texture);
+    return texture;
+}
+
+void GLRenderBackend::deleteTexture(GLuint texture) {
+    record(RenderCall::DeleteTexture, texture);
+    glDeleteTextures(1, &texture);
+}
+
+void GLRenderBackend::textureImage(int width, int height, GLenum format, const void* data, bool mipmaps) {
+    size_t bytes = data ? imageBytes(width, height, format, mipmaps) : 0;
+    record(RenderCall::TextureImage, static_cast<uint32_t>(format), bytes);
+    m_stats.textureBytesUploaded += bytes;
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Rows of 1 and 3 channel images are not 4-byte aligned in general
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (mipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+}
+
+void GLRenderBackend::textureSubImage(int x, int y, int width, int height, GLenum format, const void* data, int level) {
+    size_t bytes = imageBytes(width, height, format, false);
+    record(RenderCall::TextureSubImage, static_cast<uint32_t>(format), bytes);
+    m_stats.textureBytesUploaded += bytes;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void GLRenderBackend::textureLevel(int level, int levelCount, int width, int height, GLenum format, const void* data) {
+    size_t bytes = data ? imageBytes(width, height, format, false) : 0;
+    record(RenderCall::TextureImage, static_cast<uint32_t>(format), bytes);
+    m_stats.textureBytesUploaded += bytes;
+
+    if (level == 0) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, level, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+GLuint GLRenderBackend::createBuffer() {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    record(RenderCall::CreateBuffer, buffer);
+    return buffer;
+}
+
+void GLRenderBackend::deleteBuffer(GLuint buffer) {
+    record(RenderCall::DeleteBuffer, buffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+void GLRenderBackend::bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) {
+    record(RenderCall::BufferData, static_cast<uint32_t>(target), bytes);
+    if (data) m_stats.bufferBytesUploaded += bytes;
+    glBufferData(target, static_cast<GLsizeiptr>(bytes), data, usage);
+}
+
+void GLRenderBackend::bufferSubData(GLenum target, size_t offset, size_t bytes, const void* data) {
+    record(RenderCall::BufferSubData, static_cast<uint32_t>(target), bytes);
+    m_stats.bufferBytesUploaded += bytes;
+    glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+}
+
+GLuint GLRenderBackend::createVertexArray() {
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    record(RenderCall::CreateVertexArray, vao);
+    return vao;
+}
+
+void GLRenderBackend::deleteVertexArray(GLuint vao) {
+    record(RenderCall::DeleteVertexArray, vao);
+    glDeleteVertexArrays(1, &vao);
+}
+
+void GLRenderBackend::vertexAttribute(GLuint index, int components, GLenum type, bool normalized,
+                                      int stride, size_t offset, GLuint divisor) {
+    record(RenderCall::VertexAttribute, index, offset);
+    glVertexAttribPointer(index, components, type, normalized ? GL_TRUE : GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offset));
+    glEnableVertexAttribArray(index);
+    glVertexAttribDivisor(index, divisor);
+}
+
+void GLRenderBackend::useProgram(GLuint program) {
+    record(RenderCall::UseProgram, program);
+    glUseProgram(program);
+}
+
+void GLRenderBackend::activeTexture(unsigned int unit) {
+    record(RenderCall::ActiveTexture, unit);
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLRenderBackend::bindTexture(GLuint texture) {
+    record(RenderCall::BindTexture, texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLRenderBackend::setBlendEnabled(bool enabled) {
+    record(RenderCall::SetBlendEnabled, enabled ? 1 : 0);
+    if (enabled) {
+        glEnable(GL_BLEND);
+    } else {
+        glDisable(GL_BLEND);
+    }
+}
+
+void GLRenderBackend::setBlendFunc(GLenum src, GLenum dst) {
+    record(RenderCall::SetBlendFunc, static_cast<uint32_t>(src), dst);
+    glBlendFunc(src, dst);
+}
+
+void GLRenderBackend::bindVertexArray(GLuint vao) {
+    record(RenderCall::BindVertexArray, vao);
+    glBindVertexArray(vao);
+}
+
+void GLRenderBackend::bindBuffer(GLenum target, GLuint buffer) {
+    record(RenderCall::BindBuffer, buffer, target);
+    glBindBuffer(target, buffer);
+}
+
+void GLRenderBackend::setUniform(GLint location, int value) {
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+    glUniform1i(location, value);
+}
+
+void GLRenderBackend::setUniform(GLint location, float x, float y) {
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+    glUniform2f(location, x, y);
+}
+
+void GLRenderBackend::setUniform(GLint location, float x, float y, float z, float w) {
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+    glUniform4f(location, x, y, z, w);
+}
+
+void GLRenderBackend::setUniformMatrix4(GLint location, const float* matrix) {
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+    glUniformMatrix4fv(location, 1, GL_FALSE, matrix);
+}
+
+void GLRenderBackend::drawIndexed(int indexCount, int baseVertex) {
+    record(RenderCall::DrawIndexed, static_cast<uint32_t>(indexCount), static_cast<uint64_t>(baseVertex));
+    m_stats.drawCalls++;
+    m_stats.indicesSubmitted += indexCount;
+    if (baseVertex != 0) {
+        glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, baseVertex);
+    } else {
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+    }
+}
+
+void GLRenderBackend::drawIndexedInstanced(int indexCount, int instanceCount) {
+    record(RenderCall::DrawIndexedInstanced, static_cast<uint32_t>(indexCount), static_cast<uint64_t>(instanceCount));
+    m_stats.drawCalls++;
+    m_stats.indicesSubmitted += static_cast<uint64_t>(indexCount) * instanceCount;
+    m_stats.instancesSubmitted += instanceCount;
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+}
+
+void GLRenderBackend::setViewport(int width, int height) {
+    record(RenderCall::SetViewport, static_cast<uint32_t>(width), static_cast<uint64_t>(height));
+    glViewport(0, 0, width, height);
+}
+
+void GLRenderBackend::clear(float r, float g, float b, float a) {
+    record(RenderCall::Clear);
+    glClearColor(r, g, b, a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void GLRenderBackend::present(SDL_Window* window) {
+    record(RenderCall::Present);
+    m_stats.frames++;
+    SDL_GL_SwapWindow(window);
+}
+
+// ============================================================================
+// NullRenderBackend Implementation
+// ============================================================================
+
+NullRenderBackend::NullRenderBackend()
+    : m_nextName(1) {
+}
+
+GLuint NullRenderBackend::createProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+    GLuint program = m_nextName++;
+    record(RenderCall::CreateProgram, program);
+
+    // Collect the names of "uniform <type> <name>[...];" declarations
+    std::vector<std::string>& uniforms = m_programUniforms[program];
+    for (const std::string* source : { &vertexSource, &fragmentSource }) {
+        size_t pos = 0;
+        while ((pos = source->find("uniform", pos)) != std::string::npos) {
+            size_t start = pos;
+            pos += 7;
+            if (start > 0 && (std::isalnum(static_cast<unsigned char>((*source)[start - 1])) || (*source)[start - 1] == '_')) {
+                continue;
+            }
+
+            size_t end = source->find(';', pos);
+            if (end == std::string::npos) break;
+
+            // The name is the last identifier before ';' or '['
+            std::string declaration = source->substr(pos, end - pos);
+            size_t bracket = declaration.find('[');
+            if (bracket != std::string::npos) declaration.resize(bracket);
+            size_t nameEnd = declaration.find_last_not_of(" \t\r\n");
+            if (nameEnd == std::string::npos) continue;
+            size_t nameStart = declaration.find_last_of(" \t\r\n", nameEnd);
+            std::string name = declaration.substr(nameStart + 1, nameEnd - nameStart);
+
+            bool known = false;
+            for (const std::string& existing : uniforms) {
+                if (existing == name) known = true;
+            }
+            if (!known) uniforms.push_back(name);
+            pos = end;
+        }
+    }
+
+    return program;
+}
+
+void NullRenderBackend::deleteProgram(GLuint program) {
+    record(RenderCall::DeleteProgram, program);
+    m_programUniforms.erase(program);
+}
+
+void NullRenderBackend::getUniformLocations(GLuint program, std::unordered_map<std::string, GLint>& locations) {
+    auto it = m_programUniforms.find(program);
+    if (it == m_programUniforms.end()) return;
+
+    for (size_t i = 0; i < it->second.size(); i++) {
+        locations[it->second[i]] = static_cast<GLint>(i);
+    }
+}
+
+bool NullRenderBackend::supportsProgramBinaries() const {
+    return true;
+}
+
+bool NullRenderBackend::getProgramBinary(GLuint program, GLenum& format, std::vector<unsigned char>& binary) {
+    auto it = m_programUniforms.find(program);
+    if (it == m_programUniforms.end()) return false;
+
+    // Uniform names, one per line
+    format = BINARY_FORMAT;
+    binary.clear();
+    for (const std::string& name : it->second) {
+        binary.insert(binary.end(), name.begin(), name.end());
+        binary.push_back('\n');
+    }
+    return true;
+}
+
+GLuint NullRenderBackend::createProgramFromBinary(GLenum format, const void* data, size_t size) {
+    if (format != BINARY_FORMAT) return 0;
+
+    GLuint program = m_nextName++;
+    record(RenderCall::LoadProgramBinary, program, size);
+
+    std::vector<std::string>& uniforms = m_programUniforms[program];
+    const char* text = static_cast<const char*>(data);
+    size_t start = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (text[i] == '\n') {
+            uniforms.emplace_back(text + start, i - start);
+            start = i + 1;
+        }
+    }
+    return program;
+}
+
+std::string NullRenderBackend::getDriverIdentifier() const {
+    return "null";
+}
+
+GLuint NullRenderBackend::createTexture() {
+    GLuint texture = m_nextName++;
+    record(RenderCall::CreateTexture, texture);
+    return texture;
+}
+
+void NullRenderBackend::deleteTexture(GLuint texture) {
+    record(RenderCall::DeleteTexture, texture);
+}
+
+void NullRenderBackend::textureImage(int width, int height, GLenum format, const void* data, bool mipmaps) {
+    size_t bytes = data ? imageBytes(width, height, format, mipmaps) : 0;
+    record(RenderCall::TextureImage, static_cast<uint32_t>(format), bytes);
+    m_stats.textureBytesUploaded += bytes;
+}
+
+void NullRenderBackend::textureSubImage(int x, int y, int width, int height, GLenum format, const void* data, int level) {
+    (void)level;
+    (void)x;
+    (void)y;
+    (void)data;
+    size_t bytes = imageBytes(width, height, format, false);
+    record(RenderCall::TextureSubImage, static_cast<uint32_t>(format), bytes);
+    m_stats.textureBytesUploaded += bytes;
+}
+
+void NullRenderBackend::textureLevel(int level, int levelCount, int width, int height, GLenum format, const void* data) {
+    (void)level;
+    (void)levelCount;
+    size_t bytes = data ? imageBytes(width, height, format, false) : 0;
+    record(RenderCall::TextureImage, static_cast<uint32_t>(format), bytes);
+    m_stats.textureBytesUploaded += bytes;
+}
+
+GLuint NullRenderBackend::createBuffer() {
+    GLuint buffer = m_nextName++;
+    record(RenderCall::CreateBuffer, buffer);
+    return buffer;
+}
+
+void NullRenderBackend::deleteBuffer(GLuint buffer) {
+    record(RenderCall::DeleteBuffer, buffer);
+}
+
+void NullRenderBackend::bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) {
+    (void)usage;
+    record(RenderCall::BufferData, static_cast<uint32_t>(target), bytes);
+    if (data) m_stats.bufferBytesUploaded += bytes;
+}
+
+void NullRenderBackend::bufferSubData(GLenum target, size_t offset, size_t bytes, const void* data) {
+    (void)offset;
+    (void)data;
+    record(RenderCall::BufferSubData, static_cast<uint32_t>(target), bytes);
+    m_stats.bufferBytesUploaded += bytes;
+}
+
+GLuint NullRenderBackend::createVertexArray() {
+    GLuint vao = m_nextName++;
+    record(RenderCall::CreateVertexArray, vao);
+    return vao;
+}
+
+void NullRenderBackend::deleteVertexArray(GLuint vao) {
+    record(RenderCall::DeleteVertexArray, vao);
+}
+
+void NullRenderBackend::vertexAttribute(GLuint index, int components, GLenum type, bool normalized,
+                                        int stride, size_t offset, GLuint divisor) {
+    (void)components;
+    (void)type;
+    (void)normalized;
+    (void)stride;
+    (void)divisor;
+    record(RenderCall::VertexAttribute, index, offset);
+}
+
+void NullRenderBackend::useProgram(GLuint program) {
+    record(RenderCall::UseProgram, program);
+}
+
+void NullRenderBackend::activeTexture(unsigned int unit) {
+    record(RenderCall::ActiveTexture, unit);
+}
+
+void NullRenderBackend::bindTexture(GLuint texture) {
+    record(RenderCall::BindTexture, texture);
+}
+
+void NullRenderBackend::setBlendEnabled(bool enabled) {
+    record(RenderCall::SetBlendEnabled, enabled ? 1 : 0);
+}
+
+void NullRenderBackend::setBlendFunc(GLenum src, GLenum dst) {
+    record(RenderCall::SetBlendFunc, static_cast<uint32_t>(src), dst);
+}
+
+void NullRenderBackend::bindVertexArray(GLuint vao) {
+    record(RenderCall::BindVertexArray, vao);
+}
+
+void NullRenderBackend::bindBuffer(GLenum target, GLuint buffer) {
+    record(RenderCall::BindBuffer, buffer, target);
+}
+
+void NullRenderBackend::setUniform(GLint location, int value) {
+    (void)value;
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+}
+
+void NullRenderBackend::setUniform(GLint location, float x, float y) {
+    (void)x;
+    (void)y;
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+}
+
+void NullRenderBackend::setUniform(GLint location, float x, float y, float z, float w) {
+    (void)x;
+    (void)y;
+    (void)z;
+    (void)w;
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+}
+
+void NullRenderBackend::setUniformMatrix4(GLint location, const float* matrix) {
+    (void)matrix;
+    record(RenderCall::SetUniform, static_cast<uint32_t>(location));
+}
+
+void NullRenderBackend::drawIndexed(int indexCount, int baseVertex) {
+    record(RenderCall::DrawIndexed, static_cast<uint32_t>(indexCount), static_cast<uint64_t>(baseVertex));
+    m_stats.drawCalls++;
+    m_stats.indicesSubmitted += indexCount;
+}
+
+void NullRenderBackend::drawIndexedInstanced(int indexCount, int instanceCount) {
+    record(RenderCall::DrawIndexedInstanced, static_cast<uint32_t>(indexCount), static_cast<uint64_t>(instanceCount));
+    m_stats.drawCalls++;
+    m_stats.indicesSubmitted += static_cast<uint64_t>(indexCount) * instanceCount;
+    m_stats.instancesSubmitted += instanceCount;
+}
+
+void NullRenderBackend::setViewport(int width, int height) {
+    record(RenderCall::SetViewport, static_cast<uint32_t>(width), static_cast<uint64_t>(height));
+}
+
+void NullRenderBackend::clear(float r, float g, float b, float a) {
+    (void)r;
+    (void)g;
+    (void)b;
+    (void)a;
+    record(RenderCall::Clear);
+}
+
+void NullRenderBackend::present(SDL_Window* window) {
+    (void)window;
+    record(RenderCall::Present);
+    m_stats.frames++;
+}
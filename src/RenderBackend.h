@@ -0,0 +1,297 @@
+#ifndef OMEGA_RENDER_BACKEND_H
+#define OMEGA_RENDER_BACKEND_H
+
+#include <SDL.h>
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <ostream>
+
+enum class RenderBackendType {
+    OpenGL,     // Issues real GL calls; needs a current context
+    Null        // Records calls only; runs without a window, context or GPU
+};
+
+// Every call the engine makes into the graphics API
+enum class RenderCall : uint8_t {
+    CreateProgram,
+    LoadProgramBinary,
+    DeleteProgram,
+    CreateTexture,
+    DeleteTexture,
+    TextureImage,
+    TextureSubImage,
+    CreateBuffer,
+    DeleteBuffer,
+    BufferData,
+    BufferSubData,
+    CreateVertexArray,
+    DeleteVertexArray,
+    VertexAttribute,
+    UseProgram,
+    ActiveTexture,
+    BindTexture,
+    SetBlendEnabled,
+    SetBlendFunc,
+    BindVertexArray,
+    BindBuffer,
+    SetUniform,
+    DrawIndexed,
+    DrawIndexedInstanced,
+    SetViewport,
+    Clear,
+    Present,
+    Count
+};
+
+const char* renderCallName(RenderCall call);
+
+// One recorded call; the meaning of a and b depends on the call
+// (object id, byte count, index count, ...)
+struct RenderTraceEntry {
+    RenderCall call;
+    uint32_t a;
+    uint64_t b;
+};
+
+struct RenderBackendStats {
+    uint64_t calls[static_cast<int>(RenderCall::Count)] = {};
+
+    uint64_t drawCalls = 0;             // Indexed + instanced
+    uint64_t indicesSubmitted = 0;
+    uint64_t instancesSubmitted = 0;
+    uint64_t bufferBytesUploaded = 0;
+    uint64_t textureBytesUploaded = 0;
+    uint64_t frames = 0;
+
+    uint64_t getCount(RenderCall call) const { return calls[static_cast<int>(call)]; }
+
+    // Binds and fixed-function changes that reached the API (after the state cache)
+    uint64_t stateChanges() const;
+    uint64_t bufferUploads() const { return getCount(RenderCall::BufferData) + getCount(RenderCall::BufferSubData); }
+    uint64_t textureUploads() const { return getCount(RenderCall::TextureImage) + getCount(RenderCall::TextureSubImage); }
+};
+
+// The thin layer between the engine and the graphics API. GLStateCache,
+// Shader, Texture, QuadGeometry, StreamBuffer and SpriteBatch talk to the
+// active backend instead of calling GL directly, so the whole render path can
+// run against the Null backend on machines without a GPU.
+// Both backends count every call; the trace is optional and off by default.
+// All calls must come from the render thread.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // Process-wide backend instances; they outlive every Renderer so resources
+    // released late (asset caches) still reach the backend that created them
+    static RenderBackend& getActive();
+    static RenderBackend& get(RenderBackendType type);
+    static void select(RenderBackendType type);
+
+    virtual RenderBackendType getType() const = 0;
+
+    // Persistent/unsynchronized buffer mapping (StreamBuffer fast paths)
+    virtual bool supportsBufferMapping() const = 0;
+
+    // Programs (0 on failure, errors go to std::cerr)
+    virtual GLuint createProgram(const std::string& vertexSource, const std::string& fragmentSource) = 0;
+    virtual void deleteProgram(GLuint program) = 0;
+    virtual void getUniformLocations(GLuint program, std::unordered_map<std::string, GLint>& locations) = 0;
+
+    // Linked program binaries (ShaderCache). A binary is only valid for the
+    // driver build that produced it, see getDriverIdentifier
+    virtual bool supportsProgramBinaries() const = 0;
+    virtual bool getProgramBinary(GLuint program, GLenum& format, std::vector<unsigned char>& binary) = 0;
+    // 0 when the driver rejects the binary; nothing is printed, callers fall back to source
+    virtual GLuint createProgramFromBinary(GLenum format, const void* data, size_t size) = 0;
+    virtual std::string getDriverIdentifier() const = 0;
+
+    // Textures; image calls act on the texture bound to the active unit
+    virtual GLuint createTexture() = 0;
+    virtual void deleteTexture(GLuint texture) = 0;
+    virtual void textureImage(int width, int height, GLenum format, const void* data, bool mipmaps) = 0;
+    virtual void textureSubImage(int x, int y, int width, int height, GLenum format, const void* data, int level = 0) = 0;
+    // One level of a prebuilt mip chain; level 0 also sets up sampling for levelCount levels
+    virtual void textureLevel(int level, int levelCount, int width, int height, GLenum format, const void* data) = 0;
+
+    // Buffers and vertex arrays
+    virtual GLuint createBuffer() = 0;
+    virtual void deleteBuffer(GLuint buffer) = 0;
+    virtual void bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) = 0;
+    virtual void bufferSubData(GLenum target, size_t offset, size_t bytes, const void* data) = 0;
+    virtual GLuint createVertexArray() = 0;
+    virtual void deleteVertexArray(GLuint vao) = 0;
+    // Describes and enables an attribute of the bound VAO, sourced from the bound array buffer
+    virtual void vertexAttribute(GLuint index, int components, GLenum type, bool normalized,
+                                 int stride, size_t offset, GLuint divisor = 0) = 0;
+
+    // State (normally reached through GLStateCache)
+    virtual void useProgram(GLuint program) = 0;
+    virtual void activeTexture(unsigned int unit) = 0;
+    virtual void bindTexture(GLuint texture) = 0;
+    virtual void setBlendEnabled(bool enabled) = 0;
+    virtual void setBlendFunc(GLenum src, GLenum dst) = 0;
+    virtual void bindVertexArray(GLuint vao) = 0;
+    virtual void bindBuffer(GLenum target, GLuint buffer) = 0;
+
+    // Uniforms of the program in use
+    virtual void setUniform(GLint location, int value) = 0;
+    virtual void setUniform(GLint location, float x, float y) = 0;
+    virtual void setUniform(GLint location, float x, float y, float z, float w) = 0;
+    virtual void setUniformMatrix4(GLint location, const float* matrix) = 0;
+
+    // Triangles with uint indices from the bound VAO
+    virtual void drawIndexed(int indexCount, int baseVertex = 0) = 0;
+    virtual void drawIndexedInstanced(int indexCount, int instanceCount) = 0;
+
+    // Frame
+    virtual void setViewport(int width, int height) = 0;
+    virtual void clear(float r, float g, float b, float a) = 0;
+    virtual void present(SDL_Window* window) = 0;
+
+    // Recording
+    const RenderBackendStats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = RenderBackendStats(); }
+
+    // maxEntries bounds memory on long runs; later calls are counted but not traced
+    void setTraceEnabled(bool enabled, size_t maxEntries = 1 << 20);
+    bool isTraceEnabled() const { return m_traceEnabled; }
+    const std::vector<RenderTraceEntry>& getTrace() const { return m_trace; }
+    void clearTrace() { m_trace.clear(); }
+    void writeTrace(std::ostream& out) const;
+
+protected:
+    RenderBackend();
+
+    void record(RenderCall call, uint32_t a = 0, uint64_t b = 0) {
+        m_stats.calls[static_cast<int>(call)]++;
+        if (m_traceEnabled && m_trace.size() < m_traceLimit) {
+            m_trace.push_back({ call, a, b });
+        }
+    }
+
+    RenderBackendStats m_stats;
+
+private:
+    bool m_traceEnabled;
+    size_t m_traceLimit;
+    std::vector<RenderTraceEntry> m_trace;
+};
+
+// Forwards to OpenGL 3.3 core
+class GLRenderBackend : public RenderBackend {
+public:
+    RenderBackendType getType() const override { return RenderBackendType::OpenGL; }
+    bool supportsBufferMapping() const override { return true; }
+
+    GLuint createProgram(const std::string& vertexSource, const std::string& fragmentSource) override;
+    void deleteProgram(GLuint program) override;
+    void getUniformLocations(GLuint program, std::unordered_map<std::string, GLint>& locations) override;
+    bool supportsProgramBinaries() const override;
+    bool getProgramBinary(GLuint program, GLenum& format, std::vector<unsigned char>& binary) override;
+    GLuint createProgramFromBinary(GLenum format, const void* data, size_t size) override;
+    std::string getDriverIdentifier() const override;
+
+    GLuint createTexture() override;
+    void deleteTexture(GLuint texture) override;
+    void textureImage(int width, int height, GLenum format, const void* data, bool mipmaps) override;
+    void textureSubImage(int x, int y, int width, int height, GLenum format, const void* data, int level = 0) override;
+    void textureLevel(int level, int levelCount, int width, int height, GLenum format, const void* data) override;
+
+    GLuint createBuffer() override;
+    void deleteBuffer(GLuint buffer) override;
+    void bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) override;
+    void bufferSubData(GLenum target, size_t offset, size_t bytes, const void* data) override;
+    GLuint createVertexArray() override;
+    void deleteVertexArray(GLuint vao) override;
+    void vertexAttribute(GLuint index, int components, GLenum type, bool normalized,
+                         int stride, size_t offset, GLuint divisor = 0) override;
+
+    void useProgram(GLuint program) override;
+    void activeTexture(unsigned int unit) override;
+    void bindTexture(GLuint texture) override;
+    void setBlendEnabled(bool enabled) override;
+    void setBlendFunc(GLenum src, GLenum dst) override;
+    void bindVertexArray(GLuint vao) override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+
+    void setUniform(GLint location, int value) override;
+    void setUniform(GLint location, float x, float y) override;
+    void setUniform(GLint location, float x, float y, float z, float w) override;
+    void setUniformMatrix4(GLint location, const float* matrix) override;
+
+    void drawIndexed(int indexCount, int baseVertex = 0) override;
+    void drawIndexedInstanced(int indexCount, int instanceCount) override;
+
+    void setViewport(int width, int height) override;
+    void clear(float r, float g, float b, float a) override;
+    void present(SDL_Window* window) override;
+
+private:
+    GLuint compileShader(GLenum type, const std::string& source);
+};
+
+// Hands out fake object names and records calls without touching any API.
+// Uniform locations are taken from the `uniform` declarations in the shader
+// source, so uniform uploads are counted like they would be on GL. Program
+// "binaries" hold that uniform list, so the shader cache works headless too.
+class NullRenderBackend : public RenderBackend {
+public:
+    NullRenderBackend();
+
+    RenderBackendType getType() const override { return RenderBackendType::Null; }
+    bool supportsBufferMapping() const override { return false; }
+
+    GLuint createProgram(const std::string& vertexSource, const std::string& fragmentSource) override;
+    void deleteProgram(GLuint program) override;
+    void getUniformLocations(GLuint program, std::unordered_map<std::string, GLint>& locations) override;
+    bool supportsProgramBinaries() const override;
+    bool getProgramBinary(GLuint program, GLenum& format, std::vector<unsigned char>& binary) override;
+    GLuint createProgramFromBinary(GLenum format, const void* data, size_t size) override;
+    std::string getDriverIdentifier() const override;
+
+    GLuint createTexture() override;
+    void deleteTexture(GLuint texture) override;
+    void textureImage(int width, int height, GLenum format, const void* data, bool mipmaps) override;
+    void textureSubImage(int x, int y, int width, int height, GLenum format, const void* data, int level = 0) override;
+    void textureLevel(int level, int levelCount, int width, int height, GLenum format, const void* data) override;
+
+    GLuint createBuffer() override;
+    void deleteBuffer(GLuint buffer) override;
+    void bufferData(GLenum target, size_t bytes, const void* data, GLenum usage) override;
+    void bufferSubData(GLenum target, size_t offset, size_t bytes, const void* data) override;
+    GLuint createVertexArray() override;
+    void deleteVertexArray(GLuint vao) override;
+    void vertexAttribute(GLuint index, int components, GLenum type, bool normalized,
+                         int stride, size_t offset, GLuint divisor = 0) override;
+
+    void useProgram(GLuint program) override;
+    void activeTexture(unsigned int unit) override;
+    void bindTexture(GLuint texture) override;
+    void setBlendEnabled(bool enabled) override;
+    void setBlendFunc(GLenum src, GLenum dst) override;
+    void bindVertexArray(GLuint vao) override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+
+    void setUniform(GLint location, int value) override;
+    void setUniform(GLint location, float x, float y) override;
+    void setUniform(GLint location, float x, float y, float z, float w) override;
+    void setUniformMatrix4(GLint location, const float* matrix) override;
+
+    void drawIndexed(int indexCount, int baseVertex = 0) override;
+    void drawIndexedInstanced(int indexCount, int instanceCount) override;
+
+    void setViewport(int width, int height) override;
+    void clear(float r, float g, float b, float a) override;
+    void present(SDL_Window* window) override;
+
+private:
+    static const GLenum BINARY_FORMAT = 0x4E554C4C; // "NULL"
+
+    GLuint m_nextName;
+    std::unordered_map<GLuint, std::vector<std::string>> m_programUniforms;
+};
+
+#endif // OMEGA_RENDER_BACKEND_H
@@ -0,0 +1,158 @@
+#include "RenderQueue.h"
+#include "Shader.h"
+#include "Texture.h"
+
+namespace {
+
+const int LAYER_SHIFT = 56;
+const int TRANSLUCENT_SHIFT = 55;
+const uint64_t SHADER_MASK = 0xFFF;
+const uint64_t TEXTURE_MASK = 0xFFFF;
+const uint64_t DEPTH_MASK = 0xFFFFFF;
+
+uint64_t quantizeDepth(float depth) {
+    depth = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+    return static_cast<uint64_t>(depth * static_cast<float>(DEPTH_MASK));
+}
+
+} // namespace
+
+RenderQueue::RenderQueue(size_t capacity)
+    : m_keys(capacity)
+    , m_commands(capacity)
+    , m_next(0)
+    , m_isSorted(false) {
+}
+
+RenderKey RenderQueue::makeKey(uint8_t layer, bool translucent, uint32_t shaderId, uint32_t textureId, float depth) {
+    // GL object names are small integers, so truncation only costs grouping, never correctness
+    uint64_t key = static_cast<uint64_t>(layer) << LAYER_SHIFT;
+    uint64_t shader = shaderId & SHADER_MASK;
+    uint64_t texture = textureId & TEXTURE_MASK;
+    uint64_t z = quantizeDepth(depth);
+    
+    if (translucent) {
+        key |= 1ull << TRANSLUCENT_SHIFT;
+        key |= (DEPTH_MASK - z) << 31;
+        key |= shader << 19;
+        key |= texture << 3;
+    } else {
+        key |= shader << 43;
+        key |= texture << 27;
+        key |= z << 3;
+    }
+    return key;
+}
+
+RenderKey RenderQueue::makeKey(const RenderCommand& command, uint8_t layer, float depth) {
+    uint32_t shaderId = command.shader ? command.shader->getProgramID() : 0;
+    uint32_t textureId = command.texture ? command.texture->getID() : 0;
+    bool translucent = command.blendMode != BlendMode::None;
+    return makeKey(layer, translucent, shaderId, textureId, depth);
+}
+
+void RenderQueue::submit(const RenderCommand& command, uint8_t layer, float depth) {
+    submit(makeKey(command, layer, depth), command);
+}
+
+void RenderQueue::submit(RenderKey key, const RenderCommand& command) {
+    size_t slot = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (slot < m_keys.size()) {
+        m_keys[slot] = key;
+        m_commands[slot] = command;
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_overflowMutex);
+    m_overflowKeys.push_back(key);
+    m_overflowCommands.push_back(command);
+}
+
+size_t RenderQueue::getCommandCount() const {
+    size_t count = m_next.load(std::memory_order_acquire);
+    return count < m_keys.size() ? count : m_keys.size();
+}
+
+void RenderQueue::sort() {
+    size_t count = getCommandCount();
+    
+    // Fold the spill-over into the main arrays; they become the new capacity
+    if (!m_overflowKeys.empty()) {
+        m_keys.insert(m_keys.end(), m_overflowKeys.begin(), m_overflowKeys.end());
+        m_commands.insert(m_commands.end(), m_overflowCommands.begin(), m_overflowCommands.end());
+        count += m_overflowKeys.size();
+        m_overflowKeys.clear();
+        m_overflowCommands.clear();
+        m_next.store(count, std::memory_order_relaxed);
+    }
+    
+    m_sorted.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        m_sorted[i].key = m_keys[i];
+        m_sorted[i].index = static_cast<uint32_t>(i);
+    }
+    
+    radixSort(count);
+    m_isSorted = true;
+}
+
+void RenderQueue::radixSort(size_t count) {
+    if (count < 2) return;
+    
+    m_scratch.resize(count);
+    SortEntry* src = m_sorted.data();
+    SortEntry* dst = m_scratch.data();
+    
+    // LSD radix, 8 bits per pass
+    for (int pass = 0; pass < 8; pass++) {
+        int shift = pass * 8;
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; i++) {
+            histogram[(src[i].key >> shift) & 0xFF]++;
+        }
+        
+        // Every key shares this byte; the pass would be an identity permutation
+        if (histogram[(src[0].key >> shift) & 0xFF] == count) continue;
+        
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t n = histogram[b];
+            histogram[b] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; i++) {
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    
+    if (src != m_sorted.data()) {
+        m_sorted.swap(m_scratch);
+    }
+}
+
+void RenderQueue::execute(SpriteBatch& batch, int screenWidth, int screenHeight, Camera* camera) {
+    if (!m_isSorted) {
+        sort();
+    }
+    
+    batch.begin(screenWidth, screenHeight, camera);
+    for (const SortEntry& entry : m_sorted) {
+        const RenderCommand& command = m_commands[entry.index];
+        
+        // The batch ignores unchanged state, so only real transitions flush
+        batch.setShader(command.shader);
+        batch.setBlendMode(command.blendMode);
+        batch.draw(command.texture, command.position, command.size, command.color,
+                   command.rotation, command.uv0, command.uv1);
+    }
+    batch.end();
+    
+    clear();
+}
+
+void RenderQueue::clear() {
+    m_next.store(0, std::memory_order_relaxed);
+    m_sorted.clear();
+    m_isSorted = false;
+}
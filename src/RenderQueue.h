@@ -0,0 +1,81 @@
+#ifndef OMEGA_RENDER_QUEUE_H
+#define OMEGA_RENDER_QUEUE_H
+
+#include "Sprite.h"
+#include "SpriteBatch.h"
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+class Camera;
+class Shader;
+class Texture;
+
+// Sprite draw recorded for later execution
+struct RenderCommand {
+    Texture* texture = nullptr;         // nullptr = untextured
+    Shader* shader = nullptr;           // nullptr = batch default
+    Vector2 position;
+    Vector2 size;
+    Color color;
+    float rotation = 0.0f;              // Degrees
+    Vector2 uv0 = Vector2(0, 0);
+    Vector2 uv1 = Vector2(1, 1);
+    BlendMode blendMode = BlendMode::None;  // None sorts as opaque; any other mode as translucent
+};
+
+// Sort key layout (most significant first):
+//   opaque:      layer:8 | 0:1 | shader:12 | texture:16 | depth:24 | pad:3
+//   translucent: layer:8 | 1:1 | depth:24 (back to front) | shader:12 | texture:16 | pad:3
+// Opaque draws group by state; translucent draws must keep painter's order,
+// so depth ranks above state for them.
+using RenderKey = uint64_t;
+
+// Per-frame queue of sprite draws. submit() is thread-safe; sort/execute/clear
+// must be called from the render thread once submissions are finished.
+class RenderQueue {
+public:
+    RenderQueue(size_t capacity = 65536);
+    ~RenderQueue() = default;
+    
+    // depth in [0, 1]: 0 = front, 1 = back
+    static RenderKey makeKey(uint8_t layer, bool translucent, uint32_t shaderId, uint32_t textureId, float depth);
+    static RenderKey makeKey(const RenderCommand& command, uint8_t layer, float depth);
+    
+    // Builds the key from the command's shader, texture and blend mode
+    void submit(const RenderCommand& command, uint8_t layer = 0, float depth = 0.0f);
+    void submit(RenderKey key, const RenderCommand& command);
+    
+    // Render thread
+    void sort();
+    void execute(SpriteBatch& batch, int screenWidth, int screenHeight, Camera* camera = nullptr);
+    void clear();
+    
+    size_t getCommandCount() const;
+    size_t getCapacity() const { return m_keys.size(); }
+
+private:
+    void radixSort(size_t count);
+    
+    // Lock-free slots for the common case
+    std::vector<RenderKey> m_keys;
+    std::vector<RenderCommand> m_commands;
+    std::atomic<size_t> m_next;
+    
+    // Spill-over once the preallocated slots run out
+    std::mutex m_overflowMutex;
+    std::vector<RenderKey> m_overflowKeys;
+    std::vector<RenderCommand> m_overflowCommands;
+    
+    // Sort scratch: (key, command index) pairs
+    struct SortEntry {
+        RenderKey key;
+        uint32_t index;
+    };
+    std::vector<SortEntry> m_sorted;
+    std::vector<SortEntry> m_scratch;
+    bool m_isSorted;
+};
+
+#endif // OMEGA_RENDER_QUEUE_H
@@ -1,15 +1,33 @@
 #include "Renderer.h"
+#include "SpriteBatch.h"
+#include "RenderQueue.h"
+#include "CommandRecorder.h"
+#include "GLStateCache.h"
+#include "QuadGeometry.h"
+#include "AsyncTextureLoader.h"
 #include <iostream>
 #include <GL/glew.h>
 #include <SDL_opengl.h>
 
-Renderer::Renderer(SDL_Window* window)
+Renderer::Renderer(SDL_Window* window, RenderBackendType backend)
     : m_window(window)
     , m_glContext(nullptr)
-    , m_initialized(false) {
+    , m_backendType(backend)
+    , m_initialized(false)
+    , m_viewportWidth(1280)
+    , m_viewportHeight(720)
+    , m_presentMode(PresentMode::VSync) {
 }
 
 Renderer::~Renderer() {
+    // Workers may still reference scene data; stop them first
+    m_commandRecorder.reset();
+    
+    // GL objects of the loader, the batch and the shared quad must go before the context does
+    AsyncTextureLoader::getInstance().shutdown();
+    m_spriteBatch.reset();
+    QuadGeometry::getInstance().shutdown();
+    
     if (m_glContext) {
         SDL_GL_DeleteContext(m_glContext);
         m_glContext = nullptr;
@@ -17,6 +35,17 @@ Renderer::~Renderer() {
 }
 
 bool Renderer::initialize() {
+    RenderBackend::select(m_backendType);
+    
+    if (isHeadless()) {
+        if (m_window) {
+            SDL_GetWindowSize(m_window, &m_viewportWidth, &m_viewportHeight);
+        }
+        getBackend().setViewport(m_viewportWidth, m_viewportHeight);
+        std::cout << "Renderer running headless (null backend)" << std::endl;
+        return initializeResources();
+    }
+    
     if (!m_window) {
         std::cerr << "Cannot initialize renderer: window is null" << std::endl;
         return false;
@@ -44,29 +73,126 @@ bool Renderer::initialize() {
         return false;
     }
 
-    // Enable VSync
-    if (SDL_GL_SetSwapInterval(1) < 0) {
-        std::cerr << "Warning: Unable to set VSync: " << SDL_GetError() << std::endl;
-    }
+    // Fresh context, nothing is known about its state yet
+    GLStateCache::getInstance().invalidate();
+
+    applyPresentMode();
 
     // Set viewport
     int width, height;
-    SDL_GetWindowSize(m_window, &width, &height);
-    glViewport(0, 0, width, height);
+    getViewportSize(width, height);
+    getBackend().setViewport(width, height);
 
     std::cout << "OpenGL initialized successfully" << std::endl;
     std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
     std::cout << "GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
 
+    return initializeResources();
+}
+
+bool Renderer::initializeResources() {
+    if (!QuadGeometry::getInstance().initialize()) {
+        std::cerr << "Failed to create shared quad geometry" << std::endl;
+        return false;
+    }
+
+    m_renderQueue = std::make_unique<RenderQueue>();
+    m_commandRecorder = std::make_unique<CommandRecorder>();
+    m_spriteBatch = std::make_unique<SpriteBatch>();
+    if (!m_spriteBatch->initialize()) {
+        std::cerr << "Failed to initialize sprite batch" << std::endl;
+        return false;
+    }
+
     m_initialized = true;
     return true;
 }
 
 void Renderer::clear(float r, float g, float b, float a) {
-    glClearColor(r, g, b, a);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    getBackend().clear(r, g, b, a);
 }
 
 void Renderer::present() {
-    SDL_GL_SwapWindow(m_window);
+    // Streamed texture uploads ride along with the frame's other commands
+    AsyncTextureLoader::getInstance().update();
+    
+    if (m_spriteBatch) {
+        m_spriteBatch->endFrame();
+    }
+    m_framePacer.beforePresent();
+    getBackend().present(m_window);
+    m_framePacer.afterPresent();
+}
+
+void Renderer::setPresentMode(PresentMode mode) {
+    m_presentMode = mode;
+    if (m_glContext) {
+        applyPresentMode();
+    }
+}
+
+void Renderer::applyPresentMode() {
+    if (m_presentMode == PresentMode::AdaptiveVSync && SDL_GL_SetSwapInterval(-1) < 0) {
+        std::cerr << "Warning: Adaptive VSync not supported, using VSync: " << SDL_GetError() << std::endl;
+        m_presentMode = PresentMode::VSync;
+    }
+    if (m_presentMode == PresentMode::VSync && SDL_GL_SetSwapInterval(1) < 0) {
+        std::cerr << "Warning: Unable to set VSync: " << SDL_GetError() << std::endl;
+        m_presentMode = PresentMode::Immediate;
+    }
+    if (m_presentMode == PresentMode::Immediate && SDL_GL_SetSwapInterval(0) < 0) {
+        std::cerr << "Warning: Unable to disable VSync: " << SDL_GetError() << std::endl;
+    }
+
+    // The pacer needs the refresh period to aim late input sampling at the next vblank
+    double refreshRate = 0.0;
+    SDL_DisplayMode displayMode;
+    int display = SDL_GetWindowDisplayIndex(m_window);
+    if (display >= 0 && SDL_GetCurrentDisplayMode(display, &displayMode) == 0) {
+        refreshRate = displayMode.refresh_rate;
+    }
+    m_framePacer.setDisplaySync(m_presentMode != PresentMode::Immediate, refreshRate);
+
+    std::cout << "Present mode: " << presentModeName(m_presentMode);
+    if (refreshRate > 0.0) {
+        std::cout << " (" << refreshRate << " Hz)";
+    }
+    std::cout << std::endl;
+}
+
+void Renderer::getViewportSize(int& width, int& height) const {
+    if (m_window && !isHeadless()) {
+        SDL_GetWindowSize(m_window, &width, &height);
+    } else {
+        width = m_viewportWidth;
+        height = m_viewportHeight;
+    }
+}
+
+void Renderer::setViewportSize(int width, int height) {
+    m_viewportWidth = width;
+    m_viewportHeight = height;
+    if (m_initialized) {
+        getBackend().setViewport(width, height);
+    }
+}
+
+void Renderer::flushRenderQueue(Camera* camera) {
+    if (!m_renderQueue || m_renderQueue->getCommandCount() == 0) return;
+    
+    int width, height;
+    getViewportSize(width, height);
+    m_renderQueue->execute(*m_spriteBatch, width, height, camera);
+}
+
+void Renderer::recordAsync(std::function<void(CommandList&)> job) {
+    m_commandRecorder->recordAsync(std::move(job));
+}
+
+void Renderer::executeCommandLists() {
+    if (!m_commandRecorder) return;
+    
+    int width, height;
+    getViewportSize(width, height);
+    m_commandRecorder->execute(*m_renderQueue, *m_spriteBatch, width, height);
 }
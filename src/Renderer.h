@@ -3,10 +3,22 @@
 
 #include <SDL.h>
 #include <string>
+#include <memory>
+#include <functional>
+#include "RenderBackend.h"
+#include "FramePacer.h"
+
+class SpriteBatch;
+class RenderQueue;
+class CommandRecorder;
+class CommandList;
+class Camera;
 
 class Renderer {
 public:
-    Renderer(SDL_Window* window);
+    // RenderBackendType::Null runs headless: no window or GL context is needed
+    // and every call is only recorded (see RenderBackend)
+    Renderer(SDL_Window* window, RenderBackendType backend = RenderBackendType::OpenGL);
     ~Renderer();
 
     bool initialize();
@@ -14,11 +26,52 @@ public:
     void present();
     
     bool isInitialized() const { return m_initialized; }
+    
+    // May be changed at any time; falls back to VSync when the driver has no
+    // adaptive (late swap tearing) support. getPresentMode reports what is in effect
+    void setPresentMode(PresentMode mode);
+    PresentMode getPresentMode() const { return m_presentMode; }
+    
+    // Frame cap, late input sampling and input-to-present latency (see FramePacer)
+    FramePacer& getFramePacer() { return m_framePacer; }
+    
+    RenderBackend& getBackend() { return RenderBackend::get(m_backendType); }
+    bool isHeadless() const { return m_backendType == RenderBackendType::Null; }
+    
+    // Window size, or the size set with setViewportSize when headless
+    void getViewportSize(int& width, int& height) const;
+    void setViewportSize(int width, int height);
+    
+    // Shared batch for sprite, text, tilemap and particle submission
+    SpriteBatch& getSpriteBatch() { return *m_spriteBatch; }
+    
+    // Sorted draw queue; submissions may come from any thread,
+    // flushRenderQueue sorts and draws them on the render thread
+    RenderQueue& getRenderQueue() { return *m_renderQueue; }
+    void flushRenderQueue(Camera* camera = nullptr);
+    
+    // Parallel recording: jobs run on the renderer's worker threads and fill
+    // API-agnostic command lists; executeCommandLists draws them on this thread
+    void recordAsync(std::function<void(CommandList&)> job);
+    void executeCommandLists();
+    CommandRecorder& getCommandRecorder() { return *m_commandRecorder; }
 
 private:
+    // Backend-independent objects: shared quad, queue, recorder, batch
+    bool initializeResources();
+    void applyPresentMode();
+    
     SDL_Window* m_window;
     SDL_GLContext m_glContext;
+    RenderBackendType m_backendType;
     bool m_initialized;
+    int m_viewportWidth;
+    int m_viewportHeight;
+    PresentMode m_presentMode;
+    FramePacer m_framePacer;
+    std::unique_ptr<SpriteBatch> m_spriteBatch;
+    std::unique_ptr<RenderQueue> m_renderQueue;
+    std::unique_ptr<CommandRecorder> m_commandRecorder;
 };
 
 #endif // OMEGA_RENDERER_H
@@ -96,6 +96,11 @@ void SceneManager::render(Renderer& renderer) {
     Scene* current = getCurrentScene();
     if (current && current->isActive()) {
         current->render(renderer);
+        
+        // Draw the command lists the scene recorded, then anything it queued
+        // but didn't flush itself (screen space)
+        renderer.executeCommandLists();
+        renderer.flushRenderQueue();
     }
 }
 
@@ -1,7 +1,8 @@
 #include "Shader.h"
+#include "GLStateCache.h"
+#include "RenderBackend.h"
+#include "ShaderCache.h"
 #include <iostream>
-#include <vector>
-#include <GL/glew.h>
 
 Shader::Shader()
     : m_programID(0) {
@@ -9,87 +10,91 @@ Shader::Shader()
 
 Shader::~Shader() {
     if (m_programID != 0) {
-        glDeleteProgram(m_programID);
+        GLStateCache::getInstance().onProgramDeleted(m_programID);
+        RenderBackend::getActive().deleteProgram(m_programID);
         m_programID = 0;
     }
 }
 
-GLuint Shader::compileShader(GLenum type, const std::string& source) {
-    GLuint shader = glCreateShader(type);
-    const char* sourceCStr = source.c_str();
-    glShaderSource(shader, 1, &sourceCStr, nullptr);
-    glCompileShader(shader);
-
-    // Check compilation status
-    GLint success = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        GLint logLength = 0;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
-        std::vector<char> errorLog(logLength);
-        glGetShaderInfoLog(shader, logLength, &logLength, errorLog.data());
-        std::cerr << "Shader compilation failed: " << errorLog.data() << std::endl;
-        glDeleteShader(shader);
-        return 0;
-    }
+void Shader::reflectUniforms() {
+    m_uniformLocations.clear();
+    RenderBackend::getActive().getUniformLocations(m_programID, m_uniformLocations);
+}
 
-    return shader;
+GLint Shader::getUniformLocation(const std::string& name) const {
+    auto it = m_uniformLocations.find(name);
+    return it != m_uniformLocations.end() ? it->second : -1;
 }
 
-bool Shader::linkProgram(GLuint vertexShader, GLuint fragmentShader) {
-    m_programID = glCreateProgram();
-    glAttachShader(m_programID, vertexShader);
-    glAttachShader(m_programID, fragmentShader);
-    glLinkProgram(m_programID);
+std::string Shader::expandDefines(const std::string& source, const ShaderDefines& defines) {
+    if (defines.empty()) return source;
 
-    // Check linking status
-    GLint success = 0;
-    glGetProgramiv(m_programID, GL_LINK_STATUS, &success);
-    if (!success) {
-        GLint logLength = 0;
-        glGetProgramiv(m_programID, GL_INFO_LOG_LENGTH, &logLength);
-        std::vector<char> errorLog(logLength);
-        glGetProgramInfoLog(m_programID, logLength, &logLength, errorLog.data());
-        std::cerr << "Shader linking failed: " << errorLog.data() << std::endl;
-        glDeleteProgram(m_programID);
-        m_programID = 0;
-        return false;
+    std::string block;
+    for (const auto& define : defines) {
+        block += "#define " + define.first;
+        if (!define.second.empty()) block += " " + define.second;
+        block += "\n";
     }
 
-    return true;
+    // After the #version line when there is one; nothing but whitespace and comments may precede it
+    size_t version = source.find("#version");
+    if (version == std::string::npos) {
+        return block + source;
+    }
+    size_t lineEnd = source.find('\n', version);
+    if (lineEnd == std::string::npos) {
+        return source + "\n" + block;
+    }
+    std::string expanded = source;
+    expanded.insert(lineEnd + 1, block);
+    return expanded;
 }
 
-bool Shader::loadFromSource(const std::string& vertexSource, const std::string& fragmentSource) {
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
-    if (vertexShader == 0) {
+bool Shader::loadFromSource(const std::string& vertexSource, const std::string& fragmentSource,
+                            const ShaderDefines& defines) {
+    m_programID = ShaderCache::getInstance().createProgram(expandDefines(vertexSource, defines),
+                                                           expandDefines(fragmentSource, defines));
+    if (m_programID == 0) {
         return false;
     }
 
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
-    if (fragmentShader == 0) {
-        glDeleteShader(vertexShader);
-        return false;
-    }
+    m_vertexSource = vertexSource;
+    m_fragmentSource = fragmentSource;
+    m_defines = defines;
 
-    bool linkSuccess = linkProgram(vertexShader, fragmentShader);
+    reflectUniforms();
+    std::cout << "Shader program created successfully (ID: " << m_programID << ")" << std::endl;
+    return true;
+}
 
-    // Clean up shaders (they're now in the program)
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+Shader* Shader::getVariant(const ShaderDefines& defines) {
+    ShaderDefines merged = defines;
+    merged.insert(m_defines.begin(), m_defines.end()); // Keeps the requested value on conflicts
+    if (merged == m_defines) {
+        return this;
+    }
 
-    if (linkSuccess) {
-        std::cout << "Shader program created successfully (ID: " << m_programID << ")" << std::endl;
+    auto it = m_variants.find(merged);
+    if (it != m_variants.end()) {
+        return it->second.get();
     }
 
-    return linkSuccess;
+    // A failed variant is remembered as null so it is not recompiled on every request
+    auto variant = std::make_unique<Shader>();
+    if (!variant->loadFromSource(m_vertexSource, m_fragmentSource, merged)) {
+        variant.reset();
+    }
+    Shader* result = variant.get();
+    m_variants[merged] = std::move(variant);
+    return result;
 }
 
 void Shader::use() {
     if (m_programID != 0) {
-        glUseProgram(m_programID);
+        GLStateCache::getInstance().useProgram(m_programID);
     }
 }
 
 void Shader::unuse() {
-    glUseProgram(0);
+    GLStateCache::getInstance().useProgram(0);
 }
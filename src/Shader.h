@@ -2,25 +2,54 @@
 #define OMEGA_SHADER_H
 
 #include <string>
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include <GL/glew.h>
 
+// Preprocessor defines selecting a shader variant, NAME -> value ("" for a bare #define).
+// Ordered, so equal sets always produce the same source and the same cache entry
+using ShaderDefines = std::map<std::string, std::string>;
+
 class Shader {
 public:
     Shader();
     ~Shader();
 
-    bool loadFromSource(const std::string& vertexSource, const std::string& fragmentSource);
+    // Programs come from ShaderCache: a cached binary when the driver accepts it, else compiled
+    bool loadFromSource(const std::string& vertexSource, const std::string& fragmentSource,
+                        const ShaderDefines& defines = ShaderDefines());
+    
+    // Same sources with these defines added to (or overriding) this shader's own.
+    // Built on first request and owned by this shader; nullptr if it fails to compile
+    Shader* getVariant(const ShaderDefines& defines);
+    const ShaderDefines& getDefines() const { return m_defines; }
+    size_t getVariantCount() const { return m_variants.size(); }
+    
+    // Inserts the #define lines after #version (which must stay first)
+    static std::string expandDefines(const std::string& source, const ShaderDefines& defines);
     void use();
     void unuse();
     
     GLuint getProgramID() const { return m_programID; }
     bool isValid() const { return m_programID != 0; }
+    
+    // Uniform locations reflected at link time (no GL round trip, -1 if absent)
+    GLint getUniformLocation(const std::string& name) const;
+    bool hasUniform(const std::string& name) const { return getUniformLocation(name) != -1; }
+    size_t getUniformCount() const { return m_uniformLocations.size(); }
 
 private:
-    GLuint compileShader(GLenum type, const std::string& source);
-    bool linkProgram(GLuint vertexShader, GLuint fragmentShader);
+    void reflectUniforms();
     
     GLuint m_programID;
+    std::unordered_map<std::string, GLint> m_uniformLocations;
+    
+    // Unexpanded sources, kept for building variants
+    std::string m_vertexSource;
+    std::string m_fragmentSource;
+    ShaderDefines m_defines;
+    std::map<ShaderDefines, std::unique_ptr<Shader>> m_variants;
 };
 
 #endif // OMEGA_SHADER_H
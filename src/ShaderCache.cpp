@@ -0,0 +1,167 @@
+#include "ShaderCache.h"
+#include "RenderBackend.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <cstdio>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const uint32_t ENTRY_MAGIC = 0x4348534F; // "OSHC"
+const uint32_t ENTRY_VERSION = 1;
+
+// Every field is checked on load; a collision or a stale entry reads as a miss
+struct EntryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t vertexHash;
+    uint64_t fragmentHash;
+    uint64_t driverHash;
+    uint32_t binaryFormat;
+    uint32_t binarySize;
+};
+
+} // namespace
+
+ShaderCache& ShaderCache::getInstance() {
+    static ShaderCache instance;
+    return instance;
+}
+
+ShaderCache::ShaderCache()
+    : m_directory("shader_cache")
+    , m_enabled(true) {
+}
+
+uint64_t ShaderCache::hash(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t value = seed;
+    for (size_t i = 0; i < size; i++) {
+        value ^= bytes[i];
+        value *= 1099511628211ULL;
+    }
+    return value;
+}
+
+std::string ShaderCache::entryPath(const Key& key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key.combined));
+    return (fs::path(m_directory) / name).string();
+}
+
+GLuint ShaderCache::loadEntry(const Key& key, bool& rejected) {
+    rejected = false;
+
+    std::ifstream file(entryPath(key), std::ios::binary);
+    if (!file) return 0;
+
+    EntryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != ENTRY_MAGIC || header.version != ENTRY_VERSION ||
+        header.vertexHash != key.vertex || header.fragmentHash != key.fragment ||
+        header.driverHash != key.driver || header.binarySize == 0) {
+        return 0;
+    }
+
+    std::vector<unsigned char> binary(header.binarySize);
+    if (!file.read(reinterpret_cast<char*>(binary.data()), binary.size())) {
+        return 0; // Truncated write
+    }
+
+    GLuint program = RenderBackend::getActive().createProgramFromBinary(header.binaryFormat, binary.data(), binary.size());
+    rejected = program == 0;
+    return program;
+}
+
+void ShaderCache::writeEntry(const Key& key, GLuint program) {
+    EntryHeader header;
+    header.magic = ENTRY_MAGIC;
+    header.version = ENTRY_VERSION;
+    header.vertexHash = key.vertex;
+    header.fragmentHash = key.fragment;
+    header.driverHash = key.driver;
+
+    GLenum format = 0;
+    std::vector<unsigned char> binary;
+    if (!RenderBackend::getActive().getProgramBinary(program, format, binary) || binary.empty()) {
+        return;
+    }
+    header.binaryFormat = format;
+    header.binarySize = static_cast<uint32_t>(binary.size());
+
+    std::error_code error;
+    fs::create_directories(m_directory, error);
+    if (error) {
+        std::cerr << "ShaderCache: Cannot create " << m_directory << ": " << error.message() << std::endl;
+        return;
+    }
+
+    // Written aside and renamed, so a crash never leaves a half entry under the real name
+    std::string path = entryPath(key);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+        if (!file) {
+            std::cerr << "ShaderCache: Failed to write " << temporary << std::endl;
+            return;
+        }
+    }
+
+    fs::rename(temporary, path, error);
+    if (error) {
+        fs::remove(temporary, error);
+        return;
+    }
+    m_stats.written++;
+}
+
+GLuint ShaderCache::createProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+    RenderBackend& backend = RenderBackend::getActive();
+    if (!m_enabled || m_directory.empty() || !backend.supportsProgramBinaries()) {
+        m_stats.misses++;
+        return backend.createProgram(vertexSource, fragmentSource);
+    }
+
+    Key key;
+    std::string driver = backend.getDriverIdentifier();
+    key.vertex = hash(vertexSource.data(), vertexSource.size());
+    key.fragment = hash(fragmentSource.data(), fragmentSource.size());
+    key.driver = hash(driver.data(), driver.size());
+    key.combined = hash(&key.fragment, sizeof(key.fragment), hash(&key.driver, sizeof(key.driver), key.vertex));
+
+    bool rejected = false;
+    GLuint program = loadEntry(key, rejected);
+    if (program != 0) {
+        m_stats.hits++;
+        return program;
+    }
+
+    if (rejected) {
+        std::cout << "ShaderCache: Driver rejected cached binary, recompiling" << std::endl;
+        m_stats.rejected++;
+    } else {
+        m_stats.misses++;
+    }
+
+    program = backend.createProgram(vertexSource, fragmentSource);
+    if (program != 0) {
+        writeEntry(key, program);
+    }
+    return program;
+}
+
+void ShaderCache::clear() {
+    std::error_code error;
+    if (m_directory.empty() || !fs::is_directory(m_directory, error)) return;
+
+    for (const fs::directory_entry& entry : fs::directory_iterator(m_directory, error)) {
+        if (entry.path().extension() == ".bin" || entry.path().extension() == ".tmp") {
+            fs::remove(entry.path(), error);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef OMEGA_SHADER_CACHE_H
+#define OMEGA_SHADER_CACHE_H
+
+#include <GL/glew.h>
+#include <string>
+#include <cstdint>
+
+struct ShaderCacheStats {
+    int hits = 0;       // Programs created from a cached binary
+    int misses = 0;     // Compiled from source (no entry, or cache unavailable)
+    int rejected = 0;   // Entries the driver refused; recompiled and replaced
+    int written = 0;
+};
+
+// Disk cache of linked program binaries (glGetProgramBinary), so later
+// launches skip GLSL compilation. Entries are keyed by a hash of the final
+// vertex and fragment source, which includes the variant's #defines (see
+// Shader::expandDefines), and of the backend's driver identifier: a driver
+// update or a different GPU simply misses. Binaries the driver rejects anyway
+// are deleted and rebuilt from source.
+class ShaderCache {
+public:
+    static ShaderCache& getInstance();
+
+    // Created on first write; "" disables writing and reading
+    void setDirectory(const std::string& directory) { m_directory = directory; }
+    const std::string& getDirectory() const { return m_directory; }
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // Same contract as RenderBackend::createProgram: 0 on failure, errors go to std::cerr
+    GLuint createProgram(const std::string& vertexSource, const std::string& fragmentSource);
+
+    // Removes every entry from the directory
+    void clear();
+
+    const ShaderCacheStats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = ShaderCacheStats(); }
+
+    // 64-bit FNV-1a
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = 14695981039346656037ULL);
+
+private:
+    struct Key {
+        uint64_t vertex;
+        uint64_t fragment;
+        uint64_t driver;
+        uint64_t combined;
+    };
+
+    ShaderCache();
+    ~ShaderCache() = default;
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    std::string entryPath(const Key& key) const;
+    GLuint loadEntry(const Key& key, bool& rejected);
+    void writeEntry(const Key& key, GLuint program);
+
+    std::string m_directory;
+    bool m_enabled;
+    ShaderCacheStats m_stats;
+};
+
+#endif // OMEGA_SHADER_CACHE_H
@@ -1,5 +1,9 @@
 #include "Sprite.h"
 #include "Camera.h"
+#include "SpriteBatch.h"
+#include "GLStateCache.h"
+#include "QuadGeometry.h"
+#include "RenderBackend.h"
 #include <iostream>
 #include <GL/glew.h>
 
@@ -7,70 +11,50 @@ Sprite::Sprite()
     : m_texture(nullptr)
     , m_position(0, 0)
     , m_size(100, 100)
+    , m_sizeFromTexture(false)
     , m_color(1, 1, 1, 1)
-    , m_vao(0)
-    , m_vbo(0)
-    , m_ebo(0)
-    , m_buffersInitialized(false) {
-}
-
-Sprite::~Sprite() {
-    if (m_buffersInitialized) {
-        glDeleteVertexArrays(1, &m_vao);
-        glDeleteBuffers(1, &m_vbo);
-        glDeleteBuffers(1, &m_ebo);
-    }
+    , m_rotation(0.0f)
+    , m_uv0(0, 0)
+    , m_uv1(1, 1) {
 }
 
 void Sprite::setTexture(Texture* texture) {
     m_texture = texture;
+    m_uv0 = Vector2(0, 0);
+    m_uv1 = Vector2(1, 1);
+    m_sizeFromTexture = false;
     if (texture && texture->isValid()) {
-        // Auto-size to texture dimensions if not manually set
+        // Auto-size to texture dimensions if not manually set. A texture still
+        // loading reports 0x0, so its size is picked up once it is resident
         if (m_size.x == 100 && m_size.y == 100) {
-            m_size.x = static_cast<float>(texture->getWidth());
-            m_size.y = static_cast<float>(texture->getHeight());
+            if (texture->isResident()) {
+                m_size.x = static_cast<float>(texture->getWidth());
+                m_size.y = static_cast<float>(texture->getHeight());
+            } else {
+                m_sizeFromTexture = true;
+            }
         }
     }
 }
 
-void Sprite::setupBuffers() {
-    // Vertex data: position (2) + texCoord (2)
-    float vertices[] = {
-        // positions   // texCoords
-        0.0f, 1.0f,    0.0f, 1.0f,  // top-left
-        1.0f, 1.0f,    1.0f, 1.0f,  // top-right
-        1.0f, 0.0f,    1.0f, 0.0f,  // bottom-right
-        0.0f, 0.0f,    0.0f, 0.0f   // bottom-left
-    };
-
-    unsigned int indices[] = {
-        0, 1, 2,
-        2, 3, 0
-    };
-
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
-    glGenBuffers(1, &m_ebo);
-
-    glBindVertexArray(m_vao);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // Position attribute
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // TexCoord attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
+Vector2 Sprite::getSize() const {
+    if (m_sizeFromTexture && m_texture && m_texture->isResident()) {
+        return Vector2(static_cast<float>(m_texture->getWidth()), static_cast<float>(m_texture->getHeight()));
+    }
+    return m_size;
+}
 
-    m_buffersInitialized = true;
+void Sprite::setRegion(const TextureRegion& region) {
+    m_texture = region.texture;
+    m_sizeFromTexture = false;
+    m_uv0 = region.uv0;
+    m_uv1 = region.uv1;
+    
+    // Auto-size to region dimensions if not manually set
+    if (m_size.x == 100 && m_size.y == 100 && region.width > 0 && region.height > 0) {
+        m_size.x = static_cast<float>(region.width);
+        m_size.y = static_cast<float>(region.height);
+    }
 }
 
 void Sprite::draw(Shader* shader, int screenWidth, int screenHeight) {
@@ -78,46 +62,45 @@ void Sprite::draw(Shader* shader, int screenWidth, int screenHeight) {
         return;
     }
 
-    if (!m_buffersInitialized) {
-        setupBuffers();
-    }
-
     shader->use();
 
     // Convert pixel coordinates to normalized device coordinates
     float ndcX = (m_position.x / screenWidth) * 2.0f - 1.0f;
     float ndcY = 1.0f - (m_position.y / screenHeight) * 2.0f;
-    float ndcW = (m_size.x / screenWidth) * 2.0f;
-    float ndcH = (m_size.y / screenHeight) * 2.0f;
+    Vector2 size = getSize();
+    float ndcW = (size.x / screenWidth) * 2.0f;
+    float ndcH = (size.y / screenHeight) * 2.0f;
 
     // Set uniforms
-    GLint posLoc = glGetUniformLocation(shader->getProgramID(), "position");
-    GLint sizeLoc = glGetUniformLocation(shader->getProgramID(), "size");
-    GLint colorLoc = glGetUniformLocation(shader->getProgramID(), "spriteColor");
+    GLint posLoc = shader->getUniformLocation("position");
+    GLint sizeLoc = shader->getUniformLocation("size");
+    GLint colorLoc = shader->getUniformLocation("spriteColor");
+    GLint uvLoc = shader->getUniformLocation("uvRect");
     
-    if (posLoc != -1) glUniform2f(posLoc, ndcX, ndcY);
-    if (sizeLoc != -1) glUniform2f(sizeLoc, ndcW, ndcH);
-    if (colorLoc != -1) glUniform4f(colorLoc, m_color.r, m_color.g, m_color.b, m_color.a);
+    bool premultiplied = m_texture && m_texture->isPremultiplied();
+    RenderBackend& backend = RenderBackend::getActive();
+    if (posLoc != -1) backend.setUniform(posLoc, ndcX, ndcY);
+    if (sizeLoc != -1) backend.setUniform(sizeLoc, ndcW, ndcH);
+    if (colorLoc != -1) {
+        float tint = premultiplied ? m_color.a : 1.0f;
+        backend.setUniform(colorLoc, m_color.r * tint, m_color.g * tint, m_color.b * tint, m_color.a);
+    }
+    if (uvLoc != -1) backend.setUniform(uvLoc, m_uv0.x, m_uv0.y, m_uv1.x, m_uv1.y);
 
     // Bind texture
     if (m_texture && m_texture->isValid()) {
         m_texture->bind(0);
-        GLint texLoc = glGetUniformLocation(shader->getProgramID(), "image");
-        if (texLoc != -1) glUniform1i(texLoc, 0);
+        GLint texLoc = shader->getUniformLocation("image");
+        if (texLoc != -1) backend.setUniform(texLoc, 0);
     }
 
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Draw
-    glBindVertexArray(m_vao);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    // Enable blending for transparency (left enabled; the state cache elides repeats)
+    GLStateCache& state = GLStateCache::getInstance();
+    state.setBlendEnabled(true);
+    state.setBlendFunc(premultiplied ? GL_ONE : GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glDisable(GL_BLEND);
-
-    shader->unuse();
+    // Draw with the shared unit quad
+    QuadGeometry::getInstance().draw();
 }
 
 void Sprite::drawWithCamera(Shader* shader, Camera* camera, int screenWidth, int screenHeight) {
@@ -125,10 +108,6 @@ void Sprite::drawWithCamera(Shader* shader, Camera* camera, int screenWidth, int
         return;
     }
 
-    if (!m_buffersInitialized) {
-        setupBuffers();
-    }
-
     shader->use();
 
     // Get camera view offset and zoom
@@ -141,9 +120,10 @@ void Sprite::drawWithCamera(Shader* shader, Camera* camera, int screenWidth, int
     cameraPos.y = (m_position.y - viewOffset.y) * zoom;
     
     // Apply camera zoom to sprite size
+    Vector2 size = getSize();
     Vector2 cameraSize;
-    cameraSize.x = m_size.x * zoom;
-    cameraSize.y = m_size.y * zoom;
+    cameraSize.x = size.x * zoom;
+    cameraSize.y = size.y * zoom;
 
     // Convert to NDC
     float ndcX = (cameraPos.x / screenWidth) * 2.0f - 1.0f;
@@ -152,31 +132,37 @@ void Sprite::drawWithCamera(Shader* shader, Camera* camera, int screenWidth, int
     float ndcH = (cameraSize.y / screenHeight) * 2.0f;
 
     // Set uniforms
-    GLint posLoc = glGetUniformLocation(shader->getProgramID(), "position");
-    GLint sizeLoc = glGetUniformLocation(shader->getProgramID(), "size");
-    GLint colorLoc = glGetUniformLocation(shader->getProgramID(), "spriteColor");
+    GLint posLoc = shader->getUniformLocation("position");
+    GLint sizeLoc = shader->getUniformLocation("size");
+    GLint colorLoc = shader->getUniformLocation("spriteColor");
+    GLint uvLoc = shader->getUniformLocation("uvRect");
     
-    if (posLoc != -1) glUniform2f(posLoc, ndcX, ndcY);
-    if (sizeLoc != -1) glUniform2f(sizeLoc, ndcW, ndcH);
-    if (colorLoc != -1) glUniform4f(colorLoc, m_color.r, m_color.g, m_color.b, m_color.a);
+    bool premultiplied = m_texture && m_texture->isPremultiplied();
+    RenderBackend& backend = RenderBackend::getActive();
+    if (posLoc != -1) backend.setUniform(posLoc, ndcX, ndcY);
+    if (sizeLoc != -1) backend.setUniform(sizeLoc, ndcW, ndcH);
+    if (colorLoc != -1) {
+        float tint = premultiplied ? m_color.a : 1.0f;
+        backend.setUniform(colorLoc, m_color.r * tint, m_color.g * tint, m_color.b * tint, m_color.a);
+    }
+    if (uvLoc != -1) backend.setUniform(uvLoc, m_uv0.x, m_uv0.y, m_uv1.x, m_uv1.y);
 
     // Bind texture
     if (m_texture && m_texture->isValid()) {
         m_texture->bind(0);
-        GLint texLoc = glGetUniformLocation(shader->getProgramID(), "image");
-        if (texLoc != -1) glUniform1i(texLoc, 0);
+        GLint texLoc = shader->getUniformLocation("image");
+        if (texLoc != -1) backend.setUniform(texLoc, 0);
     }
 
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Draw
-    glBindVertexArray(m_vao);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    // Enable blending for transparency (left enabled; the state cache elides repeats)
+    GLStateCache& state = GLStateCache::getInstance();
+    state.setBlendEnabled(true);
+    state.setBlendFunc(premultiplied ? GL_ONE : GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glDisable(GL_BLEND);
+    // Draw with the shared unit quad
+    QuadGeometry::getInstance().draw();
+}
 
-    shader->unuse();
+void Sprite::draw(SpriteBatch& batch) const {
+    batch.draw(*this);
 }
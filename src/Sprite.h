@@ -16,34 +16,54 @@ struct Color {
         : r(_r), g(_g), b(_b), a(_a) {}
 };
 
+// Sub-rectangle of a texture, e.g. an image packed into an atlas page
+struct TextureRegion {
+    Texture* texture = nullptr;
+    Vector2 uv0 = Vector2(0, 0);    // Top-left
+    Vector2 uv1 = Vector2(1, 1);    // Bottom-right
+    int x = 0, y = 0;               // Pixel rect inside the texture
+    int width = 0, height = 0;
+    
+    bool isValid() const { return texture != nullptr; }
+};
+
+class SpriteBatch;
+
+// Plain value type: sprites own no GL objects and draw with the shared QuadGeometry,
+// so constructing or copying one on a hot path is free.
 class Sprite {
 public:
     Sprite();
-    ~Sprite();
 
     void setTexture(Texture* texture);
     void setPosition(const Vector2& pos) { m_position = pos; }
-    void setSize(const Vector2& size) { m_size = size; }
+    void setSize(const Vector2& size) { m_size = size; m_sizeFromTexture = false; }
     void setColor(const Color& color) { m_color = color; }
+    void setRotation(float degrees) { m_rotation = degrees; } // Around the top-left corner
+    void setTextureRect(const Vector2& uv0, const Vector2& uv1) { m_uv0 = uv0; m_uv1 = uv1; }
+    void setRegion(const TextureRegion& region); // Texture + UVs, auto-sized like setTexture
     
     Vector2 getPosition() const { return m_position; }
-    Vector2 getSize() const { return m_size; }
+    Vector2 getSize() const;
+    Color getColor() const { return m_color; }
+    float getRotation() const { return m_rotation; }
+    Texture* getTexture() const { return m_texture; }
+    Vector2 getUV0() const { return m_uv0; }
+    Vector2 getUV1() const { return m_uv1; }
     
     void draw(Shader* shader, int screenWidth, int screenHeight);
     void drawWithCamera(Shader* shader, class Camera* camera, int screenWidth, int screenHeight);
+    void draw(SpriteBatch& batch) const;
 
 private:
-    void setupBuffers();
-    
     Texture* m_texture;
     Vector2 m_position;
     Vector2 m_size;
+    bool m_sizeFromTexture;     // Auto-size waiting for an async texture to become resident
     Color m_color;
-    
-    GLuint m_vao;
-    GLuint m_vbo;
-    GLuint m_ebo;
-    bool m_buffersInitialized;
+    float m_rotation;
+    Vector2 m_uv0;
+    Vector2 m_uv1;
 };
 
 #endif // OMEGA_SPRITE_H
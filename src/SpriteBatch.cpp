@@ -0,0 +1,526 @@
+#include "SpriteBatch.h"
+#include "Camera.h"
+#include "GLStateCache.h"
+#include "QuadGeometry.h"
+#include "RenderBackend.h"
+#include "StreamBuffer.h"
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+const char* BATCH_VERTEX_SHADER = R"(
+    #version 330 core
+    layout(location = 0) in vec2 aPos;
+    layout(location = 1) in vec2 aTexCoord;
+    layout(location = 2) in vec4 aColor;
+    
+    uniform mat4 projection;
+    
+    out vec2 TexCoord;
+    out vec4 Color;
+    
+    void main() {
+        gl_Position = projection * vec4(aPos, 0.0, 1.0);
+        TexCoord = aTexCoord;
+        Color = aColor;
+    }
+)";
+
+const char* BATCH_FRAGMENT_SHADER = R"(
+    #version 330 core
+    in vec2 TexCoord;
+    in vec4 Color;
+    out vec4 FragColor;
+    
+    uniform sampler2D image;
+    
+    void main() {
+        FragColor = texture(image, TexCoord) * Color;
+    }
+)";
+
+// Instanced layout: 0 = unit quad corner, 3 = rect (x, y, w, h), 4 = uv rect,
+// 5 = rotation, 6 = color
+const char* INSTANCED_VERTEX_SHADER = R"(
+    #version 330 core
+    layout(location = 0) in vec2 aCorner;
+    layout(location = 3) in vec4 aRect;
+    layout(location = 4) in vec4 aUVRect;
+    layout(location = 5) in float aRotation;
+    layout(location = 6) in vec4 aColor;
+    
+    uniform mat4 projection;
+    
+    out vec2 TexCoord;
+    out vec4 Color;
+    
+    void main() {
+        vec2 local = aCorner * aRect.zw;
+        float c = cos(aRotation);
+        float s = sin(aRotation);
+        vec2 pos = aRect.xy + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+        gl_Position = projection * vec4(pos, 0.0, 1.0);
+        TexCoord = mix(aUVRect.xy, aUVRect.zw, aCorner);
+        Color = aColor;
+    }
+)";
+
+uint16_t toUnorm16(float value) {
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return static_cast<uint16_t>(value * 65535.0f + 0.5f);
+}
+
+} // namespace
+
+SpriteBatch::SpriteBatch(int maxSprites)
+    : m_maxSprites(maxSprites)
+    , m_initialized(false)
+    , m_drawing(false)
+    , m_vao(0)
+    , m_ebo(0)
+    , m_instanceVao(0)
+    , m_currentTexture(nullptr)
+    , m_currentShader(nullptr)
+    , m_customShader(nullptr)
+    , m_blendMode(BlendMode::Alpha)
+    , m_mode(SpriteBatchMode::Vertices)
+    , m_drawCalls(0)
+    , m_spriteCount(0)
+    , m_uploadedBytes(0) {
+    
+    for (int i = 0; i < 16; i++) {
+        m_projection[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+}
+
+SpriteBatch::~SpriteBatch() {
+    if (m_initialized) {
+        GLStateCache& state = GLStateCache::getInstance();
+        state.onVertexArrayDeleted(m_vao);
+        state.onVertexArrayDeleted(m_instanceVao);
+        RenderBackend& backend = RenderBackend::getActive();
+        backend.deleteVertexArray(m_vao);
+        backend.deleteBuffer(m_ebo);
+        backend.deleteVertexArray(m_instanceVao);
+    }
+}
+
+bool SpriteBatch::initialize() {
+    if (m_initialized) return true;
+    
+    m_defaultShader = std::make_unique<Shader>();
+    if (!m_defaultShader->loadFromSource(BATCH_VERTEX_SHADER, BATCH_FRAGMENT_SHADER)) {
+        std::cerr << "SpriteBatch: Failed to compile batch shader" << std::endl;
+        return false;
+    }
+    
+    m_instancedShader = std::make_unique<Shader>();
+    if (!m_instancedShader->loadFromSource(INSTANCED_VERTEX_SHADER, BATCH_FRAGMENT_SHADER)) {
+        std::cerr << "SpriteBatch: Failed to compile instanced shader" << std::endl;
+        return false;
+    }
+    
+    // 1x1 white texture for untextured sprites
+    unsigned char white[4] = { 255, 255, 255, 255 };
+    m_whiteTexture = std::make_unique<Texture>();
+    m_whiteTexture->createFromData(white, 1, 1, 4);
+    
+    // Static index pattern, 4 vertices / 6 indices per quad
+    std::vector<unsigned int> indices(m_maxSprites * 6);
+    for (int i = 0; i < m_maxSprites; i++) {
+        unsigned int base = i * 4;
+        indices[i * 6 + 0] = base + 0;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base + 2;
+        indices[i * 6 + 4] = base + 3;
+        indices[i * 6 + 5] = base + 0;
+    }
+    
+    // Dynamic data streams through fenced rings, two full batches per segment
+    m_vertexStream = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, m_maxSprites * 4 * sizeof(SpriteVertex) * 2);
+    m_instanceStream = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, m_maxSprites * sizeof(SpriteInstance) * 2);
+    if (!m_vertexStream->initialize() || !m_instanceStream->initialize()) {
+        std::cerr << "SpriteBatch: Failed to create stream buffers" << std::endl;
+        return false;
+    }
+    
+    RenderBackend& backend = RenderBackend::getActive();
+    m_vao = backend.createVertexArray();
+    m_ebo = backend.createBuffer();
+    
+    GLStateCache& state = GLStateCache::getInstance();
+    state.bindVertexArray(m_vao);
+    
+    // Offsets are applied per draw as a base vertex
+    backend.bindBuffer(GL_ARRAY_BUFFER, m_vertexStream->getBuffer());
+    
+    backend.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    backend.bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    
+    setVertexAttributes();
+    
+    state.bindVertexArray(0);
+    
+    // Instanced path: corners come from the shared unit quad, in [0, 1]
+    QuadGeometry& quad = QuadGeometry::getInstance();
+    if (!quad.initialize()) {
+        std::cerr << "SpriteBatch: Failed to create quad geometry" << std::endl;
+        return false;
+    }
+    
+    m_instanceVao = backend.createVertexArray();
+    
+    state.bindVertexArray(m_instanceVao);
+    
+    backend.bindBuffer(GL_ARRAY_BUFFER, quad.getVertexBuffer());
+    backend.vertexAttribute(0, 2, GL_FLOAT, false, QuadGeometry::VERTEX_STRIDE, 0);
+    
+    backend.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad.getIndexBuffer());
+    setInstanceAttributes(0);
+    
+    state.bindVertexArray(0);
+    
+    m_vertices.reserve(m_maxSprites * 4);
+    m_instances.reserve(m_maxSprites);
+    m_initialized = true;
+    return true;
+}
+
+void SpriteBatch::setVertexAttributes() {
+    // Expects the VAO and the source array buffer to be bound
+    RenderBackend& backend = RenderBackend::getActive();
+    
+    // Position attribute
+    backend.vertexAttribute(0, 2, GL_FLOAT, false, sizeof(SpriteVertex), offsetof(SpriteVertex, x));
+    
+    // TexCoord attribute
+    backend.vertexAttribute(1, 2, GL_FLOAT, false, sizeof(SpriteVertex), offsetof(SpriteVertex, u));
+    
+    // Color attribute (normalized bytes)
+    backend.vertexAttribute(2, 4, GL_UNSIGNED_BYTE, true, sizeof(SpriteVertex), offsetof(SpriteVertex, color));
+}
+
+void SpriteBatch::setInstanceAttributes(size_t baseOffset) {
+    // Expects m_instanceVao to be bound. There is no base instance in GL 3.3,
+    // so the ring offset goes into the attribute pointers instead.
+    RenderBackend& backend = RenderBackend::getActive();
+    backend.bindBuffer(GL_ARRAY_BUFFER, m_instanceStream->getBuffer());
+    
+    // Rect attribute
+    backend.vertexAttribute(3, 4, GL_FLOAT, false, sizeof(SpriteInstance),
+                            baseOffset + offsetof(SpriteInstance, x), 1);
+    
+    // UV rect attribute (normalized shorts)
+    backend.vertexAttribute(4, 4, GL_UNSIGNED_SHORT, true, sizeof(SpriteInstance),
+                            baseOffset + offsetof(SpriteInstance, uv), 1);
+    
+    // Rotation attribute
+    backend.vertexAttribute(5, 1, GL_FLOAT, false, sizeof(SpriteInstance),
+                            baseOffset + offsetof(SpriteInstance, rotation), 1);
+    
+    // Color attribute (normalized bytes)
+    backend.vertexAttribute(6, 4, GL_UNSIGNED_BYTE, true, sizeof(SpriteInstance),
+                            baseOffset + offsetof(SpriteInstance, color), 1);
+}
+
+void SpriteBatch::endFrame() {
+    if (!m_initialized) return;
+    
+    m_vertexStream->endFrame();
+    m_instanceStream->endFrame();
+}
+
+uint32_t SpriteBatch::packColor(const Color& color) {
+    auto toByte = [](float c) {
+        c = c < 0.0f ? 0.0f : (c > 1.0f ? 1.0f : c);
+        return static_cast<uint32_t>(c * 255.0f + 0.5f);
+    };
+    // Memory order R, G, B, A on little-endian
+    return toByte(color.r) | (toByte(color.g) << 8) | (toByte(color.b) << 16) | (toByte(color.a) << 24);
+}
+
+void SpriteBatch::appendQuad(std::vector<SpriteVertex>& vertices, float x, float y, float width, float height,
+                             float u0, float v0, float u1, float v1, uint32_t color) {
+    vertices.push_back({ x, y, u0, v0, color });
+    vertices.push_back({ x + width, y, u1, v0, color });
+    vertices.push_back({ x + width, y + height, u1, v1, color });
+    vertices.push_back({ x, y + height, u0, v1, color });
+}
+
+void SpriteBatch::begin(int screenWidth, int screenHeight, Camera* camera) {
+    if (!m_initialized && !initialize()) return;
+    
+    Vector2 offset(0, 0);
+    float zoom = 1.0f;
+    if (camera) {
+        offset = camera->getViewOffset();
+        zoom = camera->getViewScale();
+    }
+    
+    // Orthographic projection: world pixels -> camera -> NDC (y down), column-major
+    float sx = 2.0f * zoom / screenWidth;
+    float sy = -2.0f * zoom / screenHeight;
+    for (int i = 0; i < 16; i++) m_projection[i] = 0.0f;
+    m_projection[0] = sx;
+    m_projection[5] = sy;
+    m_projection[10] = 1.0f;
+    m_projection[12] = -1.0f - offset.x * sx;
+    m_projection[13] = 1.0f - offset.y * sy;
+    m_projection[15] = 1.0f;
+    
+    m_vertices.clear();
+    m_instances.clear();
+    m_currentTexture = nullptr;
+    m_currentShader = m_customShader ? m_customShader
+        : (m_mode == SpriteBatchMode::Instanced ? m_instancedShader.get() : m_defaultShader.get());
+    m_drawCalls = 0;
+    m_spriteCount = 0;
+    m_uploadedBytes = 0;
+    m_drawing = true;
+}
+
+void SpriteBatch::end() {
+    if (!m_drawing) return;
+    
+    flush();
+    m_drawing = false;
+}
+
+void SpriteBatch::setShader(Shader* shader) {
+    Shader* target = shader;
+    if (!target) {
+        target = (m_mode == SpriteBatchMode::Instanced) ? m_instancedShader.get() : m_defaultShader.get();
+    }
+    m_customShader = shader;
+    if (target == m_currentShader) return;
+    
+    flush();
+    m_currentShader = target;
+}
+
+void SpriteBatch::setMode(SpriteBatchMode mode) {
+    if (mode == m_mode) return;
+    
+    flush();
+    m_mode = mode;
+    if (!m_customShader) {
+        m_currentShader = (mode == SpriteBatchMode::Instanced) ? m_instancedShader.get() : m_defaultShader.get();
+    }
+}
+
+size_t SpriteBatch::getPendingCount() const {
+    return m_mode == SpriteBatchMode::Instanced ? m_instances.size() : m_vertices.size() / 4;
+}
+
+void SpriteBatch::setBlendMode(BlendMode mode) {
+    if (mode == m_blendMode) return;
+    
+    flush();
+    m_blendMode = mode;
+}
+
+void SpriteBatch::draw(Texture* texture, const Vector2& position, const Vector2& size,
+                       const Color& color, float rotation, const Vector2& uv0, const Vector2& uv1) {
+    if (!m_drawing) return;
+    
+    Texture* tex = (texture && texture->isValid()) ? texture : m_whiteTexture.get();
+    if (tex != m_currentTexture || static_cast<int>(getPendingCount()) >= m_maxSprites) {
+        flush();
+        m_currentTexture = tex;
+    }
+    
+    // Premultiplied textures need a premultiplied tint to match their blend func
+    uint32_t packed = tex->isPremultiplied()
+        ? packColor(Color(color.r * color.a, color.g * color.a, color.b * color.a, color.a))
+        : packColor(color);
+    
+    if (m_mode == SpriteBatchMode::Instanced) {
+        SpriteInstance instance;
+        instance.x = position.x;
+        instance.y = position.y;
+        instance.width = size.x;
+        instance.height = size.y;
+        instance.uv[0] = toUnorm16(uv0.x);
+        instance.uv[1] = toUnorm16(uv0.y);
+        instance.uv[2] = toUnorm16(uv1.x);
+        instance.uv[3] = toUnorm16(uv1.y);
+        instance.rotation = rotation * 3.14159265f / 180.0f;
+        instance.color = packed;
+        m_instances.push_back(instance);
+        m_spriteCount++;
+        return;
+    }
+    
+    // Corners relative to the top-left origin
+    float cx[4] = { 0.0f, size.x, size.x, 0.0f };
+    float cy[4] = { 0.0f, 0.0f, size.y, size.y };
+    float us[4] = { uv0.x, uv1.x, uv1.x, uv0.x };
+    float vs[4] = { uv0.y, uv0.y, uv1.y, uv1.y };
+    
+    if (rotation != 0.0f) {
+        float radians = rotation * 3.14159265f / 180.0f;
+        float c = std::cos(radians);
+        float s = std::sin(radians);
+        for (int i = 0; i < 4; i++) {
+            float x = cx[i];
+            float y = cy[i];
+            cx[i] = x * c - y * s;
+            cy[i] = x * s + y * c;
+        }
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        SpriteVertex vertex;
+        vertex.x = position.x + cx[i];
+        vertex.y = position.y + cy[i];
+        vertex.u = us[i];
+        vertex.v = vs[i];
+        vertex.color = packed;
+        m_vertices.push_back(vertex);
+    }
+    
+    m_spriteCount++;
+}
+
+void SpriteBatch::draw(const Sprite& sprite) {
+    draw(sprite.getTexture(), sprite.getPosition(), sprite.getSize(), sprite.getColor(), sprite.getRotation(),
+         sprite.getUV0(), sprite.getUV1());
+}
+
+GLuint SpriteBatch::createStaticVertexArray(GLuint vertexBuffer) {
+    if (!m_initialized && !initialize()) return 0;
+    
+    RenderBackend& backend = RenderBackend::getActive();
+    GLStateCache& state = GLStateCache::getInstance();
+    GLuint vao = backend.createVertexArray();
+    
+    state.bindVertexArray(vao);
+    backend.bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    backend.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    setVertexAttributes();
+    state.bindVertexArray(0);
+    
+    return vao;
+}
+
+void SpriteBatch::drawStatic(Texture* texture, GLuint vertexArray, int quadCount) {
+    if (!m_drawing || vertexArray == 0 || quadCount <= 0) return;
+    if (quadCount > m_maxSprites) {
+        std::cerr << "SpriteBatch: Static mesh of " << quadCount << " quads exceeds the index buffer ("
+                  << m_maxSprites << ")" << std::endl;
+        quadCount = m_maxSprites;
+    }
+    
+    flush();
+    
+    // Always the vertex-layout shader, whatever the batch mode
+    Shader* shader = m_customShader ? m_customShader : m_defaultShader.get();
+    if (!shader || !shader->isValid()) return;
+    
+    Texture* tex = (texture && texture->isValid()) ? texture : m_whiteTexture.get();
+    m_currentTexture = tex;
+    
+    shader->use();
+    RenderBackend& backend = RenderBackend::getActive();
+    GLint projLoc = shader->getUniformLocation("projection");
+    if (projLoc != -1) backend.setUniformMatrix4(projLoc, m_projection);
+    GLint texLoc = shader->getUniformLocation("image");
+    if (texLoc != -1) backend.setUniform(texLoc, 0);
+    tex->bind(0);
+    
+    applyBlendMode();
+    
+    GLStateCache::getInstance().bindVertexArray(vertexArray);
+    backend.drawIndexed(quadCount * 6);
+    
+    m_drawCalls++;
+    m_spriteCount += quadCount;
+}
+
+void SpriteBatch::applyBlendMode() {
+    GLStateCache& state = GLStateCache::getInstance();
+    bool premultiplied = m_currentTexture && m_currentTexture->isPremultiplied();
+    GLenum srcFactor = premultiplied ? GL_ONE : GL_SRC_ALPHA;
+    switch (m_blendMode) {
+        case BlendMode::None:
+            state.setBlendEnabled(false);
+            break;
+        case BlendMode::Alpha:
+            state.setBlendEnabled(true);
+            state.setBlendFunc(srcFactor, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Additive:
+            state.setBlendEnabled(true);
+            state.setBlendFunc(srcFactor, GL_ONE);
+            break;
+        case BlendMode::Multiply:
+            state.setBlendEnabled(true);
+            state.setBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+    }
+}
+
+void SpriteBatch::flush() {
+    if (getPendingCount() == 0 || !m_currentShader || !m_currentShader->isValid()) {
+        m_vertices.clear();
+        m_instances.clear();
+        return;
+    }
+    
+    m_currentShader->use();
+    
+    RenderBackend& backend = RenderBackend::getActive();
+    GLint projLoc = m_currentShader->getUniformLocation("projection");
+    if (projLoc != -1) backend.setUniformMatrix4(projLoc, m_projection);
+    
+    GLint texLoc = m_currentShader->getUniformLocation("image");
+    if (texLoc != -1) backend.setUniform(texLoc, 0);
+    m_currentTexture->bind(0);
+    
+    applyBlendMode();
+    
+    bool drawn = m_mode == SpriteBatchMode::Instanced ? flushInstances() : flushVertices();
+    if (drawn) {
+        m_drawCalls++;
+    }
+}
+
+bool SpriteBatch::flushVertices() {
+    size_t bytes = m_vertices.size() * sizeof(SpriteVertex);
+    
+    size_t offset = m_vertexStream->write(m_vertices.data(), bytes, sizeof(SpriteVertex));
+    if (offset == StreamBuffer::INVALID_OFFSET) {
+        m_vertices.clear();
+        return false;
+    }
+    
+    int indexCount = static_cast<int>(m_vertices.size() / 4 * 6);
+    int baseVertex = static_cast<int>(offset / sizeof(SpriteVertex));
+    GLStateCache::getInstance().bindVertexArray(m_vao);
+    RenderBackend::getActive().drawIndexed(indexCount, baseVertex);
+    
+    m_uploadedBytes += bytes;
+    m_vertices.clear();
+    return true;
+}
+
+bool SpriteBatch::flushInstances() {
+    size_t bytes = m_instances.size() * sizeof(SpriteInstance);
+    
+    size_t offset = m_instanceStream->write(m_instances.data(), bytes, sizeof(SpriteInstance));
+    if (offset == StreamBuffer::INVALID_OFFSET) {
+        m_instances.clear();
+        return false;
+    }
+    
+    GLStateCache::getInstance().bindVertexArray(m_instanceVao);
+    setInstanceAttributes(offset);
+    RenderBackend::getActive().drawIndexedInstanced(QuadGeometry::INDEX_COUNT, static_cast<int>(m_instances.size()));
+    
+    m_uploadedBytes += bytes;
+    m_instances.clear();
+    return true;
+}
@@ -0,0 +1,139 @@
+#ifndef OMEGA_SPRITE_BATCH_H
+#define OMEGA_SPRITE_BATCH_H
+
+#include "Sprite.h"
+#include "Shader.h"
+#include "Texture.h"
+#include <GL/glew.h>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class Camera;
+class StreamBuffer;
+
+// Blend state for a batch
+enum class BlendMode {
+    None,
+    Alpha,      // Standard transparency
+    Additive,   // Glow, fire, sparks
+    Multiply
+};
+
+// How a batch is turned into geometry
+enum class SpriteBatchMode {
+    Vertices,   // CPU-expanded quads, 4 vertices per sprite
+    Instanced   // One instance record per sprite over a shared unit quad
+};
+
+// Batched sprite vertex: position in pixels, texcoords, packed RGBA8 color
+struct SpriteVertex {
+    float x, y;
+    float u, v;
+    uint32_t color;
+};
+
+// Per-instance record for the instanced path (32 bytes vs 80 for four vertices)
+struct SpriteInstance {
+    float x, y;             // Top-left in pixels
+    float width, height;
+    uint16_t uv[4];         // u0, v0, u1, v1 as normalized 16-bit
+    float rotation;         // Radians around the top-left corner
+    uint32_t color;
+};
+
+// Collects quads into a streaming vertex buffer and issues one draw call per
+// run of sprites sharing the same texture, shader and blend mode.
+// Positions are top-left, y-down pixels; rotation is in degrees around the top-left corner.
+// Custom shaders must match the active mode's attribute layout (see SpriteBatch.cpp)
+// and declare a "projection" mat4 uniform.
+class SpriteBatch {
+public:
+    SpriteBatch(int maxSprites = 10000);
+    ~SpriteBatch();
+    
+    bool initialize();
+    bool isInitialized() const { return m_initialized; }
+    
+    // Frame
+    void begin(int screenWidth, int screenHeight, Camera* camera = nullptr);
+    void end();
+    void flush();
+    void endFrame();    // Once per presented frame; retires this frame's stream buffer segments
+    
+    // State (changing state flushes pending sprites)
+    void setShader(Shader* shader);     // nullptr = built-in batch shader
+    void setBlendMode(BlendMode mode);
+    BlendMode getBlendMode() const { return m_blendMode; }
+    void setMode(SpriteBatchMode mode);
+    SpriteBatchMode getMode() const { return m_mode; }
+    
+    // Submission
+    void draw(Texture* texture, const Vector2& position, const Vector2& size,
+              const Color& color = Color(), float rotation = 0.0f,
+              const Vector2& uv0 = Vector2(0, 0), const Vector2& uv1 = Vector2(1, 1));
+    void draw(const Sprite& sprite);
+    
+    // Static geometry: SpriteVertex quads (4 vertices each, same winding as draw)
+    // kept in a caller-owned vertex buffer, e.g. tilemap chunks. The VAO uses the
+    // batch vertex layout and the batch's quad index buffer, so it is only valid
+    // with this batch and at most getMaxSprites() quads; delete it through the backend.
+    GLuint createStaticVertexArray(GLuint vertexBuffer);
+    // One draw call, in order with the sprites around it (pending sprites are flushed first)
+    void drawStatic(Texture* texture, GLuint vertexArray, int quadCount);
+    
+    // Projection of the current frame, column-major, set by begin()
+    const float* getProjection() const { return m_projection; }
+    
+    // Statistics (reset by begin)
+    int getDrawCallCount() const { return m_drawCalls; }
+    int getSpriteCount() const { return m_spriteCount; }
+    size_t getUploadedBytes() const { return m_uploadedBytes; }
+    int getMaxSprites() const { return m_maxSprites; }
+    
+    static uint32_t packColor(const Color& color);
+    
+    // Appends an axis-aligned quad in draw()'s corner order, for building static meshes
+    static void appendQuad(std::vector<SpriteVertex>& vertices, float x, float y, float width, float height,
+                           float u0, float v0, float u1, float v1, uint32_t color = 0xFFFFFFFF);
+
+private:
+    void applyBlendMode();
+    // False when the stream buffer had no room and the batch was dropped undrawn
+    bool flushVertices();
+    bool flushInstances();
+    size_t getPendingCount() const;
+    void setInstanceAttributes(size_t baseOffset);
+    void setVertexAttributes();
+    
+    int m_maxSprites;
+    bool m_initialized;
+    bool m_drawing;
+    
+    GLuint m_vao;
+    std::unique_ptr<StreamBuffer> m_vertexStream;
+    GLuint m_ebo;
+    std::unique_ptr<Shader> m_defaultShader;
+    
+    // Instanced path
+    GLuint m_instanceVao;
+    std::unique_ptr<StreamBuffer> m_instanceStream;
+    std::unique_ptr<Shader> m_instancedShader;
+    std::vector<SpriteInstance> m_instances;
+    
+    std::unique_ptr<Texture> m_whiteTexture;
+    
+    std::vector<SpriteVertex> m_vertices;
+    Texture* m_currentTexture;
+    Shader* m_currentShader;
+    Shader* m_customShader;
+    BlendMode m_blendMode;
+    SpriteBatchMode m_mode;
+    float m_projection[16];
+    
+    int m_drawCalls;
+    int m_spriteCount;
+    size_t m_uploadedBytes;
+};
+
+#endif // OMEGA_SPRITE_BATCH_H
@@ -0,0 +1,170 @@
+#include "StreamBuffer.h"
+#include "RenderBackend.h"
+#include <iostream>
+#include <cstring>
+
+namespace {
+
+const GLuint64 FENCE_TIMEOUT_NS = 1000000000ull; // 1 second
+
+} // namespace
+
+StreamBuffer::StreamBuffer(GLenum target, size_t segmentSize, int segments)
+    : m_target(target)
+    , m_segmentSize(segmentSize)
+    , m_segmentCount(segments < 2 ? 2 : segments)
+    , m_mode(StreamBufferMode::Orphan)
+    , m_buffer(0)
+    , m_mapped(nullptr)
+    , m_fences(nullptr)
+    , m_segment(0)
+    , m_offset(0)
+    , m_segmentUsed(false)
+    , m_waitCount(0)
+    , m_wrapCount(0) {
+}
+
+StreamBuffer::~StreamBuffer() {
+    if (m_fences) {
+        for (int i = 0; i < m_segmentCount; i++) {
+            if (m_fences[i]) glDeleteSync(m_fences[i]);
+        }
+        delete[] m_fences;
+    }
+    
+    if (m_buffer != 0) {
+        RenderBackend& backend = RenderBackend::getActive();
+        if (m_mapped) {
+            backend.bindBuffer(m_target, m_buffer);
+            glUnmapBuffer(m_target);
+        }
+        backend.deleteBuffer(m_buffer);
+    }
+}
+
+bool StreamBuffer::initialize(bool preferPersistent) {
+    if (m_buffer != 0) return true;
+    
+    GLsizeiptr totalSize = static_cast<GLsizeiptr>(m_segmentSize * m_segmentCount);
+    m_fences = new GLsync[m_segmentCount];
+    for (int i = 0; i < m_segmentCount; i++) m_fences[i] = nullptr;
+    
+    RenderBackend& backend = RenderBackend::getActive();
+    m_buffer = backend.createBuffer();
+    backend.bindBuffer(m_target, m_buffer);
+    
+    // Mapping is GL-only; the Null backend always takes the orphaning path
+    bool mappable = backend.supportsBufferMapping();
+    if (preferPersistent && mappable && GLEW_ARB_buffer_storage) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(m_target, totalSize, nullptr, flags);
+        m_mapped = static_cast<unsigned char*>(glMapBufferRange(m_target, 0, totalSize, flags));
+        if (m_mapped) {
+            m_mode = StreamBufferMode::Persistent;
+            return true;
+        }
+        
+        // Storage is immutable once specified; start over with a plain buffer
+        std::cerr << "StreamBuffer: Persistent mapping failed, falling back" << std::endl;
+        backend.deleteBuffer(m_buffer);
+        m_buffer = backend.createBuffer();
+        backend.bindBuffer(m_target, m_buffer);
+    }
+    
+    backend.bufferData(m_target, static_cast<size_t>(totalSize), nullptr, GL_STREAM_DRAW);
+    
+    // Unsynchronized mapping needs fences (core since 3.2) and map range (3.0)
+    m_mode = (preferPersistent && mappable) ? StreamBufferMode::Unsynchronized : StreamBufferMode::Orphan;
+    return true;
+}
+
+void StreamBuffer::waitForSegment(int segment) {
+    GLsync fence = m_fences[segment];
+    if (!fence) return;
+    
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        m_waitCount++;
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    }
+    if (result == GL_WAIT_FAILED) {
+        std::cerr << "StreamBuffer: Fence wait failed" << std::endl;
+    }
+    
+    glDeleteSync(fence);
+    m_fences[segment] = nullptr;
+}
+
+void StreamBuffer::advanceSegment() {
+    if (m_mode == StreamBufferMode::Orphan) {
+        // Orphaning hands the old storage to the driver; no fences needed
+        if (m_segment + 1 >= m_segmentCount) {
+            RenderBackend& backend = RenderBackend::getActive();
+            backend.bindBuffer(m_target, m_buffer);
+            backend.bufferData(m_target, m_segmentSize * m_segmentCount, nullptr, GL_STREAM_DRAW);
+        }
+    } else if (m_segmentUsed) {
+        m_fences[m_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    
+    m_segment = (m_segment + 1) % m_segmentCount;
+    m_offset = m_segment * m_segmentSize;
+    m_segmentUsed = false;
+    
+    if (m_mode != StreamBufferMode::Orphan) {
+        waitForSegment(m_segment);
+    }
+}
+
+size_t StreamBuffer::write(const void* data, size_t bytes, size_t alignment) {
+    if (m_buffer == 0 || bytes == 0) return INVALID_OFFSET;
+    if (bytes > m_segmentSize) {
+        std::cerr << "StreamBuffer: Write of " << bytes << " bytes exceeds segment size " << m_segmentSize << std::endl;
+        return INVALID_OFFSET;
+    }
+    
+    size_t segmentEnd = (m_segment + 1) * m_segmentSize;
+    size_t offset = alignment > 1 ? (m_offset + alignment - 1) / alignment * alignment : m_offset;
+    if (offset + bytes > segmentEnd) {
+        m_wrapCount++;
+        advanceSegment();
+        segmentEnd = (m_segment + 1) * m_segmentSize;
+        offset = alignment > 1 ? (m_offset + alignment - 1) / alignment * alignment : m_offset;
+        if (offset + bytes > segmentEnd) return INVALID_OFFSET; // Alignment padding pushed it over
+    }
+    
+    switch (m_mode) {
+        case StreamBufferMode::Persistent:
+            std::memcpy(m_mapped + offset, data, bytes);
+            break;
+        case StreamBufferMode::Unsynchronized: {
+            RenderBackend::getActive().bindBuffer(m_target, m_buffer);
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+            void* ptr = glMapBufferRange(m_target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), flags);
+            if (!ptr) {
+                std::cerr << "StreamBuffer: glMapBufferRange failed, switching to orphaning" << std::endl;
+                m_mode = StreamBufferMode::Orphan;
+                RenderBackend::getActive().bufferSubData(m_target, offset, bytes, data);
+                break;
+            }
+            std::memcpy(ptr, data, bytes);
+            glUnmapBuffer(m_target);
+            break;
+        }
+        case StreamBufferMode::Orphan: {
+            RenderBackend& backend = RenderBackend::getActive();
+            backend.bindBuffer(m_target, m_buffer);
+            backend.bufferSubData(m_target, offset, bytes, data);
+            break;
+        }
+    }
+    
+    m_offset = offset + bytes;
+    m_segmentUsed = true;
+    return offset;
+}
+
+void StreamBuffer::endFrame() {
+    if (m_buffer == 0 || !m_segmentUsed) return;
+    advanceSegment();
+}
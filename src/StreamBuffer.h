@@ -0,0 +1,70 @@
+#ifndef OMEGA_STREAM_BUFFER_H
+#define OMEGA_STREAM_BUFFER_H
+
+#include <GL/glew.h>
+#include <cstddef>
+
+// How the ring gets data to the GPU
+enum class StreamBufferMode {
+    Persistent,     // GL_ARB_buffer_storage: mapped once, written directly
+    Unsynchronized, // glMapBufferRange without implicit sync, fenced per segment
+    Orphan          // glBufferData(nullptr) when full + glBufferSubData
+};
+
+// Ring allocator for per-frame dynamic vertex/index data.
+// The buffer is split into `segments` (3 = triple buffering). Writes go into the
+// current segment; when it is full, or at endFrame(), a fence is dropped behind it
+// and the ring moves on, first waiting for the fence that guarded the next segment.
+// The CPU therefore never overwrites a range the GPU may still be reading.
+// For GL_ELEMENT_ARRAY_BUFFER rings, bind the VAO that should own the binding
+// before writing, since the write binds the buffer to its target.
+// Persistent and unsynchronized mapping are only used by the GL backend.
+class StreamBuffer {
+public:
+    static const size_t INVALID_OFFSET = static_cast<size_t>(-1);
+    
+    StreamBuffer(GLenum target, size_t segmentSize, int segments = 3);
+    ~StreamBuffer();
+    
+    // preferPersistent = false forces the map/orphan fallbacks (for testing/comparison)
+    bool initialize(bool preferPersistent = true);
+    
+    // Copies data into the ring and returns its byte offset in the buffer, or
+    // INVALID_OFFSET if bytes exceeds a segment. alignment need not be a power of two
+    // (vertex strides), so offset / stride is a valid base vertex.
+    size_t write(const void* data, size_t bytes, size_t alignment = 4);
+    
+    // Call once per frame after the frame's draws are submitted
+    void endFrame();
+    
+    GLuint getBuffer() const { return m_buffer; }
+    GLenum getTarget() const { return m_target; }
+    StreamBufferMode getMode() const { return m_mode; }
+    size_t getSegmentSize() const { return m_segmentSize; }
+    
+    // Statistics
+    int getWaitCount() const { return m_waitCount; }   // Fence waits that actually blocked
+    int getWrapCount() const { return m_wrapCount; }   // Segments retired early because they filled up
+
+private:
+    void advanceSegment();
+    void waitForSegment(int segment);
+    
+    GLenum m_target;
+    size_t m_segmentSize;
+    int m_segmentCount;
+    StreamBufferMode m_mode;
+    
+    GLuint m_buffer;
+    unsigned char* m_mapped;    // Persistent mode only
+    GLsync* m_fences;
+    
+    int m_segment;
+    size_t m_offset;            // Absolute write position
+    bool m_segmentUsed;
+    
+    int m_waitCount;
+    int m_wrapCount;
+};
+
+#endif // OMEGA_STREAM_BUFFER_H
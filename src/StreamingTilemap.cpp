@@ -0,0 +1,595 @@
+#include "StreamingTilemap.h"
+#include "SpriteBatch.h"
+#include "RenderBackend.h"
+#include "GLStateCache.h"
+#include "ThreadPool.h"
+#include <fstream>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+const uint32_t PAGED_MAGIC = 0x4D50544F; // "OTPM"
+const uint32_t PAGED_VERSION = 2;       // 1 stored raw Tile structs
+
+// Little-endian 32-bit fields, followed by chunksX * chunksY chunk records
+// (offset low, offset high, size, reserved), then the chunk data. Edge
+// chunks are stored at full size so every record has the same layout
+enum PagedHeaderField {
+    FIELD_MAGIC,
+    FIELD_VERSION,
+    FIELD_WIDTH,
+    FIELD_HEIGHT,
+    FIELD_TILE_WIDTH,
+    FIELD_TILE_HEIGHT,
+    FIELD_LAYER_COUNT,
+    FIELD_CHUNK_SIZE,
+    HEADER_FIELDS
+};
+
+const size_t HEADER_BYTES = HEADER_FIELDS * 4;
+const size_t RECORD_FIELDS = 4;
+
+int chunksAlong(int tiles, int chunkSize) {
+    return (tiles + chunkSize - 1) / chunkSize;
+}
+
+} // namespace
+
+StreamingTilemap::StreamingTilemap()
+    : m_width(0)
+    , m_height(0)
+    , m_tileWidth(0)
+    , m_tileHeight(0)
+    , m_layerCount(0)
+    , m_chunkSize(DEFAULT_CHUNK_SIZE)
+    , m_chunksX(0)
+    , m_chunksY(0)
+    , m_frame(0)
+    , m_loadRadius(2)
+    , m_memoryBudget(DEFAULT_MEMORY_BUDGET)
+    , m_maxLoadsInFlight(4)
+    , m_workerCount(1)
+    , m_loadsInFlight(0)
+    , m_cancelled(false)
+    , m_tileset(nullptr)
+    , m_meshBatch(nullptr)
+    , m_builtTextureWidth(0)
+    , m_builtTextureHeight(0) {
+}
+
+StreamingTilemap::~StreamingTilemap() {
+    close();
+}
+
+// ============================================================================
+// Paged File
+// ============================================================================
+
+bool StreamingTilemap::build(const std::string& filename, int width, int height, int tileWidth, int tileHeight,
+                             int layerCount, int chunkSize, const ChunkGenerator& generator) {
+    if (width <= 0 || height <= 0 || layerCount <= 0 || layerCount > Tilemap::MAX_LAYERS ||
+        chunkSize <= 0 || chunkSize > MAX_CHUNK_SIZE) {
+        std::cerr << "StreamingTilemap: Invalid layout for " << filename << std::endl;
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "StreamingTilemap: Failed to create file: " << filename << std::endl;
+        return false;
+    }
+
+    uint32_t header[HEADER_FIELDS];
+    header[FIELD_MAGIC] = PAGED_MAGIC;
+    header[FIELD_VERSION] = PAGED_VERSION;
+    header[FIELD_WIDTH] = static_cast<uint32_t>(width);
+    header[FIELD_HEIGHT] = static_cast<uint32_t>(height);
+    header[FIELD_TILE_WIDTH] = static_cast<uint32_t>(tileWidth);
+    header[FIELD_TILE_HEIGHT] = static_cast<uint32_t>(tileHeight);
+    header[FIELD_LAYER_COUNT] = static_cast<uint32_t>(layerCount);
+    header[FIELD_CHUNK_SIZE] = static_cast<uint32_t>(chunkSize);
+
+    unsigned char headerBytes[HEADER_BYTES];
+    encodeLittleEndian32(header, HEADER_FIELDS, headerBytes);
+    file.write(reinterpret_cast<const char*>(headerBytes), HEADER_BYTES);
+
+    // The table is rewritten once every offset is known
+    int chunksX = chunksAlong(width, chunkSize);
+    int chunksY = chunksAlong(height, chunkSize);
+    std::vector<uint32_t> table(static_cast<size_t>(chunksX) * chunksY * RECORD_FIELDS, 0);
+    std::vector<unsigned char> tableBytes(table.size() * 4);
+    file.write(reinterpret_cast<const char*>(tableBytes.data()), tableBytes.size());
+
+    size_t layerTiles = static_cast<size_t>(chunkSize) * chunkSize;
+    std::vector<Tile> tiles(layerTiles * layerCount);
+    std::vector<PackedTile> packed(tiles.size());
+    std::vector<unsigned char> bytes(packed.size() * 4);
+    for (int cy = 0; cy < chunksY && file; cy++) {
+        for (int cx = 0; cx < chunksX && file; cx++) {
+            for (int layer = 0; layer < layerCount; layer++) {
+                std::fill_n(tiles.begin() + layer * layerTiles, layerTiles, Tile(-1, false, layer));
+            }
+            generator(cx, cy, tiles);
+
+            bool empty = true;
+            for (size_t i = 0; i < tiles.size(); i++) {
+                packed[i] = packTile(tiles[i]);
+                empty = empty && packedTileId(packed[i]) < 0 && !isPackedTileSolid(packed[i]);
+            }
+            if (empty) continue; // Record stays all zero
+
+            uint64_t offset = static_cast<uint64_t>(file.tellp());
+            uint32_t* record = &table[(static_cast<size_t>(cy) * chunksX + cx) * RECORD_FIELDS];
+            record[0] = static_cast<uint32_t>(offset);
+            record[1] = static_cast<uint32_t>(offset >> 32);
+            record[2] = static_cast<uint32_t>(bytes.size());
+
+            encodeLittleEndian32(packed.data(), packed.size(), bytes.data());
+            file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+    }
+
+    encodeLittleEndian32(table.data(), table.size(), tableBytes.data());
+    file.seekp(HEADER_BYTES);
+    file.write(reinterpret_cast<const char*>(tableBytes.data()), tableBytes.size());
+    if (!file) {
+        std::cerr << "StreamingTilemap: Failed to write " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool StreamingTilemap::writeFile(const std::string& filename, const Tilemap& source, int chunkSize) {
+    int width = source.getWidth();
+    int height = source.getHeight();
+    int layerCount = source.getLayerCount();
+
+    return build(filename, width, height, source.getTileWidth(), source.getTileHeight(), layerCount, chunkSize,
+        [&](int chunkX, int chunkY, std::vector<Tile>& tiles) {
+            int startX = chunkX * chunkSize;
+            int startY = chunkY * chunkSize;
+            int endX = std::min(width, startX + chunkSize);
+            int endY = std::min(height, startY + chunkSize);
+            for (int layer = 0; layer < layerCount; layer++) {
+                for (int y = startY; y < endY; y++) {
+                    for (int x = startX; x < endX; x++) {
+                        tiles[(layer * chunkSize + (y - startY)) * chunkSize + (x - startX)] = source.getTile(x, y, layer);
+                    }
+                }
+            }
+        });
+}
+
+bool StreamingTilemap::open(const std::string& filename) {
+    close();
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "StreamingTilemap: Failed to open file: " << filename << std::endl;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    unsigned char headerBytes[HEADER_BYTES];
+    uint32_t header[HEADER_FIELDS] = {};
+    if (file.read(reinterpret_cast<char*>(headerBytes), HEADER_BYTES)) {
+        decodeLittleEndian32(headerBytes, HEADER_FIELDS, header);
+    }
+
+    int width = static_cast<int>(header[FIELD_WIDTH]);
+    int height = static_cast<int>(header[FIELD_HEIGHT]);
+    int layerCount = static_cast<int>(header[FIELD_LAYER_COUNT]);
+    int chunkSize = static_cast<int>(header[FIELD_CHUNK_SIZE]);
+    if (header[FIELD_MAGIC] != PAGED_MAGIC || header[FIELD_VERSION] != PAGED_VERSION ||
+        width <= 0 || height <= 0 || layerCount <= 0 || layerCount > Tilemap::MAX_LAYERS ||
+        chunkSize <= 0 || chunkSize > MAX_CHUNK_SIZE) {
+        std::cerr << "StreamingTilemap: Invalid header in " << filename << std::endl;
+        return false;
+    }
+
+    int chunksX = chunksAlong(width, chunkSize);
+    int chunksY = chunksAlong(height, chunkSize);
+    std::vector<uint32_t> table(static_cast<size_t>(chunksX) * chunksY * RECORD_FIELDS);
+    std::vector<unsigned char> tableBytes(table.size() * 4);
+    if (!file.read(reinterpret_cast<char*>(tableBytes.data()), tableBytes.size())) {
+        std::cerr << "StreamingTilemap: Truncated chunk table in " << filename << std::endl;
+        return false;
+    }
+    decodeLittleEndian32(tableBytes.data(), table.size(), table.data());
+
+    // Checked up front so a worker never reads past the end or into another chunk
+    std::vector<ChunkRecord> records(static_cast<size_t>(chunksX) * chunksY);
+    uint32_t chunkBytes = static_cast<uint32_t>(chunkSize * chunkSize * layerCount * sizeof(PackedTile));
+    for (size_t i = 0; i < records.size(); i++) {
+        ChunkRecord& record = records[i];
+        record.offset = table[i * RECORD_FIELDS] | (static_cast<uint64_t>(table[i * RECORD_FIELDS + 1]) << 32);
+        record.size = table[i * RECORD_FIELDS + 2];
+        record.reserved = table[i * RECORD_FIELDS + 3];
+        if (record.size != 0 && (record.size != chunkBytes || record.offset + record.size > fileSize)) {
+            std::cerr << "StreamingTilemap: Corrupt chunk table in " << filename << std::endl;
+            return false;
+        }
+    }
+
+    m_filename = filename;
+    m_width = width;
+    m_height = height;
+    m_tileWidth = static_cast<int>(header[FIELD_TILE_WIDTH]);
+    m_tileHeight = static_cast<int>(header[FIELD_TILE_HEIGHT]);
+    m_layerCount = layerCount;
+    m_chunkSize = chunkSize;
+    m_chunksX = chunksX;
+    m_chunksY = chunksY;
+    m_records.swap(records);
+
+    m_resident.resize(m_records.size());
+    m_states.assign(m_records.size(), ChunkState::Unloaded);
+    m_focusFrame.assign(m_records.size(), 0);
+    m_frame = 0;
+    m_stats = StreamingTilemapStats();
+
+    m_cancelled = false;
+    m_pool.reset(new ThreadPool(m_workerCount));
+    return true;
+}
+
+void StreamingTilemap::close() {
+    // Queued reads see the flag and skip the file; the pool joins before anything is freed
+    m_cancelled = true;
+    m_pool.reset();
+    m_completed.clear();
+    m_loadsInFlight = 0;
+
+    for (std::unique_ptr<Chunk>& chunk : m_resident) {
+        if (chunk) {
+            releaseMeshes(*chunk);
+        }
+    }
+    m_resident.clear();
+    m_states.clear();
+    m_focusFrame.clear();
+    m_lru.clear();
+    m_records.clear();
+    m_filename.clear();
+    m_stats.residentChunks = 0;
+    m_stats.loadingChunks = 0;
+    m_stats.residentBytes = 0;
+}
+
+// ============================================================================
+// Streaming
+// ============================================================================
+
+void StreamingTilemap::requestLoad(int index) {
+    m_states[index] = ChunkState::Loading;
+    m_loadsInFlight++;
+    m_stats.loadingChunks = m_loadsInFlight;
+
+    ChunkRecord record = m_records[index];
+    std::string filename = m_filename;
+    m_pool->submit([this, index, record, filename]() {
+        LoadResult result;
+        result.index = index;
+        result.ok = false;
+
+        if (m_cancelled) {
+            // Dropped by close()
+        } else if (record.size == 0) {
+            result.ok = true;
+        } else {
+            std::ifstream file(filename, std::ios::binary);
+            result.tiles.resize(record.size / sizeof(PackedTile));
+            unsigned char* bytes = reinterpret_cast<unsigned char*>(result.tiles.data());
+            file.seekg(static_cast<std::streamoff>(record.offset));
+            result.ok = static_cast<bool>(file.read(reinterpret_cast<char*>(bytes), record.size));
+            decodeLittleEndian32(bytes, result.tiles.size(), result.tiles.data());
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completed.push_back(std::move(result));
+    });
+}
+
+void StreamingTilemap::installLoaded() {
+    std::deque<LoadResult> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed.swap(m_completed);
+    }
+
+    for (LoadResult& result : completed) {
+        m_loadsInFlight--;
+
+        if (!result.ok) {
+            // Installed as empty rather than retried every frame
+            std::cerr << "StreamingTilemap: Failed to read chunk " << result.index << " from " << m_filename << std::endl;
+            result.tiles.clear();
+        }
+
+        std::unique_ptr<Chunk> chunk(new Chunk());
+        chunk->index = result.index;
+        chunk->tiles.swap(result.tiles);
+        m_lru.push_front(result.index);
+        chunk->lruPosition = m_lru.begin();
+
+        m_stats.residentBytes += chunk->tiles.size() * sizeof(PackedTile);
+        m_stats.chunksLoaded++;
+        m_resident[result.index] = std::move(chunk);
+        m_states[result.index] = ChunkState::Resident;
+    }
+
+    m_stats.loadingChunks = m_loadsInFlight;
+    m_stats.residentChunks = static_cast<int>(m_lru.size());
+}
+
+void StreamingTilemap::touch(Chunk& chunk) {
+    m_lru.splice(m_lru.begin(), m_lru, chunk.lruPosition);
+}
+
+void StreamingTilemap::requestFocusChunks(int maxInFlight) {
+    struct Candidate {
+        int index;
+        int distance;
+    };
+    std::vector<Candidate> candidates;
+
+    int chunkWidth = m_tileWidth * m_chunkSize;
+    int chunkHeight = m_tileHeight * m_chunkSize;
+    for (const Vector2& point : m_focusPoints) {
+        int centerX = chunkWidth > 0 ? static_cast<int>(std::floor(point.x / chunkWidth)) : 0;
+        int centerY = chunkHeight > 0 ? static_cast<int>(std::floor(point.y / chunkHeight)) : 0;
+
+        for (int cy = std::max(0, centerY - m_loadRadius); cy <= std::min(m_chunksY - 1, centerY + m_loadRadius); cy++) {
+            for (int cx = std::max(0, centerX - m_loadRadius); cx <= std::min(m_chunksX - 1, centerX + m_loadRadius); cx++) {
+                int index = cy * m_chunksX + cx;
+                if (m_focusFrame[index] == m_frame) continue; // Already seen via another focus point
+                m_focusFrame[index] = m_frame;
+
+                if (m_states[index] == ChunkState::Resident) {
+                    touch(*m_resident[index]);
+                } else if (m_states[index] == ChunkState::Unloaded) {
+                    int dx = cx - centerX;
+                    int dy = cy - centerY;
+                    candidates.push_back({ index, dx * dx + dy * dy });
+                }
+            }
+        }
+    }
+
+    // Nearest first, so the chunks under the camera arrive before the edges
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.distance < b.distance;
+    });
+    for (const Candidate& candidate : candidates) {
+        if (m_loadsInFlight >= maxInFlight) break;
+        requestLoad(candidate.index);
+    }
+}
+
+void StreamingTilemap::evict(int index) {
+    std::unique_ptr<Chunk>& chunk = m_resident[index];
+    releaseMeshes(*chunk);
+    m_lru.erase(chunk->lruPosition);
+    m_stats.residentBytes -= chunk->tiles.size() * sizeof(PackedTile);
+    m_stats.chunksEvicted++;
+    chunk.reset();
+    m_states[index] = ChunkState::Unloaded;
+}
+
+void StreamingTilemap::evictOverBudget() {
+    // Least recently used first; chunks the focus area still wants are kept even over budget
+    auto it = m_lru.end();
+    while (m_stats.residentBytes > m_memoryBudget && it != m_lru.begin()) {
+        --it;
+        int index = *it;
+        if (m_focusFrame[index] == m_frame) continue;
+
+        auto next = std::next(it);
+        evict(index);
+        it = next;
+    }
+    m_stats.residentChunks = static_cast<int>(m_lru.size());
+}
+
+void StreamingTilemap::update() {
+    if (!isOpen()) return;
+
+    m_frame++;
+    installLoaded();
+    requestFocusChunks(m_maxLoadsInFlight);
+    evictOverBudget();
+}
+
+void StreamingTilemap::finishLoads() {
+    if (!isOpen()) return;
+
+    m_frame++;
+    installLoaded();
+    requestFocusChunks(INT_MAX);
+    m_pool->waitIdle();
+    installLoaded();
+    evictOverBudget();
+}
+
+// ============================================================================
+// Tile Access
+// ============================================================================
+
+Tile StreamingTilemap::getTile(int x, int y, int layer) const {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height || layer < 0 || layer >= m_layerCount) {
+        return Tile();
+    }
+
+    const Chunk* chunk = m_resident[chunkIndex(x, y)].get();
+    if (!chunk) {
+        m_stats.missedReads++;
+        return m_defaultTile;
+    }
+    if (chunk->tiles.empty()) return Tile(-1, false, layer);
+
+    int localX = x % m_chunkSize;
+    int localY = y % m_chunkSize;
+    return unpackTile(chunk->tiles[(layer * m_chunkSize + localY) * m_chunkSize + localX]);
+}
+
+Tile StreamingTilemap::getTile(int x, int y) const {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) return Tile();
+
+    const Chunk* chunk = m_resident[chunkIndex(x, y)].get();
+    if (!chunk) {
+        m_stats.missedReads++;
+        return m_defaultTile;
+    }
+    if (chunk->tiles.empty()) return Tile();
+
+    int localX = x % m_chunkSize;
+    int localY = y % m_chunkSize;
+    for (int layer = m_layerCount - 1; layer >= 0; layer--) {
+        PackedTile tile = chunk->tiles[(layer * m_chunkSize + localY) * m_chunkSize + localX];
+        if (packedTileId(tile) >= 0) return unpackTile(tile);
+    }
+    return Tile();
+}
+
+bool StreamingTilemap::isTileSolid(int x, int y) const {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) return false;
+
+    const Chunk* chunk = m_resident[chunkIndex(x, y)].get();
+    if (!chunk) {
+        m_stats.missedReads++;
+        return m_defaultTile.solid;
+    }
+    if (chunk->tiles.empty()) return false;
+
+    int localX = x % m_chunkSize;
+    int localY = y % m_chunkSize;
+    for (int layer = 0; layer < m_layerCount; layer++) {
+        if (isPackedTileSolid(chunk->tiles[(layer * m_chunkSize + localY) * m_chunkSize + localX])) return true;
+    }
+    return false;
+}
+
+bool StreamingTilemap::isChunkResident(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return false;
+    return m_states[chunkY * m_chunksX + chunkX] == ChunkState::Resident;
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void StreamingTilemap::setTileset(Tileset* tileset) {
+    m_tileset = tileset;
+    m_builtTextureWidth = 0;
+    m_builtTextureHeight = 0;
+}
+
+void StreamingTilemap::releaseMeshes(Chunk& chunk) {
+    RenderBackend& backend = RenderBackend::getActive();
+    GLStateCache& state = GLStateCache::getInstance();
+    for (LayerMesh& mesh : chunk.meshes) {
+        // drawStatic leaves the VAO recorded as bound; a reused name must not look bound
+        if (mesh.vao != 0) {
+            state.onVertexArrayDeleted(mesh.vao);
+            backend.deleteVertexArray(mesh.vao);
+        }
+        if (mesh.vbo != 0) backend.deleteBuffer(mesh.vbo);
+    }
+    chunk.meshes.clear();
+    chunk.meshesBuilt = false;
+}
+
+void StreamingTilemap::buildMeshes(Chunk& chunk, SpriteBatch& batch) {
+    releaseMeshes(chunk);
+    chunk.meshesBuilt = true;
+    if (chunk.tiles.empty()) return;
+
+    int chunkX = chunk.index % m_chunksX;
+    int chunkY = chunk.index / m_chunksX;
+    int startX = chunkX * m_chunkSize;
+    int startY = chunkY * m_chunkSize;
+    int endX = std::min(m_width, startX + m_chunkSize);
+    int endY = std::min(m_height, startY + m_chunkSize);
+    float tileWidth = static_cast<float>(m_tileWidth);
+    float tileHeight = static_cast<float>(m_tileHeight);
+
+    RenderBackend& backend = RenderBackend::getActive();
+    std::vector<SpriteVertex> vertices;
+    vertices.reserve(m_chunkSize * m_chunkSize * 4);
+    chunk.meshes.resize(m_layerCount);
+
+    for (int layer = 0; layer < m_layerCount; layer++) {
+        vertices.clear();
+        for (int y = startY; y < endY; y++) {
+            const PackedTile* row = &chunk.tiles[(layer * m_chunkSize + (y - startY)) * m_chunkSize];
+            for (int x = startX; x < endX; x++) {
+                int tileId = packedTileId(row[x - startX]);
+                if (tileId < 0) continue; // Empty tile
+
+                float u0, v0, u1, v1;
+                m_tileset->getTileUV(tileId, u0, v0, u1, v1);
+                SpriteBatch::appendQuad(vertices, x * tileWidth, y * tileHeight, tileWidth, tileHeight, u0, v0, u1, v1);
+            }
+        }
+
+        LayerMesh& mesh = chunk.meshes[layer];
+        mesh.quadCount = static_cast<int>(vertices.size() / 4);
+        if (mesh.quadCount == 0) continue;
+
+        mesh.vbo = backend.createBuffer();
+        mesh.vao = batch.createStaticVertexArray(mesh.vbo);
+        backend.bindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+        backend.bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(SpriteVertex), vertices.data(), GL_STATIC_DRAW);
+    }
+}
+
+void StreamingTilemap::render(SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos) {
+    if (!isOpen() || !m_tileset || !m_tileset->getTexture()) return;
+
+    Texture* texture = m_tileset->getTexture();
+
+    // Same rules as Tilemap: VAOs belong to one batch, UVs to one texture size
+    bool stale = &batch != m_meshBatch;
+    if (texture->getWidth() != m_builtTextureWidth || texture->getHeight() != m_builtTextureHeight) {
+        m_builtTextureWidth = texture->getWidth();
+        m_builtTextureHeight = texture->getHeight();
+        m_tileset->calculateGrid();
+        stale = true;
+    }
+    if (stale) {
+        for (int index : m_lru) {
+            releaseMeshes(*m_resident[index]);
+        }
+        m_meshBatch = &batch;
+    }
+    if (m_tileset->getColumns() <= 0) return;
+
+    // One tile of slack on each side for partially visible edges
+    int startX = std::max(0, static_cast<int>(std::floor(cameraPos.x / m_tileWidth)) - 1);
+    int startY = std::max(0, static_cast<int>(std::floor(cameraPos.y / m_tileHeight)) - 1);
+    int endX = std::min(m_width, static_cast<int>(std::floor((cameraPos.x + screenWidth) / m_tileWidth)) + 2);
+    int endY = std::min(m_height, static_cast<int>(std::floor((cameraPos.y + screenHeight) / m_tileHeight)) + 2);
+    if (startX >= endX || startY >= endY) return;
+
+    // Layer by layer so upper layers cover lower ones across chunk borders
+    for (int layer = 0; layer < m_layerCount; layer++) {
+        for (int cy = startY / m_chunkSize; cy <= (endY - 1) / m_chunkSize; cy++) {
+            for (int cx = startX / m_chunkSize; cx <= (endX - 1) / m_chunkSize; cx++) {
+                Chunk* chunk = m_resident[cy * m_chunksX + cx].get();
+                if (!chunk) continue; // Still streaming in
+
+                if (layer == 0) {
+                    touch(*chunk);
+                    if (!chunk->meshesBuilt) buildMeshes(*chunk, batch);
+                }
+                if (layer < static_cast<int>(chunk->meshes.size()) && chunk->meshes[layer].quadCount > 0) {
+                    batch.drawStatic(texture, chunk->meshes[layer].vao, chunk->meshes[layer].quadCount);
+                }
+            }
+        }
+    }
+}
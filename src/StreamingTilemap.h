@@ -0,0 +1,173 @@
+#ifndef OMEGA_STREAMING_TILEMAP_H
+#define OMEGA_STREAMING_TILEMAP_H
+
+#include "Tilemap.h"
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+class ThreadPool;
+class SpriteBatch;
+
+struct StreamingTilemapStats {
+    int residentChunks = 0;
+    int loadingChunks = 0;
+    size_t residentBytes = 0;       // Tile data only; chunk vertex buffers live on the GPU
+    uint64_t chunksLoaded = 0;
+    uint64_t chunksEvicted = 0;
+    uint64_t missedReads = 0;       // getTile / isTileSolid on a chunk that wasn't resident
+};
+
+// Tilemap for worlds too large to keep in memory. The map lives in a paged
+// file (see build / writeFile): a header, a chunk table and one record per
+// chunk holding every layer of that chunk as little-endian PackedTiles, so any
+// chunk can be read on its own.
+//
+// update() requests the chunks within the load radius of the focus points
+// (camera, players) from worker threads, nearest first, and installs the
+// ones that finished. Once resident data exceeds the memory budget the least
+// recently used chunks outside the focus area are evicted.
+//
+// getTile / isTileSolid never block: a tile in a chunk that isn't resident
+// yet reads as the default tile. Everything except the workers belongs to
+// the render thread.
+class StreamingTilemap {
+public:
+    static const size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+    static const int DEFAULT_CHUNK_SIZE = 64;
+    static const int MAX_CHUNK_SIZE = 64;    // Keeps a layer chunk within one SpriteBatch index buffer
+
+    StreamingTilemap();
+    ~StreamingTilemap();
+    StreamingTilemap(const StreamingTilemap&) = delete;
+    StreamingTilemap& operator=(const StreamingTilemap&) = delete;
+
+    // Reads the header and chunk table only
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return !m_filename.empty(); }
+
+    // Writes a paged file chunk by chunk; generator fills the chunkSize x chunkSize x
+    // layerCount tiles (layer-major, then row-major) of one chunk. The whole map is never in memory
+    using ChunkGenerator = std::function<void(int chunkX, int chunkY, std::vector<Tile>& tiles)>;
+    static bool build(const std::string& filename, int width, int height, int tileWidth, int tileHeight,
+                      int layerCount, int chunkSize, const ChunkGenerator& generator);
+    static bool writeFile(const std::string& filename, const Tilemap& source, int chunkSize = DEFAULT_CHUNK_SIZE);
+
+    // Streaming
+    void setFocusPoints(const std::vector<Vector2>& worldPositions) { m_focusPoints = worldPositions; }
+    void setLoadRadius(int chunks) { m_loadRadius = chunks > 0 ? chunks : 0; }
+    void setMemoryBudget(size_t bytes) { m_memoryBudget = bytes; }
+    void setMaxLoadsInFlight(int count) { m_maxLoadsInFlight = count > 0 ? count : 1; }
+    void setWorkerCount(int count) { m_workerCount = count; }    // Before open()
+
+    // Once per frame on the render thread
+    void update();
+    // Blocks until every requested chunk has arrived and is installed (loading screens, tests)
+    void finishLoads();
+
+    // Tile access, never blocking
+    void setDefaultTile(const Tile& tile) { m_defaultTile = tile; }
+    Tile getTile(int x, int y, int layer) const;
+    Tile getTile(int x, int y) const;   // Top-most non-empty layer
+    bool isTileSolid(int x, int y) const;
+    bool isChunkResident(int chunkX, int chunkY) const;
+
+    // Resident chunks only; vertex buffers are built on first draw and dropped on eviction
+    void setTileset(Tileset* tileset);
+    void render(SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos = Vector2(0, 0));
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    int getTileWidth() const { return m_tileWidth; }
+    int getTileHeight() const { return m_tileHeight; }
+    int getLayerCount() const { return m_layerCount; }
+    int getChunkSize() const { return m_chunkSize; }
+
+    const StreamingTilemapStats& getStats() const { return m_stats; }
+
+private:
+    enum class ChunkState : uint8_t { Unloaded, Loading, Resident };
+
+    struct ChunkRecord {
+        uint64_t offset;
+        uint32_t size;      // 0 = every tile empty, nothing stored
+        uint32_t reserved;
+    };
+
+    struct LayerMesh {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        int quadCount = 0;
+    };
+
+    struct Chunk {
+        int index = 0;
+        std::vector<PackedTile> tiles;  // Layer-major, then row-major; empty when the chunk has no tiles at all
+        std::vector<LayerMesh> meshes;  // Per layer, built on first draw
+        bool meshesBuilt = false;
+        std::list<int>::iterator lruPosition;
+    };
+
+    struct LoadResult {
+        int index;
+        std::vector<PackedTile> tiles;
+        bool ok;
+    };
+
+    int chunkIndex(int x, int y) const { return (y / m_chunkSize) * m_chunksX + x / m_chunkSize; }
+    void requestFocusChunks(int maxInFlight);
+    void requestLoad(int index);
+    void installLoaded();
+    void touch(Chunk& chunk);
+    void evict(int index);
+    void evictOverBudget();
+    void buildMeshes(Chunk& chunk, SpriteBatch& batch);
+    void releaseMeshes(Chunk& chunk);
+
+    std::string m_filename;
+    int m_width;
+    int m_height;
+    int m_tileWidth;
+    int m_tileHeight;
+    int m_layerCount;
+    int m_chunkSize;
+    int m_chunksX;
+    int m_chunksY;
+    std::vector<ChunkRecord> m_records;
+
+    std::vector<std::unique_ptr<Chunk>> m_resident;     // Per chunk; null unless resident
+    std::vector<ChunkState> m_states;
+    std::vector<uint32_t> m_focusFrame;                 // Last update() that wanted the chunk
+    std::list<int> m_lru;                               // Most recently used first
+    uint32_t m_frame;
+
+    std::vector<Vector2> m_focusPoints;
+    int m_loadRadius;
+    size_t m_memoryBudget;
+    int m_maxLoadsInFlight;
+    int m_workerCount;
+    Tile m_defaultTile;
+
+    std::unique_ptr<ThreadPool> m_pool;
+    std::mutex m_mutex;
+    std::deque<LoadResult> m_completed;                 // Filled by workers
+    int m_loadsInFlight;                                // Render thread only
+    std::atomic<bool> m_cancelled;
+
+    Tileset* m_tileset;
+    SpriteBatch* m_meshBatch;
+    int m_builtTextureWidth;
+    int m_builtTextureHeight;
+
+    mutable StreamingTilemapStats m_stats;
+};
+
+#endif // OMEGA_STREAMING_TILEMAP_H
@@ -1,4 +1,5 @@
 #include "Text.h"
+#include "SpriteBatch.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -210,9 +211,8 @@ void Text::render(Shader* shader, int screenWidth, int screenHeight) {
         // Set texture coordinates (UV)
         float texWidth = m_font->getTexture()->getWidth();
         float texHeight = m_font->getTexture()->getHeight();
-        
-        // Note: This is a simplified version. For proper UV support,
-        // you'd need to extend the Sprite class to support custom UVs
+        charSprite.setTextureRect(Vector2(glyph->x / texWidth, glyph->y / texHeight),
+                                  Vector2((glyph->x + glyph->width) / texWidth, (glyph->y + glyph->height) / texHeight));
         
         charSprite.draw(shader, screenWidth, screenHeight);
         
@@ -220,6 +220,49 @@ void Text::render(Shader* shader, int screenWidth, int screenHeight) {
     }
 }
 
+void Text::render(SpriteBatch& batch) {
+    if (!m_font || !m_font->getTexture() || m_text.empty()) return;
+    
+    Texture* texture = m_font->getTexture();
+    float texWidth = static_cast<float>(texture->getWidth());
+    float texHeight = static_cast<float>(texture->getHeight());
+    
+    Vector2 cursor = m_position;
+    
+    // Calculate alignment offset
+    if (m_alignment > 0) {
+        int textWidth, textHeight;
+        measureSize(textWidth, textHeight);
+        
+        if (m_alignment == 1) { // Center
+            cursor.x -= textWidth * 0.5f;
+        } else if (m_alignment == 2) { // Right
+            cursor.x -= textWidth;
+        }
+    }
+    float lineStartX = cursor.x;
+    
+    for (char c : m_text) {
+        if (c == '\n') {
+            cursor.x = lineStartX;
+            cursor.y += m_font->getLineHeight() * m_scale;
+            continue;
+        }
+        
+        const Glyph* glyph = m_font->getGlyph(c);
+        if (!glyph) continue;
+        
+        Vector2 pos(cursor.x + glyph->xOffset * m_scale, cursor.y + glyph->yOffset * m_scale);
+        Vector2 size(glyph->width * m_scale, glyph->height * m_scale);
+        Vector2 uv0(glyph->x / texWidth, glyph->y / texHeight);
+        Vector2 uv1((glyph->x + glyph->width) / texWidth, (glyph->y + glyph->height) / texHeight);
+        
+        batch.draw(texture, pos, size, m_color, 0.0f, uv0, uv1);
+        
+        cursor.x += glyph->xAdvance * m_scale;
+    }
+}
+
 void Text::measureSize(int& width, int& height) const {
     if (m_font) {
         m_font->measureText(m_text, width, height);
@@ -60,6 +60,7 @@ public:
     float getScale() const { return m_scale; }
     
     void render(Shader* shader, int screenWidth, int screenHeight);
+    void render(SpriteBatch& batch);
     
     // Utility
     void measureSize(int& width, int& height) const;
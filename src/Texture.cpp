@@ -1,6 +1,9 @@
 #include "Texture.h"
+#include "GLStateCache.h"
+#include "RenderBackend.h"
+#include "CookedTexture.h"
+#include "MappedFile.h"
 #include <iostream>
-#include <GL/glew.h>
 
 // For now, we'll use a simple stub implementation
 // In production, you'd use stb_image or SDL_image
@@ -9,18 +12,60 @@
 
 Texture::Texture()
     : m_textureID(0)
+    , m_ownsTexture(false)
+    , m_state(TextureState::Empty)
     , m_width(0)
-    , m_height(0) {
+    , m_height(0)
+    , m_premultiplied(false) {
 }
 
 Texture::~Texture() {
-    if (m_textureID != 0) {
-        glDeleteTextures(1, &m_textureID);
-        m_textureID = 0;
+    release();
+}
+
+void Texture::release() {
+    if (m_textureID != 0 && m_ownsTexture) {
+        GLStateCache::getInstance().onTextureDeleted(m_textureID);
+        RenderBackend::getActive().deleteTexture(m_textureID);
     }
+    m_textureID = 0;
+    m_ownsTexture = false;
+}
+
+void Texture::setPlaceholder(GLuint placeholder) {
+    release();
+    m_textureID = placeholder;
+    m_width = 0;
+    m_height = 0;
+    m_premultiplied = false;
+    m_state = TextureState::Loading;
+}
+
+void Texture::adopt(GLuint texture, int width, int height, bool premultiplied) {
+    release();
+    m_textureID = texture;
+    m_ownsTexture = true;
+    m_width = width;
+    m_height = height;
+    m_premultiplied = premultiplied;
+    m_state = TextureState::Resident;
+}
+
+void Texture::setFailed() {
+    // The placeholder belongs to the loader, which may delete it at any time
+    release();
+    m_width = 0;
+    m_height = 0;
+    m_state = TextureState::Failed;
 }
 
 bool Texture::loadFromFile(const std::string& filepath) {
+    const std::string cookedExtension = ".otex";
+    if (filepath.size() >= cookedExtension.size() &&
+        filepath.compare(filepath.size() - cookedExtension.size(), cookedExtension.size(), cookedExtension) == 0) {
+        return loadCooked(filepath);
+    }
+
     int channels;
     unsigned char* data = stbi_load(filepath.c_str(), &m_width, &m_height, &channels, 0);
     
@@ -40,6 +85,52 @@ bool Texture::loadFromFile(const std::string& filepath) {
     return success;
 }
 
+bool Texture::loadCooked(const std::string& filepath) {
+    MappedFile file;
+    if (!file.open(filepath)) {
+        std::cerr << "Failed to load texture: " << filepath << std::endl;
+        return false;
+    }
+
+    CookedTexture cooked;
+    if (!cooked.parse(file.getData(), file.getSize())) {
+        std::cerr << "Failed to load texture: " << filepath << std::endl;
+        return false;
+    }
+
+    GLenum format = GL_RGBA;
+    switch (cooked.getFormat()) {
+        case OTexPixelFormat::R8: format = GL_RED; break;
+        case OTexPixelFormat::RG8: format = GL_RG; break;
+        case OTexPixelFormat::RGB8: format = GL_RGB; break;
+        case OTexPixelFormat::RGBA8: format = GL_RGBA; break;
+    }
+
+    m_width = cooked.getWidth();
+    m_height = cooked.getHeight();
+    m_premultiplied = cooked.isPremultiplied();
+
+    // Levels go straight from the mapping to the driver; no decode, no mip generation
+    RenderBackend& backend = RenderBackend::getActive();
+    GLStateCache& state = GLStateCache::getInstance();
+    release();
+    m_textureID = backend.createTexture();
+    m_ownsTexture = true;
+    m_state = TextureState::Resident;
+    state.bindTexture(0, m_textureID);
+    int levelCount = cooked.getLevelCount();
+    for (int i = 0; i < levelCount; i++) {
+        const OTexLevel& level = cooked.getLevel(i);
+        backend.textureLevel(i, levelCount, static_cast<int>(level.width), static_cast<int>(level.height),
+                             format, cooked.getLevelData(i));
+    }
+    state.bindTexture(0, 0);
+
+    std::cout << "Loaded texture: " << filepath << " (" << m_width << "x" << m_height << ", "
+              << levelCount << " levels" << (m_premultiplied ? ", premultiplied" : "") << ")" << std::endl;
+    return true;
+}
+
 bool Texture::createFromData(unsigned char* data, int width, int height, int channels) {
     if (!data) {
         std::cerr << "Cannot create texture from null data" << std::endl;
@@ -48,15 +139,7 @@ bool Texture::createFromData(unsigned char* data, int width, int height, int cha
 
     m_width = width;
     m_height = height;
-
-    glGenTextures(1, &m_textureID);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
-
-    // Set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    m_premultiplied = false;
 
     // Determine format
     GLenum format = GL_RGB;
@@ -64,19 +147,53 @@ bool Texture::createFromData(unsigned char* data, int width, int height, int cha
     else if (channels == 3) format = GL_RGB;
     else if (channels == 1) format = GL_RED;
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    RenderBackend& backend = RenderBackend::getActive();
+    GLStateCache& state = GLStateCache::getInstance();
+    release();
+    m_textureID = backend.createTexture();
+    m_ownsTexture = true;
+    m_state = TextureState::Resident;
+    state.bindTexture(0, m_textureID);
+    backend.textureImage(width, height, format, data, true);
+    state.bindTexture(0, 0);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+bool Texture::createEmpty(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        std::cerr << "Cannot create empty texture of size " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+
+    RenderBackend& backend = RenderBackend::getActive();
+    GLStateCache& state = GLStateCache::getInstance();
+    release();
+    m_textureID = backend.createTexture();
+    m_ownsTexture = true;
+    m_state = TextureState::Resident;
+    state.bindTexture(0, m_textureID);
+    backend.textureImage(width, height, GL_RGBA, nullptr, false);
+    state.bindTexture(0, 0);
 
     return true;
 }
 
+void Texture::updateRegion(int x, int y, int width, int height, const unsigned char* rgba) {
+    if (m_textureID == 0 || !rgba) return;
+
+    GLStateCache& state = GLStateCache::getInstance();
+    state.bindTexture(0, m_textureID);
+    RenderBackend::getActive().textureSubImage(x, y, width, height, GL_RGBA, rgba);
+}
+
 void Texture::bind(unsigned int slot) {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    GLStateCache::getInstance().bindTexture(slot, m_textureID);
 }
 
 void Texture::unbind() {
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::getInstance().bindTexture(0, 0);
 }
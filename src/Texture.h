@@ -4,13 +4,26 @@
 #include <GL/glew.h>
 #include <string>
 
+enum class TextureState {
+    Empty,
+    Loading,    // Async load in flight; a shared placeholder is bound instead
+    Resident,
+    Failed      // Async load failed; holds no texture, like Empty
+};
+
 class Texture {
 public:
     Texture();
     ~Texture();
 
+    // .otex files are mapped and uploaded level by level; anything else is decoded
     bool loadFromFile(const std::string& filepath);
+    bool loadCooked(const std::string& filepath);
     bool createFromData(unsigned char* data, int width, int height, int channels);
+    
+    // Blank RGBA texture without mipmaps, filled later with updateRegion (atlas pages)
+    bool createEmpty(int width, int height);
+    void updateRegion(int x, int y, int width, int height, const unsigned char* rgba);
     void bind(unsigned int slot = 0);
     void unbind();
     
@@ -18,11 +31,28 @@ public:
     int getHeight() const { return m_height; }
     GLuint getID() const { return m_textureID; }
     bool isValid() const { return m_textureID != 0; }
+    
+    TextureState getState() const { return m_state; }
+    bool isResident() const { return m_state == TextureState::Resident; }
+    
+    // Async loading (AsyncTextureLoader). Until adopt(), the texture borrows the
+    // placeholder object and reports a size of 0x0.
+    void setPlaceholder(GLuint placeholder);
+    void adopt(GLuint texture, int width, int height, bool premultiplied);
+    void setFailed();
+    
+    // Colour already multiplied by alpha (cooked textures); blend with GL_ONE
+    bool isPremultiplied() const { return m_premultiplied; }
 
 private:
+    void release();
+    
     GLuint m_textureID;
+    bool m_ownsTexture;     // False while borrowing the placeholder
+    TextureState m_state;
     int m_width;
     int m_height;
+    bool m_premultiplied;
 };
 
 #endif // OMEGA_TEXTURE_H
@@ -0,0 +1,230 @@
+#include "TextureAtlas.h"
+#include "stb_image.h"
+#include <iostream>
+#include <algorithm>
+#include <climits>
+
+// ============================================================================
+// SkylinePacker Implementation
+// ============================================================================
+
+SkylinePacker::SkylinePacker(int width, int height) {
+    reset(width, height);
+}
+
+void SkylinePacker::reset(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_usedArea = 0;
+    m_skyline.clear();
+    m_skyline.push_back({ 0, 0, width });
+}
+
+int SkylinePacker::fitAt(size_t index, int width, int height) const {
+    int x = m_skyline[index].x;
+    if (x + width > m_width) return -1;
+    
+    // The rect rests on the highest skyline segment it spans
+    int y = 0;
+    int remaining = width;
+    for (size_t i = index; remaining > 0 && i < m_skyline.size(); i++) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) return -1;
+        remaining -= m_skyline[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::pack(int width, int height, AtlasRect& outRect) {
+    int bestY = INT_MAX;
+    int bestWidth = INT_MAX;
+    size_t bestIndex = 0;
+    bool found = false;
+    
+    // Bottom-left rule: lowest top edge, ties broken by the narrowest segment
+    for (size_t i = 0; i < m_skyline.size(); i++) {
+        int y = fitAt(i, width, height);
+        if (y < 0) continue;
+        
+        int top = y + height;
+        if (top < bestY || (top == bestY && m_skyline[i].width < bestWidth)) {
+            bestY = top;
+            bestWidth = m_skyline[i].width;
+            bestIndex = i;
+            outRect = { m_skyline[i].x, y, width, height };
+            found = true;
+        }
+    }
+    
+    if (!found) return false;
+    
+    addLevel(bestIndex, outRect);
+    m_usedArea += static_cast<long long>(width) * height;
+    return true;
+}
+
+void SkylinePacker::addLevel(size_t index, const AtlasRect& rect) {
+    Node node = { rect.x, rect.y + rect.height, rect.width };
+    m_skyline.insert(m_skyline.begin() + index, node);
+    
+    // Trim or remove the segments now covered by the new node
+    for (size_t i = index + 1; i < m_skyline.size(); i++) {
+        Node& prev = m_skyline[i - 1];
+        Node& current = m_skyline[i];
+        int prevRight = prev.x + prev.width;
+        if (current.x >= prevRight) break;
+        
+        int shrink = prevRight - current.x;
+        current.x += shrink;
+        current.width -= shrink;
+        if (current.width > 0) break;
+        
+        m_skyline.erase(m_skyline.begin() + i);
+        i--;
+    }
+    
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < m_skyline.size(); i++) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+            i--;
+        }
+    }
+}
+
+float SkylinePacker::getOccupancy() const {
+    long long total = static_cast<long long>(m_width) * m_height;
+    return total > 0 ? static_cast<float>(m_usedArea) / total : 0.0f;
+}
+
+// ============================================================================
+// TextureAtlas Implementation
+// ============================================================================
+
+TextureAtlas::TextureAtlas(int pageWidth, int pageHeight, int padding, bool bleed)
+    : m_pageWidth(pageWidth)
+    , m_pageHeight(pageHeight)
+    , m_padding(padding)
+    , m_bleed(bleed) {
+}
+
+TextureAtlas::Page* TextureAtlas::createPage() {
+    auto page = std::make_unique<Page>();
+    page->texture = std::make_unique<Texture>();
+    if (!page->texture->createEmpty(m_pageWidth, m_pageHeight)) {
+        return nullptr;
+    }
+    page->packer.reset(m_pageWidth, m_pageHeight);
+    
+    m_pages.push_back(std::move(page));
+    return m_pages.back().get();
+}
+
+TextureRegion TextureAtlas::add(const std::string& name, const unsigned char* data, int width, int height, int channels) {
+    auto existing = m_regions.find(name);
+    if (existing != m_regions.end()) {
+        return existing->second;
+    }
+    
+    if (!data || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+        std::cerr << "TextureAtlas: Invalid image data for '" << name << "'" << std::endl;
+        return TextureRegion();
+    }
+    
+    int paddedWidth = width + m_padding * 2;
+    int paddedHeight = height + m_padding * 2;
+    if (paddedWidth > m_pageWidth || paddedHeight > m_pageHeight) {
+        std::cerr << "TextureAtlas: '" << name << "' (" << width << "x" << height
+                  << ") does not fit in a " << m_pageWidth << "x" << m_pageHeight << " page" << std::endl;
+        return TextureRegion();
+    }
+    
+    // First fit across existing pages
+    Page* page = nullptr;
+    AtlasRect rect = { 0, 0, 0, 0 };
+    for (auto& candidate : m_pages) {
+        if (candidate->packer.pack(paddedWidth, paddedHeight, rect)) {
+            page = candidate.get();
+            break;
+        }
+    }
+    if (!page) {
+        page = createPage();
+        if (!page || !page->packer.pack(paddedWidth, paddedHeight, rect)) {
+            std::cerr << "TextureAtlas: Failed to allocate page for '" << name << "'" << std::endl;
+            return TextureRegion();
+        }
+    }
+    
+    // Expand to RGBA, with the gutter either clamped from the edges (bleed) or transparent
+    std::vector<unsigned char> pixels(static_cast<size_t>(paddedWidth) * paddedHeight * 4, 0);
+    for (int py = 0; py < paddedHeight; py++) {
+        int sy = py - m_padding;
+        bool insideY = sy >= 0 && sy < height;
+        if (!insideY && !m_bleed) continue;
+        sy = std::min(std::max(sy, 0), height - 1);
+        
+        for (int px = 0; px < paddedWidth; px++) {
+            int sx = px - m_padding;
+            bool insideX = sx >= 0 && sx < width;
+            if (!insideX && !m_bleed) continue;
+            sx = std::min(std::max(sx, 0), width - 1);
+            
+            const unsigned char* src = data + (static_cast<size_t>(sy) * width + sx) * channels;
+            unsigned char* dst = &pixels[(static_cast<size_t>(py) * paddedWidth + px) * 4];
+            switch (channels) {
+                case 1: dst[0] = dst[1] = dst[2] = src[0]; dst[3] = 255; break;
+                case 2: dst[0] = dst[1] = dst[2] = src[0]; dst[3] = src[1]; break;
+                case 3: dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255; break;
+                default: dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3]; break;
+            }
+        }
+    }
+    page->texture->updateRegion(rect.x, rect.y, paddedWidth, paddedHeight, pixels.data());
+    
+    TextureRegion region;
+    region.texture = page->texture.get();
+    region.x = rect.x + m_padding;
+    region.y = rect.y + m_padding;
+    region.width = width;
+    region.height = height;
+    region.uv0 = Vector2(static_cast<float>(region.x) / m_pageWidth, static_cast<float>(region.y) / m_pageHeight);
+    region.uv1 = Vector2(static_cast<float>(region.x + width) / m_pageWidth,
+                         static_cast<float>(region.y + height) / m_pageHeight);
+    
+    m_regions[name] = region;
+    return region;
+}
+
+bool TextureAtlas::addFromFile(const std::string& name, const std::string& filepath, TextureRegion& outRegion) {
+    int width, height, channels;
+    unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
+    if (!data) {
+        std::cerr << "TextureAtlas: Failed to load image: " << filepath << std::endl;
+        std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    
+    outRegion = add(name, data, width, height, channels);
+    stbi_image_free(data);
+    return outRegion.isValid();
+}
+
+TextureRegion TextureAtlas::getRegion(const std::string& name) const {
+    auto it = m_regions.find(name);
+    return it != m_regions.end() ? it->second : TextureRegion();
+}
+
+bool TextureAtlas::hasRegion(const std::string& name) const {
+    return m_regions.find(name) != m_regions.end();
+}
+
+Texture* TextureAtlas::getPageTexture(size_t page) const {
+    return page < m_pages.size() ? m_pages[page]->texture.get() : nullptr;
+}
+
+void TextureAtlas::clear() {
+    m_regions.clear();
+    m_pages.clear();
+}
@@ -0,0 +1,80 @@
+#ifndef OMEGA_TEXTURE_ATLAS_H
+#define OMEGA_TEXTURE_ATLAS_H
+
+#include "Sprite.h"
+#include "Texture.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+
+// Rectangle placed by the packer, in page pixels
+struct AtlasRect {
+    int x, y, width, height;
+};
+
+// Skyline bottom-left packer for a single page
+class SkylinePacker {
+public:
+    SkylinePacker(int width = 0, int height = 0);
+    
+    void reset(int width, int height);
+    bool pack(int width, int height, AtlasRect& outRect);
+    
+    float getOccupancy() const;
+
+private:
+    struct Node {
+        int x, y, width;
+    };
+    
+    // Returns the y the rect would rest at when its left edge is on node index, or -1
+    int fitAt(size_t index, int width, int height) const;
+    void addLevel(size_t index, const AtlasRect& rect);
+    
+    int m_width;
+    int m_height;
+    long long m_usedArea;
+    std::vector<Node> m_skyline;
+};
+
+// Packs images into shared RGBA pages so sprites using different images can be batched.
+// Each image gets `padding` pixels of gutter on every side; with bleed enabled
+// the gutter repeats the image's edge pixels so linear filtering never samples a neighbour.
+class TextureAtlas {
+public:
+    TextureAtlas(int pageWidth = 2048, int pageHeight = 2048, int padding = 2, bool bleed = true);
+    ~TextureAtlas() = default;
+    
+    // Places the image on the first page with room, opening a new page if needed.
+    // Returns an invalid region if the image (plus padding) is larger than a page.
+    TextureRegion add(const std::string& name, const unsigned char* data, int width, int height, int channels);
+    bool addFromFile(const std::string& name, const std::string& filepath, TextureRegion& outRegion);
+    
+    TextureRegion getRegion(const std::string& name) const;
+    bool hasRegion(const std::string& name) const;
+    
+    void clear();
+    
+    size_t getPageCount() const { return m_pages.size(); }
+    Texture* getPageTexture(size_t page) const;
+    size_t getRegionCount() const { return m_regions.size(); }
+
+private:
+    struct Page {
+        std::unique_ptr<Texture> texture;
+        SkylinePacker packer;
+    };
+    
+    Page* createPage();
+    
+    int m_pageWidth;
+    int m_pageHeight;
+    int m_padding;
+    bool m_bleed;
+    
+    std::vector<std::unique_ptr<Page>> m_pages;
+    std::unordered_map<std::string, TextureRegion> m_regions;
+};
+
+#endif // OMEGA_TEXTURE_ATLAS_H
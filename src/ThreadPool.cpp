@@ -0,0 +1,70 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+    : m_running(0)
+    , m_shutdown(false) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+        if (threadCount < 1) threadCount = 1;
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_jobAvailable.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_jobs.empty() && m_running == 0; });
+}
+
+size_t ThreadPool::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size() + static_cast<size_t>(m_running);
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] { return m_shutdown || !m_jobs.empty(); });
+            // Drain the queue before exiting so no submitted job is lost
+            if (m_jobs.empty()) return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_running++;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running--;
+            if (m_jobs.empty() && m_running == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef OMEGA_THREAD_POOL_H
+#define OMEGA_THREAD_POOL_H
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+// Fixed set of worker threads running fire-and-forget jobs in FIFO order.
+// Jobs must not touch GL; hand results back to the render thread instead.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount = 0); // 0 = hardware concurrency - 1, at least 1
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> job);
+
+    // Blocks until the queue is empty and no job is running
+    void waitIdle();
+
+    int getThreadCount() const { return static_cast<int>(m_threads.size()); }
+    size_t getPendingCount() const;
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_threads;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_idle;
+    std::deque<std::function<void()>> m_jobs;
+    int m_running;
+    bool m_shutdown;
+};
+
+#endif // OMEGA_THREAD_POOL_H
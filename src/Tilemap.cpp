@@ -1,7 +1,55 @@
 #include "Tilemap.h"
+#include "SpriteBatch.h"
+#include "RenderBackend.h"
+#include "GLStateCache.h"
 #include <fstream>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+const uint32_t TILEMAP_MAGIC = 0x504D544F; // "OTMP"
+
+// Versioned header, little-endian; one grid of packed tiles per layer follows
+enum TilemapHeaderField {
+    FIELD_MAGIC,
+    FIELD_VERSION,
+    FIELD_WIDTH,
+    FIELD_HEIGHT,
+    FIELD_TILE_WIDTH,
+    FIELD_TILE_HEIGHT,
+    FIELD_LAYER_COUNT,
+    HEADER_FIELDS
+};
+
+// Dimensions read from a map file. Tiles are addressed with int indices, so a
+// grid may hold at most INT_MAX cells; the product is taken in 64 bits
+bool isValidMapSize(int width, int height, int tileWidth, int tileHeight) {
+    return width > 0 && height > 0 && tileWidth > 0 && tileHeight > 0 &&
+           static_cast<uint64_t>(width) * static_cast<uint64_t>(height) <= static_cast<uint64_t>(INT_MAX);
+}
+
+} // namespace
+
+void encodeLittleEndian32(const uint32_t* values, size_t count, unsigned char* out) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t value = values[i];
+        out[i * 4 + 0] = static_cast<unsigned char>(value);
+        out[i * 4 + 1] = static_cast<unsigned char>(value >> 8);
+        out[i * 4 + 2] = static_cast<unsigned char>(value >> 16);
+        out[i * 4 + 3] = static_cast<unsigned char>(value >> 24);
+    }
+}
+
+void decodeLittleEndian32(const unsigned char* in, size_t count, uint32_t* values) {
+    for (size_t i = 0; i < count; i++) {
+        const unsigned char* bytes = in + i * 4;
+        values[i] = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                    (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+}
 
 // ============================================================================
 // Tileset Implementation
@@ -31,7 +79,7 @@ void Tileset::calculateGrid() {
 }
 
 void Tileset::getTileUV(int tileId, float& u0, float& v0, float& u1, float& v1) const {
-    if (!m_texture || tileId < 0) {
+    if (!m_texture || tileId < 0 || m_columns <= 0) {
         u0 = v0 = 0.0f;
         u1 = v1 = 1.0f;
         return;
@@ -58,9 +106,23 @@ Tilemap::Tilemap(int width, int height, int tileWidth, int tileHeight)
     , m_height(height)
     , m_tileWidth(tileWidth)
     , m_tileHeight(tileHeight)
-    , m_tileset(nullptr) {
+    , m_chunksX(0)
+    , m_chunksY(0)
+    , m_solidWords(0)
+    , m_tileset(nullptr)
+    , m_nextSolidityCallbackId(1)
+    , m_chunkBatch(nullptr)
+    , m_builtTextureWidth(0)
+    , m_builtTextureHeight(0)
+    , m_chunkRebuilds(0) {
     
-    m_tiles.resize(width * height);
+    resetLayers(1);
+}
+
+Tilemap::~Tilemap() {
+    for (Layer& layer : m_layers) {
+        releaseChunks(layer);
+    }
 }
 
 int Tilemap::coordToIndex(int x, int y) const {
@@ -71,26 +133,223 @@ bool Tilemap::isValidCoord(int x, int y) const {
     return x >= 0 && x < m_width && y >= 0 && y < m_height;
 }
 
+Tilemap::Layer* Tilemap::ensureLayer(int layer) {
+    if (layer < 0 || layer >= MAX_LAYERS) {
+        std::cerr << "Tilemap: Layer " << layer << " out of range (0-" << MAX_LAYERS - 1 << ")" << std::endl;
+        return nullptr;
+    }
+    
+    while (static_cast<int>(m_layers.size()) <= layer) {
+        Layer added;
+        added.tiles.assign(static_cast<size_t>(m_width) * m_height, packTile(Tile(-1, false, static_cast<int>(m_layers.size()))));
+        added.chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+        m_layers.push_back(std::move(added));
+    }
+    return &m_layers[layer];
+}
+
+void Tilemap::resetLayers(int layerCount) {
+    for (Layer& layer : m_layers) {
+        releaseChunks(layer);
+    }
+    m_layers.clear();
+    
+    m_chunksX = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunksY = (m_height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_solidWords = (m_width + 63) / 64;
+    m_solidBits.assign(static_cast<size_t>(m_solidWords) * m_height, 0);
+    ensureLayer(layerCount - 1);
+}
+
+void Tilemap::updateSolidity(int x, int y, int width, int height) {
+    int startX = std::max(0, x);
+    int startY = std::max(0, y);
+    int endX = std::min(m_width, x + width);
+    int endY = std::min(m_height, y + height);
+    
+    for (int ty = startY; ty < endY; ty++) {
+        uint64_t* row = &m_solidBits[static_cast<size_t>(ty) * m_solidWords];
+        for (int tx = startX; tx < endX; tx++) {
+            int index = coordToIndex(tx, ty);
+            bool solid = false;
+            for (const Layer& layer : m_layers) {
+                if (isPackedTileSolid(layer.tiles[index])) {
+                    solid = true;
+                    break;
+                }
+            }
+            
+            uint64_t bit = 1ULL << (tx % 64);
+            if (solid) {
+                row[tx / 64] |= bit;
+            } else {
+                row[tx / 64] &= ~bit;
+            }
+        }
+    }
+}
+
+void Tilemap::releaseChunks(Layer& layer) {
+    RenderBackend& backend = RenderBackend::getActive();
+    GLStateCache& state = GLStateCache::getInstance();
+    for (Chunk& chunk : layer.chunks) {
+        if (chunk.vao != 0) {
+            state.onVertexArrayDeleted(chunk.vao);
+            backend.deleteVertexArray(chunk.vao);
+        }
+        if (chunk.vbo != 0) {
+            backend.deleteBuffer(chunk.vbo);
+        }
+    }
+    layer.chunks.clear();
+}
+
+void Tilemap::resetChunks(Layer& layer) {
+    releaseChunks(layer);
+    layer.chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+}
+
+void Tilemap::markChunksDirty(Layer& layer, int x, int y, int width, int height) {
+    int startX = std::max(0, x) / CHUNK_SIZE;
+    int startY = std::max(0, y) / CHUNK_SIZE;
+    int endX = std::min(m_width, x + width);
+    int endY = std::min(m_height, y + height);
+    if (endX <= 0 || endY <= 0) return;
+    
+    for (int cy = startY; cy <= (endY - 1) / CHUNK_SIZE; cy++) {
+        for (int cx = startX; cx <= (endX - 1) / CHUNK_SIZE; cx++) {
+            layer.chunks[cy * m_chunksX + cx].dirty = true;
+        }
+    }
+}
+
+int Tilemap::getChunkCount() const {
+    size_t count = 0;
+    for (const Layer& layer : m_layers) {
+        count += layer.chunks.size();
+    }
+    return static_cast<int>(count);
+}
+
+void Tilemap::setTileset(Tileset* tileset) {
+    if (tileset == m_tileset) return;
+    
+    m_tileset = tileset;
+    for (Layer& layer : m_layers) {
+        markChunksDirty(layer, 0, 0, m_width, m_height);
+    }
+}
+
+int Tilemap::addSolidityCallback(SolidityCallback callback) {
+    int id = m_nextSolidityCallbackId++;
+    m_solidityCallbacks.push_back({ id, std::move(callback) });
+    return id;
+}
+
+void Tilemap::removeSolidityCallback(int id) {
+    m_solidityCallbacks.erase(std::remove_if(m_solidityCallbacks.begin(), m_solidityCallbacks.end(),
+        [id](const std::pair<int, SolidityCallback>& entry) { return entry.first == id; }),
+        m_solidityCallbacks.end());
+}
+
+void Tilemap::notifySolidityChanged(int x, int y, int width, int height) {
+    for (const auto& entry : m_solidityCallbacks) {
+        entry.second(x, y, width, height);
+    }
+}
+
 void Tilemap::setTile(int x, int y, const Tile& tile) {
-    if (isValidCoord(x, y)) {
-        m_tiles[coordToIndex(x, y)] = tile;
+    if (!isValidCoord(x, y)) return;
+    
+    Layer* layer = ensureLayer(tile.layer);
+    if (!layer) return;
+    
+    if (tile.tileId > MAX_PACKED_TILE_ID) {
+        std::cerr << "Tilemap: Tile id " << tile.tileId << " out of range (max " << MAX_PACKED_TILE_ID << ")" << std::endl;
+    }
+    
+    PackedTile& current = layer->tiles[coordToIndex(x, y)];
+    PackedTile packed = packTile(tile);
+    bool solidityChanged = isPackedTileSolid(current) != isPackedTileSolid(packed);
+    if (packedTileId(current) != packedTileId(packed)) {
+        markChunksDirty(*layer, x, y, 1, 1);
+    }
+    current = packed;
+    
+    if (solidityChanged) {
+        updateSolidity(x, y, 1, 1);
+        notifySolidityChanged(x, y, 1, 1);
     }
 }
 
 Tile Tilemap::getTile(int x, int y) const {
     if (isValidCoord(x, y)) {
-        return m_tiles[coordToIndex(x, y)];
+        int index = coordToIndex(x, y);
+        for (int layer = static_cast<int>(m_layers.size()) - 1; layer >= 0; layer--) {
+            PackedTile tile = m_layers[layer].tiles[index];
+            if (packedTileId(tile) >= 0) return unpackTile(tile);
+        }
     }
     return Tile();
 }
 
+Tile Tilemap::getTile(int x, int y, int layer) const {
+    if (isValidCoord(x, y) && layer >= 0 && layer < static_cast<int>(m_layers.size())) {
+        return unpackTile(m_layers[layer].tiles[coordToIndex(x, y)]);
+    }
+    return Tile(-1, false, layer);
+}
+
 void Tilemap::clearTile(int x, int y) {
-    setTile(x, y, Tile());
+    for (int layer = 0; layer < static_cast<int>(m_layers.size()); layer++) {
+        clearTile(x, y, layer);
+    }
+}
+
+void Tilemap::clearTile(int x, int y, int layer) {
+    if (layer >= 0 && layer < static_cast<int>(m_layers.size())) {
+        setTile(x, y, Tile(-1, false, layer));
+    }
 }
 
 bool Tilemap::isTileSolid(int x, int y) const {
-    if (isValidCoord(x, y)) {
-        return m_tiles[coordToIndex(x, y)].solid;
+    if (!isValidCoord(x, y)) return false;
+    return (m_solidBits[static_cast<size_t>(y) * m_solidWords + x / 64] >> (x % 64)) & 1;
+}
+
+uint64_t Tilemap::getSolidBits(int x, int y, int count) const {
+    if (y < 0 || y >= m_height || count <= 0 || x <= -64 || x >= m_width) return 0;
+    
+    uint64_t bits;
+    if (x < 0) {
+        bits = getSolidBits(0, y, 64) << -x;
+    } else {
+        // Bits past the last column are kept clear, so only the row end needs a bounds check
+        const uint64_t* row = &m_solidBits[static_cast<size_t>(y) * m_solidWords];
+        int word = x / 64;
+        int shift = x % 64;
+        bits = row[word] >> shift;
+        if (shift != 0 && word + 1 < m_solidWords) {
+            bits |= row[word + 1] << (64 - shift);
+        }
+    }
+    
+    if (count < 64) {
+        bits &= (1ULL << count) - 1;
+    }
+    return bits;
+}
+
+bool Tilemap::isAnySolid(int x, int y, int width, int height) const {
+    int startX = std::max(0, x);
+    int startY = std::max(0, y);
+    int endX = std::min(m_width, x + width);
+    int endY = std::min(m_height, y + height);
+    
+    for (int ty = startY; ty < endY; ty++) {
+        for (int tx = startX; tx < endX; tx += 64) {
+            if (getSolidBits(tx, ty, endX - tx) != 0) return true;
+        }
     }
     return false;
 }
@@ -106,27 +365,31 @@ void Tilemap::tileToWorld(int tileX, int tileY, float& worldX, float& worldY) co
     worldY = tileY * m_tileHeight;
 }
 
-void Tilemap::render(Shader* shader, int screenWidth, int screenHeight, const Vector2& cameraPos) {
-    if (!m_tileset || !m_tileset->getTexture()) return;
-    
+void Tilemap::getVisibleTileRange(int screenWidth, int screenHeight, const Vector2& cameraPos,
+                                  int& startX, int& startY, int& endX, int& endY) const {
+    // One tile of slack on each side for partially visible edges
+    startX = std::max(0, static_cast<int>(std::floor(cameraPos.x / m_tileWidth)) - 1);
+    startY = std::max(0, static_cast<int>(std::floor(cameraPos.y / m_tileHeight)) - 1);
+    endX = std::min(m_width, static_cast<int>(std::floor((cameraPos.x + screenWidth) / m_tileWidth)) + 2);
+    endY = std::min(m_height, static_cast<int>(std::floor((cameraPos.y + screenHeight) / m_tileHeight)) + 2);
+}
+
+void Tilemap::drawLayerSprites(const Layer& layer, Shader* shader, int screenWidth, int screenHeight,
+                               int startX, int startY, int endX, int endY) {
     Sprite tileSprite;
     tileSprite.setTexture(m_tileset->getTexture());
     tileSprite.setSize(Vector2(m_tileWidth, m_tileHeight));
     
-    // Calculate visible tile range (basic culling)
-    int startX = std::max(0, static_cast<int>(cameraPos.x / m_tileWidth) - 1);
-    int startY = std::max(0, static_cast<int>(cameraPos.y / m_tileHeight) - 1);
-    int endX = std::min(m_width, static_cast<int>((cameraPos.x + screenWidth) / m_tileWidth) + 2);
-    int endY = std::min(m_height, static_cast<int>((cameraPos.y + screenHeight) / m_tileHeight) + 2);
-    
     for (int y = startY; y < endY; y++) {
+        const PackedTile* row = &layer.tiles[coordToIndex(0, y)];
         for (int x = startX; x < endX; x++) {
-            const Tile& tile = m_tiles[coordToIndex(x, y)];
-            if (tile.tileId < 0) continue; // Empty tile
+            int tileId = packedTileId(row[x]);
+            if (tileId < 0) continue; // Empty tile
             
-            // Get UV coordinates for this tile
+            // Select this tile's cell of the tileset
             float u0, v0, u1, v1;
-            m_tileset->getTileUV(tile.tileId, u0, v0, u1, v1);
+            m_tileset->getTileUV(tileId, u0, v0, u1, v1);
+            tileSprite.setTextureRect(Vector2(u0, v0), Vector2(u1, v1));
             
             // Set sprite position
             float worldX, worldY;
@@ -139,69 +402,299 @@ void Tilemap::render(Shader* shader, int screenWidth, int screenHeight, const Ve
     }
 }
 
+void Tilemap::render(Shader* shader, int screenWidth, int screenHeight, const Vector2& cameraPos) {
+    if (!prepareTileset()) return;
+    
+    // Calculate visible tile range
+    int startX, startY, endX, endY;
+    getVisibleTileRange(screenWidth, screenHeight, cameraPos, startX, startY, endX, endY);
+    
+    for (const Layer& layer : m_layers) {
+        drawLayerSprites(layer, shader, screenWidth, screenHeight, startX, startY, endX, endY);
+    }
+}
+
 void Tilemap::renderLayer(int layer, Shader* shader, int screenWidth, int screenHeight, const Vector2& cameraPos) {
-    if (!m_tileset || !m_tileset->getTexture()) return;
+    if (!prepareTileset()) return;
+    if (layer < 0 || layer >= static_cast<int>(m_layers.size())) return;
     
-    Sprite tileSprite;
-    tileSprite.setTexture(m_tileset->getTexture());
-    tileSprite.setSize(Vector2(m_tileWidth, m_tileHeight));
+    int startX, startY, endX, endY;
+    getVisibleTileRange(screenWidth, screenHeight, cameraPos, startX, startY, endX, endY);
+    drawLayerSprites(m_layers[layer], shader, screenWidth, screenHeight, startX, startY, endX, endY);
+}
+
+void Tilemap::rebuildChunk(Layer& layer, Chunk& chunk, int chunkX, int chunkY, SpriteBatch& batch) {
+    chunk.dirty = false;
+    m_chunkRebuilds++;
     
-    for (int y = 0; y < m_height; y++) {
-        for (int x = 0; x < m_width; x++) {
-            const Tile& tile = m_tiles[coordToIndex(x, y)];
-            if (tile.tileId < 0 || tile.layer != layer) continue;
+    int startX = chunkX * CHUNK_SIZE;
+    int startY = chunkY * CHUNK_SIZE;
+    int endX = std::min(m_width, startX + CHUNK_SIZE);
+    int endY = std::min(m_height, startY + CHUNK_SIZE);
+    float tileWidth = static_cast<float>(m_tileWidth);
+    float tileHeight = static_cast<float>(m_tileHeight);
+    
+    std::vector<SpriteVertex> vertices;
+    vertices.reserve(CHUNK_SIZE * CHUNK_SIZE * 4);
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            int tileId = packedTileId(layer.tiles[coordToIndex(x, y)]);
+            if (tileId < 0) continue; // Empty tile
             
             float u0, v0, u1, v1;
-            m_tileset->getTileUV(tile.tileId, u0, v0, u1, v1);
+            m_tileset->getTileUV(tileId, u0, v0, u1, v1);
             
             float worldX, worldY;
             tileToWorld(x, y, worldX, worldY);
-            tileSprite.setPosition(Vector2(worldX, worldY));
             
-            tileSprite.draw(shader, screenWidth, screenHeight);
+            SpriteBatch::appendQuad(vertices, worldX, worldY, tileWidth, tileHeight, u0, v0, u1, v1);
+        }
+    }
+    
+    chunk.quadCount = static_cast<int>(vertices.size() / 4);
+    if (chunk.quadCount == 0) return; // Buffers, if any, are kept for when tiles come back
+    
+    RenderBackend& backend = RenderBackend::getActive();
+    if (chunk.vbo == 0) {
+        chunk.vbo = backend.createBuffer();
+        chunk.vao = batch.createStaticVertexArray(chunk.vbo);
+    }
+    
+    size_t bytes = vertices.size() * sizeof(SpriteVertex);
+    backend.bindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    if (bytes > chunk.capacity) {
+        backend.bufferData(GL_ARRAY_BUFFER, bytes, vertices.data(), GL_STATIC_DRAW);
+        chunk.capacity = bytes;
+    } else {
+        backend.bufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
+    }
+}
+
+bool Tilemap::prepareTileset() {
+    if (!m_tileset || !m_tileset->getTexture()) return false;
+    
+    Texture* texture = m_tileset->getTexture();
+    
+    // UVs are baked into the chunks; a texture that changed size (an async
+    // load replacing its placeholder) needs a new grid and new chunks
+    if (texture->getWidth() != m_builtTextureWidth || texture->getHeight() != m_builtTextureHeight) {
+        m_builtTextureWidth = texture->getWidth();
+        m_builtTextureHeight = texture->getHeight();
+        m_tileset->calculateGrid();
+        for (Layer& layer : m_layers) {
+            markChunksDirty(layer, 0, 0, m_width, m_height);
+        }
+    }
+    return m_tileset->getColumns() > 0;
+}
+
+bool Tilemap::prepareChunks(SpriteBatch& batch) {
+    if (!m_tileset || !m_tileset->getTexture()) return false;
+    
+    // Chunk VAOs reference the index buffer of the batch they were built with
+    if (&batch != m_chunkBatch) {
+        for (Layer& layer : m_layers) {
+            resetChunks(layer);
+        }
+        m_chunkBatch = &batch;
+    }
+    return prepareTileset();
+}
+
+void Tilemap::drawLayerChunks(Layer& layer, SpriteBatch& batch, int startX, int startY, int endX, int endY) {
+    if (startX >= endX || startY >= endY) return;
+    
+    Texture* texture = m_tileset->getTexture();
+    for (int cy = startY / CHUNK_SIZE; cy <= (endY - 1) / CHUNK_SIZE; cy++) {
+        for (int cx = startX / CHUNK_SIZE; cx <= (endX - 1) / CHUNK_SIZE; cx++) {
+            Chunk& chunk = layer.chunks[cy * m_chunksX + cx];
+            if (chunk.dirty) {
+                rebuildChunk(layer, chunk, cx, cy, batch);
+            }
+            if (chunk.quadCount > 0) {
+                batch.drawStatic(texture, chunk.vao, chunk.quadCount);
+            }
         }
     }
 }
 
+void Tilemap::render(SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos) {
+    if (!prepareChunks(batch)) return;
+    
+    // Calculate visible tile range
+    int startX, startY, endX, endY;
+    getVisibleTileRange(screenWidth, screenHeight, cameraPos, startX, startY, endX, endY);
+    
+    for (Layer& layer : m_layers) {
+        drawLayerChunks(layer, batch, startX, startY, endX, endY);
+    }
+}
+
+void Tilemap::renderLayer(int layer, SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos) {
+    if (layer < 0 || layer >= static_cast<int>(m_layers.size())) return;
+    if (!prepareChunks(batch)) return;
+    
+    int startX, startY, endX, endY;
+    getVisibleTileRange(screenWidth, screenHeight, cameraPos, startX, startY, endX, endY);
+    drawLayerChunks(m_layers[layer], batch, startX, startY, endX, endY);
+}
+
 void Tilemap::fill(const Tile& tile) {
-    std::fill(m_tiles.begin(), m_tiles.end(), tile);
+    for (int i = 0; i < static_cast<int>(m_layers.size()); i++) {
+        std::fill(m_layers[i].tiles.begin(), m_layers[i].tiles.end(), packTile(Tile(-1, false, i)));
+        markChunksDirty(m_layers[i], 0, 0, m_width, m_height);
+    }
+    
+    Layer* layer = ensureLayer(tile.layer);
+    if (layer) {
+        std::fill(layer->tiles.begin(), layer->tiles.end(), packTile(tile));
+    }
+    updateSolidity(0, 0, m_width, m_height);
+    
+    notifySolidityChanged(0, 0, m_width, m_height);
 }
 
 void Tilemap::fillRect(int x, int y, int width, int height, const Tile& tile) {
-    for (int ty = y; ty < y + height && ty < m_height; ty++) {
-        for (int tx = x; tx < x + width && tx < m_width; tx++) {
-            setTile(tx, ty, tile);
-        }
+    int startX = std::max(0, x);
+    int startY = std::max(0, y);
+    int endX = std::min(m_width, x + width);
+    int endY = std::min(m_height, y + height);
+    if (startX >= endX || startY >= endY) return;
+    
+    Layer* layer = ensureLayer(tile.layer);
+    if (!layer) return;
+    
+    for (int ty = startY; ty < endY; ty++) {
+        std::fill_n(layer->tiles.begin() + coordToIndex(startX, ty), endX - startX, packTile(tile));
     }
+    markChunksDirty(*layer, startX, startY, endX - startX, endY - startY);
+    updateSolidity(startX, startY, endX - startX, endY - startY);
+    
+    // One notification for the whole rectangle
+    notifySolidityChanged(startX, startY, endX - startX, endY - startY);
 }
 
 void Tilemap::fillLayer(int layer, const Tile& tile) {
-    for (auto& t : m_tiles) {
-        if (t.layer == layer) {
-            t = tile;
+    Layer* target = ensureLayer(layer);
+    if (!target) return;
+    
+    Tile filled = tile;
+    filled.layer = layer;
+    PackedTile packed = packTile(filled);
+    for (int y = 0; y < m_height; y++) {
+        for (int x = 0; x < m_width; x++) {
+            PackedTile& t = target->tiles[coordToIndex(x, y)];
+            if (packedTileId(t) != packedTileId(packed)) {
+                target->chunks[(y / CHUNK_SIZE) * m_chunksX + x / CHUNK_SIZE].dirty = true;
+            }
+            t = packed;
         }
     }
+    updateSolidity(0, 0, m_width, m_height);
+    
+    notifySolidityChanged(0, 0, m_width, m_height);
 }
 
 bool Tilemap::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         std::cerr << "Tilemap: Failed to open file: " << filename << std::endl;
         return false;
     }
+    size_t fileSize = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+    
+    unsigned char headerBytes[HEADER_FIELDS * 4];
+    uint32_t header[HEADER_FIELDS] = {};
+    if (file.read(reinterpret_cast<char*>(headerBytes), sizeof(headerBytes))) {
+        decodeLittleEndian32(headerBytes, HEADER_FIELDS, header);
+    }
+    
+    if (header[FIELD_MAGIC] != TILEMAP_MAGIC) {
+        // Unversioned files start straight with the width
+        file.clear();
+        file.seekg(0);
+        return loadLegacy(file, fileSize, filename);
+    }
+    
+    if (header[FIELD_VERSION] != TILEMAP_FILE_VERSION) {
+        std::cerr << "Tilemap: Unsupported version " << header[FIELD_VERSION] << " in " << filename << std::endl;
+        return false;
+    }
     
-    // Read header
-    file.read(reinterpret_cast<char*>(&m_width), sizeof(int));
-    file.read(reinterpret_cast<char*>(&m_height), sizeof(int));
-    file.read(reinterpret_cast<char*>(&m_tileWidth), sizeof(int));
-    file.read(reinterpret_cast<char*>(&m_tileHeight), sizeof(int));
+    int width = static_cast<int>(header[FIELD_WIDTH]);
+    int height = static_cast<int>(header[FIELD_HEIGHT]);
+    int tileWidth = static_cast<int>(header[FIELD_TILE_WIDTH]);
+    int tileHeight = static_cast<int>(header[FIELD_TILE_HEIGHT]);
+    int layerCount = static_cast<int>(header[FIELD_LAYER_COUNT]);
+    if (!isValidMapSize(width, height, tileWidth, tileHeight) || layerCount <= 0 || layerCount > MAX_LAYERS ||
+        static_cast<uint64_t>(fileSize) != sizeof(headerBytes) + static_cast<uint64_t>(width) * height * 4 * layerCount) {
+        std::cerr << "Tilemap: Invalid header in " << filename << std::endl;
+        return false;
+    }
+    size_t cells = static_cast<size_t>(width) * height;
     
-    // Read tiles
-    m_tiles.resize(m_width * m_height);
-    file.read(reinterpret_cast<char*>(m_tiles.data()), m_tiles.size() * sizeof(Tile));
+    m_width = width;
+    m_height = height;
+    m_tileWidth = tileWidth;
+    m_tileHeight = tileHeight;
+    resetLayers(layerCount);
     
+    // Read straight into the grid, then decoded in place
+    for (Layer& layer : m_layers) {
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(layer.tiles.data());
+        file.read(reinterpret_cast<char*>(bytes), cells * 4);
+        decodeLittleEndian32(bytes, cells, layer.tiles.data());
+    }
+    
+    if (!file) {
+        std::cerr << "Tilemap: Truncated data in " << filename << std::endl;
+        resetLayers(1);
+        return false;
+    }
     file.close();
-    std::cout << "Tilemap: Loaded from " << filename << std::endl;
+    
+    updateSolidity(0, 0, m_width, m_height);
+    notifySolidityChanged(0, 0, m_width, m_height);
+    
+    std::cout << "Tilemap: Loaded from " << filename << " (" << m_layers.size() << " layers)" << std::endl;
+    return true;
+}
+
+bool Tilemap::loadLegacy(std::istream& file, size_t fileSize, const std::string& filename) {
+    // Native-endian ints and raw Tile structs, as written before the versioned format
+    int header[4] = { 0, 0, 0, 0 };
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || !isValidMapSize(header[0], header[1], header[2], header[3])) {
+        std::cerr << "Tilemap: Invalid header in " << filename << std::endl;
+        return false;
+    }
+    
+    // One grid whose tiles carry their own layer
+    uint64_t gridBytes = static_cast<uint64_t>(header[0]) * header[1] * sizeof(Tile);
+    if (static_cast<uint64_t>(fileSize) - sizeof(header) != gridBytes) {
+        std::cerr << "Tilemap: Unrecognized layout in " << filename << std::endl;
+        return false;
+    }
+    
+    m_width = header[0];
+    m_height = header[1];
+    m_tileWidth = header[2];
+    m_tileHeight = header[3];
+    resetLayers(1);
+    
+    std::vector<Tile> tiles(static_cast<size_t>(m_width) * m_height);
+    file.read(reinterpret_cast<char*>(tiles.data()), static_cast<std::streamsize>(gridBytes));
+    for (size_t i = 0; i < tiles.size(); i++) {
+        if (tiles[i].tileId < 0 && !tiles[i].solid) continue;
+        Layer* layer = ensureLayer(tiles[i].layer);
+        if (layer) layer->tiles[i] = packTile(tiles[i]);
+    }
+    
+    updateSolidity(0, 0, m_width, m_height);
+    notifySolidityChanged(0, 0, m_width, m_height);
+    
+    std::cout << "Tilemap: Loaded unversioned map " << filename << " (" << m_layers.size() << " layers)" << std::endl;
     return true;
 }
 
@@ -213,14 +706,32 @@ bool Tilemap::saveToFile(const std::string& filename) const {
     }
     
     // Write header
-    file.write(reinterpret_cast<const char*>(&m_width), sizeof(int));
-    file.write(reinterpret_cast<const char*>(&m_height), sizeof(int));
-    file.write(reinterpret_cast<const char*>(&m_tileWidth), sizeof(int));
-    file.write(reinterpret_cast<const char*>(&m_tileHeight), sizeof(int));
+    uint32_t header[HEADER_FIELDS];
+    header[FIELD_MAGIC] = TILEMAP_MAGIC;
+    header[FIELD_VERSION] = TILEMAP_FILE_VERSION;
+    header[FIELD_WIDTH] = static_cast<uint32_t>(m_width);
+    header[FIELD_HEIGHT] = static_cast<uint32_t>(m_height);
+    header[FIELD_TILE_WIDTH] = static_cast<uint32_t>(m_tileWidth);
+    header[FIELD_TILE_HEIGHT] = static_cast<uint32_t>(m_tileHeight);
+    header[FIELD_LAYER_COUNT] = static_cast<uint32_t>(m_layers.size());
     
-    // Write tiles
-    file.write(reinterpret_cast<const char*>(m_tiles.data()), m_tiles.size() * sizeof(Tile));
+    unsigned char headerBytes[HEADER_FIELDS * 4];
+    encodeLittleEndian32(header, HEADER_FIELDS, headerBytes);
+    file.write(reinterpret_cast<const char*>(headerBytes), sizeof(headerBytes));
     
+    // Write layers, a row at a time
+    std::vector<unsigned char> row(static_cast<size_t>(m_width) * 4);
+    for (const Layer& layer : m_layers) {
+        for (int y = 0; y < m_height; y++) {
+            encodeLittleEndian32(&layer.tiles[coordToIndex(0, y)], m_width, row.data());
+            file.write(reinterpret_cast<const char*>(row.data()), row.size());
+        }
+    }
+    
+    if (!file) {
+        std::cerr << "Tilemap: Failed to write " << filename << std::endl;
+        return false;
+    }
     file.close();
     std::cout << "Tilemap: Saved to " << filename << std::endl;
     return true;
@@ -233,41 +744,78 @@ bool Tilemap::saveToFile(const std::string& filename) const {
 TilemapManager::TilemapManager() {
 }
 
-Tilemap* TilemapManager::addLayer(const std::string& name, int width, int height, int tileWidth, int tileHeight) {
-    auto tilemap = std::make_unique<Tilemap>(width, height, tileWidth, tileHeight);
-    Tilemap* ptr = tilemap.get();
-    m_layers[name] = std::move(tilemap);
-    m_layerOrder.push_back(name);
-    return ptr;
+void TilemapManager::reindex() {
+    for (size_t i = 0; i < m_layers.size(); i++) {
+        m_slots[m_layers[i].handle] = static_cast<int>(i);
+    }
+}
+
+TilemapHandle TilemapManager::addLayer(const std::string& name, int width, int height, int tileWidth, int tileHeight) {
+    // A name maps to one layer; adding it again replaces the old one
+    removeLayer(name);
+    
+    TilemapHandle handle = static_cast<TilemapHandle>(m_slots.size());
+    m_slots.push_back(static_cast<int>(m_layers.size()));
+    m_layers.push_back({ handle, name, std::make_unique<Tilemap>(width, height, tileWidth, tileHeight) });
+    return handle;
+}
+
+Tilemap* TilemapManager::getLayer(TilemapHandle handle) {
+    if (handle < 0 || handle >= static_cast<TilemapHandle>(m_slots.size())) return nullptr;
+    
+    int index = m_slots[handle];
+    return index >= 0 ? m_layers[index].tilemap.get() : nullptr;
 }
 
 Tilemap* TilemapManager::getLayer(const std::string& name) {
-    auto it = m_layers.find(name);
-    if (it != m_layers.end()) {
-        return it->second.get();
+    return getLayer(findLayer(name));
+}
+
+TilemapHandle TilemapManager::findLayer(const std::string& name) const {
+    for (const Entry& entry : m_layers) {
+        if (entry.name == name) return entry.handle;
     }
-    return nullptr;
+    return INVALID_TILEMAP_HANDLE;
+}
+
+void TilemapManager::removeLayer(TilemapHandle handle) {
+    if (!getLayer(handle)) return;
+    
+    m_layers.erase(m_layers.begin() + m_slots[handle]);
+    m_slots[handle] = -1;
+    reindex();
 }
 
 void TilemapManager::removeLayer(const std::string& name) {
-    m_layers.erase(name);
-    m_layerOrder.erase(
-        std::remove(m_layerOrder.begin(), m_layerOrder.end(), name),
-        m_layerOrder.end()
-    );
+    removeLayer(findLayer(name));
 }
 
 void TilemapManager::clear() {
     m_layers.clear();
-    m_layerOrder.clear();
+    m_slots.clear();
+}
+
+void TilemapManager::setLayerOrder(TilemapHandle handle, int position) {
+    if (!getLayer(handle)) return;
+    
+    int index = m_slots[handle];
+    position = std::max(0, std::min(position, static_cast<int>(m_layers.size()) - 1));
+    if (position == index) return;
+    
+    Entry entry = std::move(m_layers[index]);
+    m_layers.erase(m_layers.begin() + index);
+    m_layers.insert(m_layers.begin() + position, std::move(entry));
+    reindex();
 }
 
 void TilemapManager::renderAll(Shader* shader, int screenWidth, int screenHeight, const Vector2& cameraPos) {
-    // Render in layer order
-    for (const auto& layerName : m_layerOrder) {
-        auto it = m_layers.find(layerName);
-        if (it != m_layers.end()) {
-            it->second->render(shader, screenWidth, screenHeight, cameraPos);
-        }
+    for (Entry& entry : m_layers) {
+        entry.tilemap->render(shader, screenWidth, screenHeight, cameraPos);
+    }
+}
+
+void TilemapManager::renderAll(SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos) {
+    for (Entry& entry : m_layers) {
+        entry.tilemap->render(batch, screenWidth, screenHeight, cameraPos);
     }
 }
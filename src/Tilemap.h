@@ -4,9 +4,16 @@
 #include "Sprite.h"
 #include "Shader.h"
 #include "Texture.h"
+#include <GL/glew.h>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
+#include <functional>
+#include <iosfwd>
+#include <cstdint>
+
+class SpriteBatch;
 
 // Tile data
 struct Tile {
@@ -19,6 +26,30 @@ struct Tile {
         : tileId(id), solid(isSolid), layer(l) {}
 };
 
+// Tile as a Tilemap stores it: bits 0-23 hold tileId + 1 (0 = empty),
+// bit 24 the solid flag, bits 28-31 the layer. Ids above MAX_PACKED_TILE_ID
+// don't fit and pack as empty.
+using PackedTile = uint32_t;
+const int MAX_PACKED_TILE_ID = 0xFFFFFE;
+const PackedTile PACKED_TILE_SOLID = 1u << 24;
+
+inline PackedTile packTile(const Tile& tile) {
+    uint32_t id = (tile.tileId >= 0 && tile.tileId <= MAX_PACKED_TILE_ID) ? static_cast<uint32_t>(tile.tileId) + 1 : 0;
+    return id | (tile.solid ? PACKED_TILE_SOLID : 0) | (static_cast<uint32_t>(tile.layer & 0xF) << 28);
+}
+
+inline int packedTileId(PackedTile packed) { return static_cast<int>(packed & 0xFFFFFF) - 1; }
+inline bool isPackedTileSolid(PackedTile packed) { return (packed & PACKED_TILE_SOLID) != 0; }
+
+inline Tile unpackTile(PackedTile packed) {
+    return Tile(packedTileId(packed), isPackedTileSolid(packed), static_cast<int>(packed >> 28));
+}
+
+// 32-bit little-endian encoding for map files, independent of the host byte
+// order; decodeLittleEndian32 may decode in place (in == out)
+void encodeLittleEndian32(const uint32_t* values, size_t count, unsigned char* out);
+void decodeLittleEndian32(const unsigned char* in, size_t count, uint32_t* values);
+
 // Tileset - texture atlas for tiles
 class Tileset {
 public:
@@ -46,27 +77,44 @@ private:
     int m_rows;
 };
 
-// Tilemap - 2D grid of tiles
+// Tilemap - 2D grid of tiles, one dense grid per layer (Tile::layer), drawn in
+// ascending layer order from static vertex buffers of CHUNK_SIZE x CHUNK_SIZE tiles
 class Tilemap {
 public:
+    static const int CHUNK_SIZE = 32;
+    static const int MAX_LAYERS = 16;           // Fits PackedTile's layer bits
+    static const uint32_t TILEMAP_FILE_VERSION = 2; // 1 = unversioned raw Tile grid
+    
     Tilemap(int width, int height, int tileWidth, int tileHeight);
-    ~Tilemap() = default;
+    ~Tilemap();
+    Tilemap(const Tilemap&) = delete;
+    Tilemap& operator=(const Tilemap&) = delete;
     
-    // Tile access
+    // Tile access; setTile places the tile on tile.layer
     void setTile(int x, int y, const Tile& tile);
-    Tile getTile(int x, int y) const;
-    void clearTile(int x, int y);
+    Tile getTile(int x, int y) const;               // Top-most non-empty layer
+    Tile getTile(int x, int y, int layer) const;
+    void clearTile(int x, int y);                   // Every layer
+    void clearTile(int x, int y, int layer);
+    
+    // Layers 0..getLayerCount()-1 exist; higher ones are created on first use
+    int getLayerCount() const { return static_cast<int>(m_layers.size()); }
     
     // Tileset
-    void setTileset(Tileset* tileset) { m_tileset = tileset; }
+    void setTileset(Tileset* tileset);
     Tileset* getTileset() const { return m_tileset; }
     
     // Rendering
     void render(Shader* shader, int screenWidth, int screenHeight, const Vector2& cameraPos = Vector2(0, 0));
     void renderLayer(int layer, Shader* shader, int screenWidth, int screenHeight, const Vector2& cameraPos = Vector2(0, 0));
+    void render(SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos = Vector2(0, 0));
+    void renderLayer(int layer, SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos = Vector2(0, 0));
     
-    // Collision
+    // Collision (solid on any layer)
     bool isTileSolid(int x, int y) const;
+    // Bit i = tile (x + i, y) for i < count (at most 64); cells outside the map read as 0
+    uint64_t getSolidBits(int x, int y, int count = 64) const;
+    bool isAnySolid(int x, int y, int width, int height) const;
     bool worldToTile(float worldX, float worldY, int& tileX, int& tileY) const;
     void tileToWorld(int tileX, int tileY, float& worldX, float& worldY) const;
     
@@ -76,45 +124,128 @@ public:
     int getTileWidth() const { return m_tileWidth; }
     int getTileHeight() const { return m_tileHeight; }
     
-    // File I/O
+    // File I/O: versioned little-endian format (TILEMAP_FILE_VERSION);
+    // the unversioned native-endian files written before it still load
     bool loadFromFile(const std::string& filename);
     bool saveToFile(const std::string& filename) const;
     
     // Fill patterns
-    void fill(const Tile& tile);
+    void fill(const Tile& tile);                    // Clears every layer, then fills tile.layer
     void fillRect(int x, int y, int width, int height, const Tile& tile);
-    void fillLayer(int layer, const Tile& tile);
+    void fillLayer(int layer, const Tile& tile);    // The whole layer; tile.layer is ignored
+    
+    // Called with the tile rectangle (x, y, width, height) whenever solidity may have changed;
+    // add returns an id for remove (colliders, pathfinders, ... each register their own)
+    using SolidityCallback = std::function<void(int, int, int, int)>;
+    int addSolidityCallback(SolidityCallback callback);
+    void removeSolidityCallback(int id);
 
+    // Tile range [start, end) overlapping the view rect at cameraPos, clamped to the map
+    void getVisibleTileRange(int screenWidth, int screenHeight, const Vector2& cameraPos,
+                             int& startX, int& startY, int& endX, int& endY) const;
+    
+    // Chunk statistics (render(SpriteBatch&) path), over all layers
+    int getChunkCount() const;
+    int getChunkRebuildCount() const { return m_chunkRebuilds; }
+    
 private:
+    struct Chunk {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        int quadCount = 0;
+        size_t capacity = 0;    // Bytes allocated in vbo
+        bool dirty = true;      // A tile id changed; rebuilt on the next render
+    };
+    
+    // Created the first time a tile is put on the layer
+    struct Layer {
+        std::vector<PackedTile> tiles;  // m_width * m_height, row-major
+        std::vector<Chunk> chunks;      // m_chunksX * m_chunksY, row-major
+    };
+    
     int coordToIndex(int x, int y) const;
     bool isValidCoord(int x, int y) const;
     
+    // nullptr for a negative layer or one beyond MAX_LAYERS
+    Layer* ensureLayer(int layer);
+    void resetLayers(int layerCount);
+    
+    // Recomputes the solidity bits of a rectangle from the layers
+    void updateSolidity(int x, int y, int width, int height);
+    bool loadLegacy(std::istream& file, size_t fileSize, const std::string& filename);
+    void notifySolidityChanged(int x, int y, int width, int height);
+    
+    void resetChunks(Layer& layer);
+    void releaseChunks(Layer& layer);
+    void markChunksDirty(Layer& layer, int x, int y, int width, int height);
+    void rebuildChunk(Layer& layer, Chunk& chunk, int chunkX, int chunkY, SpriteBatch& batch);
+    // False while the tileset has no tile grid yet (e.g. its texture is still loading)
+    bool prepareTileset();
+    bool prepareChunks(SpriteBatch& batch);
+    void drawLayerChunks(Layer& layer, SpriteBatch& batch, int startX, int startY, int endX, int endY);
+    void drawLayerSprites(const Layer& layer, Shader* shader, int screenWidth, int screenHeight,
+                          int startX, int startY, int endX, int endY);
+    
     int m_width;
     int m_height;
     int m_tileWidth;
     int m_tileHeight;
-    std::vector<Tile> m_tiles;
+    int m_chunksX;
+    int m_chunksY;
+    std::vector<Layer> m_layers;    // Index = layer id, also the draw order
+    std::vector<uint64_t> m_solidBits;  // "Solid on any layer", one bit per cell, m_solidWords per row
+    int m_solidWords;
     Tileset* m_tileset;
+    std::vector<std::pair<int, SolidityCallback>> m_solidityCallbacks;
+    int m_nextSolidityCallbackId;
+    
+    SpriteBatch* m_chunkBatch;      // Chunk VAOs use this batch's index buffer
+    int m_builtTextureWidth;        // Tileset texture size the chunk UVs were built for
+    int m_builtTextureHeight;
+    int m_chunkRebuilds;
 };
 
+// Stable reference to a TilemapManager layer; survives removal of other layers
+using TilemapHandle = int;
+const TilemapHandle INVALID_TILEMAP_HANDLE = -1;
+
 // Tilemap manager for multiple layers
+// Layers live in a vector in draw order; handles index a slot table, so
+// per-frame access and renderAll never touch a string. Handles of removed
+// layers resolve to nullptr until clear().
 class TilemapManager {
 public:
     TilemapManager();
     ~TilemapManager() = default;
     
-    Tilemap* addLayer(const std::string& name, int width, int height, int tileWidth, int tileHeight);
+    // Appended on top of the existing layers
+    TilemapHandle addLayer(const std::string& name, int width, int height, int tileWidth, int tileHeight);
+    Tilemap* getLayer(TilemapHandle handle);
     Tilemap* getLayer(const std::string& name);
+    TilemapHandle findLayer(const std::string& name) const;
+    void removeLayer(TilemapHandle handle);
     void removeLayer(const std::string& name);
     void clear();
     
+    // Moves a layer to position in the draw order (0 = bottom)
+    void setLayerOrder(TilemapHandle handle, int position);
+    
     void renderAll(Shader* shader, int screenWidth, int screenHeight, const Vector2& cameraPos = Vector2(0, 0));
+    void renderAll(SpriteBatch& batch, int screenWidth, int screenHeight, const Vector2& cameraPos = Vector2(0, 0));
     
     size_t getLayerCount() const { return m_layers.size(); }
 
 private:
-    std::unordered_map<std::string, std::unique_ptr<Tilemap>> m_layers;
-    std::vector<std::string> m_layerOrder; // For rendering order
+    struct Entry {
+        TilemapHandle handle;
+        std::string name;
+        std::unique_ptr<Tilemap> tilemap;
+    };
+    
+    void reindex();
+    
+    std::vector<Entry> m_layers;        // Draw order
+    std::vector<int> m_slots;           // Handle -> index in m_layers, -1 once removed
 };
 
 #endif // OMEGA_TILEMAP_H
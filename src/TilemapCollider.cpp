@@ -0,0 +1,239 @@
+#include "TilemapCollider.h"
+#include <iostream>
+#include <algorithm>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+// Index of the lowest set bit; value must not be 0
+int countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+} // namespace
+
+TilemapCollider::TilemapCollider(PhysicsWorld* world, Tilemap* tilemap, int regionSize)
+    : m_world(world)
+    , m_tilemap(tilemap)
+    , m_regionSize(std::max(1, regionSize))
+    , m_regionsX(0)
+    , m_regionsY(0)
+    , m_scale(1.0f)
+    , m_solidityCallbackId(0) {
+    
+    m_shapeTemplate.type = ShapeType::Box;
+    
+    if (m_tilemap) {
+        m_solidityCallbackId = m_tilemap->addSolidityCallback([this](int x, int y, int width, int height) {
+            markDirty(x, y, width, height);
+        });
+    }
+    
+    build();
+}
+
+TilemapCollider::~TilemapCollider() {
+    if (m_tilemap) {
+        m_tilemap->removeSolidityCallback(m_solidityCallbackId);
+    }
+    clear();
+}
+
+void TilemapCollider::build() {
+    clear();
+    if (!m_world || !m_tilemap) return;
+    
+    m_regionsX = (m_tilemap->getWidth() + m_regionSize - 1) / m_regionSize;
+    m_regionsY = (m_tilemap->getHeight() + m_regionSize - 1) / m_regionSize;
+    m_regions.resize(m_regionsX * m_regionsY);
+    
+    for (int ry = 0; ry < m_regionsY; ry++) {
+        for (int rx = 0; rx < m_regionsX; rx++) {
+            rebuildRegion(rx, ry);
+        }
+    }
+    
+    std::cout << "TilemapCollider: Built " << getBodyCount() << " static bodies for "
+              << m_tilemap->getWidth() << "x" << m_tilemap->getHeight() << " tiles" << std::endl;
+}
+
+void TilemapCollider::clear() {
+    for (auto& region : m_regions) {
+        destroyRegion(region);
+    }
+    m_regions.clear();
+    m_regionsX = 0;
+    m_regionsY = 0;
+}
+
+void TilemapCollider::markDirty(int x, int y, int width, int height) {
+    if (!m_tilemap) return;
+    
+    // A resized map (e.g. loadFromFile) invalidates the region grid
+    int regionsX = (m_tilemap->getWidth() + m_regionSize - 1) / m_regionSize;
+    int regionsY = (m_tilemap->getHeight() + m_regionSize - 1) / m_regionSize;
+    if (regionsX != m_regionsX || regionsY != m_regionsY) {
+        for (auto& region : m_regions) {
+            destroyRegion(region);
+        }
+        m_regionsX = regionsX;
+        m_regionsY = regionsY;
+        m_regions.assign(m_regionsX * m_regionsY, Region());
+        for (auto& region : m_regions) {
+            region.dirty = true;
+        }
+        return;
+    }
+    
+    int startX = std::max(0, x / m_regionSize);
+    int startY = std::max(0, y / m_regionSize);
+    int endX = std::min(m_regionsX - 1, (x + width - 1) / m_regionSize);
+    int endY = std::min(m_regionsY - 1, (y + height - 1) / m_regionSize);
+    
+    for (int ry = startY; ry <= endY; ry++) {
+        for (int rx = startX; rx <= endX; rx++) {
+            m_regions[ry * m_regionsX + rx].dirty = true;
+        }
+    }
+}
+
+void TilemapCollider::update() {
+    for (int ry = 0; ry < m_regionsY; ry++) {
+        for (int rx = 0; rx < m_regionsX; rx++) {
+            if (m_regions[ry * m_regionsX + rx].dirty) {
+                rebuildRegion(rx, ry);
+            }
+        }
+    }
+}
+
+void TilemapCollider::rebuildRegion(int regionX, int regionY) {
+    Region& region = m_regions[regionY * m_regionsX + regionX];
+    destroyRegion(region);
+    region.dirty = false;
+    
+    int x = regionX * m_regionSize;
+    int y = regionY * m_regionSize;
+    int width = std::min(m_regionSize, m_tilemap->getWidth() - x);
+    int height = std::min(m_regionSize, m_tilemap->getHeight() - y);
+    
+    m_scratchRects.clear();
+    mergeSolidTiles(*m_tilemap, x, y, width, height, m_scratchRects);
+    
+    float tileW = m_tilemap->getTileWidth() * m_scale;
+    float tileH = m_tilemap->getTileHeight() * m_scale;
+    
+    for (const TileRect& rect : m_scratchRects) {
+        PhysicsBodyDef bodyDef;
+        bodyDef.type = BodyType::Static;
+        bodyDef.position = Vector2((rect.x + rect.width * 0.5f) * tileW,
+                                   (rect.y + rect.height * 0.5f) * tileH);
+        
+        PhysicsShapeDef shapeDef = m_shapeTemplate;
+        shapeDef.type = ShapeType::Box;
+        shapeDef.size = Vector2(rect.width * tileW, rect.height * tileH);
+        
+        PhysicsBody* body = m_world->createBody(bodyDef);
+        m_world->addShape(body, shapeDef);
+        region.bodies.push_back(body);
+    }
+}
+
+void TilemapCollider::destroyRegion(Region& region) {
+    if (m_world) {
+        for (PhysicsBody* body : region.bodies) {
+            m_world->destroyBody(body);
+        }
+    }
+    region.bodies.clear();
+}
+
+void TilemapCollider::mergeSolidTiles(const Tilemap& tilemap, int x, int y, int width, int height, std::vector<TileRect>& out) {
+    if (width <= 0 || height <= 0) return;
+    
+    // Solid tiles not yet covered by a rectangle, copied out of the tilemap's
+    // solidity bitset so every test below handles 64 tiles per word
+    int words = (width + 63) / 64;
+    std::vector<uint64_t> open(static_cast<size_t>(words) * height);
+    for (int ty = 0; ty < height; ty++) {
+        for (int w = 0; w < words; w++) {
+            open[ty * words + w] = tilemap.getSolidBits(x + w * 64, y + ty, std::min(64, width - w * 64));
+        }
+    }
+    
+    // Is every tile of [tx, tx + count) in row ty open? Clears them when take is set
+    auto spanOpen = [&](int tx, int ty, int count, bool take) {
+        uint64_t* row = &open[ty * words];
+        for (int i = tx; i < tx + count; ) {
+            int bit = i % 64;
+            int n = std::min(64 - bit, tx + count - i);
+            uint64_t mask = (n == 64 ? ~0ULL : ((1ULL << n) - 1)) << bit;
+            if (take) {
+                row[i / 64] &= ~mask;
+            } else if ((row[i / 64] & mask) != mask) {
+                return false;
+            }
+            i += n;
+        }
+        return true;
+    };
+    
+    // Row-major greedy merge: grow each rectangle right, then down
+    for (int ty = 0; ty < height; ty++) {
+        for (int w = 0; w < words; w++) {
+            while (open[ty * words + w] != 0) {
+                int tx = w * 64 + countTrailingZeros(open[ty * words + w]);
+                
+                // Run of open tiles, a word at a time
+                int rectW = 0;
+                while (tx + rectW < width) {
+                    int bit = (tx + rectW) % 64;
+                    uint64_t run = ~(open[ty * words + (tx + rectW) / 64] >> bit);
+                    int length = run == 0 ? 64 - bit : std::min(64 - bit, countTrailingZeros(run));
+                    rectW += std::min(length, width - tx - rectW);
+                    if (length < 64 - bit) break;
+                }
+                
+                int rectH = 1;
+                while (ty + rectH < height && spanOpen(tx, ty + rectH, rectW, false)) {
+                    rectH++;
+                }
+                
+                for (int j = 0; j < rectH; j++) {
+                    spanOpen(tx, ty + j, rectW, true);
+                }
+                
+                TileRect rect;
+                rect.x = x + tx;
+                rect.y = y + ty;
+                rect.width = rectW;
+                rect.height = rectH;
+                out.push_back(rect);
+            }
+        }
+    }
+}
+
+size_t TilemapCollider::getBodyCount() const {
+    size_t count = 0;
+    for (const auto& region : m_regions) {
+        count += region.bodies.size();
+    }
+    return count;
+}
+
+size_t TilemapCollider::getDirtyRegionCount() const {
+    size_t count = 0;
+    for (const auto& region : m_regions) {
+        if (region.dirty) count++;
+    }
+    return count;
+}
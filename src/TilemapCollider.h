@@ -0,0 +1,67 @@
+#ifndef OMEGA_TILEMAP_COLLIDER_H
+#define OMEGA_TILEMAP_COLLIDER_H
+
+#include "Tilemap.h"
+#include "Physics.h"
+#include <vector>
+
+// Solid tile rectangle, in tile coordinates
+struct TileRect {
+    int x, y;
+    int width, height;
+};
+
+// Builds static PhysicsWorld geometry for a Tilemap.
+// Solid tiles are greedy-merged into rectangles, one static box body per rectangle.
+// The map is split into fixed-size regions that are merged independently, so a
+// solidity change only rebuilds the regions it touches.
+class TilemapCollider {
+public:
+    TilemapCollider(PhysicsWorld* world, Tilemap* tilemap, int regionSize = 16);
+    ~TilemapCollider();
+    TilemapCollider(const TilemapCollider&) = delete;
+    TilemapCollider& operator=(const TilemapCollider&) = delete;
+    
+    // Build everything (also called on construction)
+    void build();
+    void clear();
+    
+    // Rebuild regions marked dirty by Tilemap changes (call once per frame)
+    void update();
+    void markDirty(int x, int y, int width, int height);
+    
+    // World units per pixel (tile sizes are in pixels)
+    void setScale(float scale) { m_scale = scale; }
+    float getScale() const { return m_scale; }
+    
+    // Friction, restitution and filter bits used for the generated shapes
+    void setShapeTemplate(const PhysicsShapeDef& shapeDef) { m_shapeTemplate = shapeDef; }
+    
+    // Greedy merge of solid tiles inside a rectangle
+    static void mergeSolidTiles(const Tilemap& tilemap, int x, int y, int width, int height, std::vector<TileRect>& out);
+    
+    size_t getBodyCount() const;
+    size_t getDirtyRegionCount() const;
+
+private:
+    struct Region {
+        std::vector<PhysicsBody*> bodies;
+        bool dirty = false;
+    };
+    
+    void rebuildRegion(int regionX, int regionY);
+    void destroyRegion(Region& region);
+    
+    PhysicsWorld* m_world;
+    Tilemap* m_tilemap;
+    int m_regionSize;
+    int m_regionsX;
+    int m_regionsY;
+    float m_scale;
+    int m_solidityCallbackId;
+    PhysicsShapeDef m_shapeTemplate;
+    std::vector<Region> m_regions;
+    std::vector<TileRect> m_scratchRects;
+};
+
+#endif // OMEGA_TILEMAP_COLLIDER_H
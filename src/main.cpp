@@ -1,6 +1,9 @@
 #include <SDL.h>
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
 #include "Renderer.h"
 #include "Shader.h"
 #include "Texture.h"
@@ -52,6 +55,22 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    // Presentation: --present-mode vsync|adaptive|immediate, --fps <cap>, --late-input
+    FramePacer& pacer = renderer.getFramePacer();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--present-mode" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "adaptive") renderer.setPresentMode(PresentMode::AdaptiveVSync);
+            else if (mode == "immediate") renderer.setPresentMode(PresentMode::Immediate);
+            else renderer.setPresentMode(PresentMode::VSync);
+        } else if (arg == "--fps" && i + 1 < argc) {
+            pacer.setTargetFrameRate(std::atof(argv[++i]));
+        } else if (arg == "--late-input") {
+            pacer.setLateInputSampling(true);
+        }
+    }
+
     // Get Asset Manager instance
     AssetManager& assets = AssetManager::getInstance();
 
@@ -63,13 +82,14 @@ int main(int argc, char** argv) {
         
         uniform vec2 position;
         uniform vec2 size;
+        uniform vec4 uvRect; // u0, v0, u1, v1
         
         out vec2 TexCoord;
         
         void main() {
             vec2 scaledPos = aPos * size + position;
             gl_Position = vec4(scaledPos, 0.0, 1.0);
-            TexCoord = aTexCoord;
+            TexCoord = mix(uvRect.xy, uvRect.zw, aTexCoord);
         }
     )";
     
@@ -126,8 +146,7 @@ int main(int argc, char** argv) {
     sceneManager.changeScene("Menu");
 
     bool running = true;
-    SDL_Event event;
-    float deltaTime = 0.016f; // ~60fps
+    float deltaTime = 0.016f; // First frame; measured from then on
 
     std::cout << "=== omega-engine Complete Demo ===" << std::endl;
     std::cout << "Controls:" << std::endl;
@@ -143,10 +162,12 @@ int main(int argc, char** argv) {
     while (running) {
         Input& input = Input::getInstance();
         
-        while (SDL_PollEvent(&event)) {
+        // Frame cap and late sampling wait before input is read, not after present
+        pacer.beginFrame();
+        pacer.pollEvents([&](const SDL_Event& event) {
             if (event.type == SDL_QUIT) running = false;
             input.update(event);
-        }
+        });
 
         // Global escape to quit (in menu)
         if (input.isKeyPressed(KeyCode::Escape)) {
@@ -166,10 +187,16 @@ int main(int argc, char** argv) {
         renderer.present();
         input.endFrame();
 
-        SDL_Delay(16); // ~60fps
+        // Capped at 100ms so a hitch doesn't turn into a huge simulation step
+        if (pacer.getStats().frameTimeMs > 0.0) {
+            deltaTime = static_cast<float>(std::min(pacer.getStats().frameTimeMs, 100.0) / 1000.0);
+        }
     }
 
-    std::cout << "\nShutting down..." << std::endl;
+    const FramePacingStats& pacing = pacer.getStats();
+    std::cout << "\nInput to present: " << pacing.getAverageInputLatencyMs() << " ms avg, "
+              << pacing.maxInputLatencyMs << " ms max, " << pacing.missedDeadlines << " missed frames" << std::endl;
+    std::cout << "Shutting down..." << std::endl;
     
     // Clean up audio
     audio.shutdown();
@@ -236,13 +263,14 @@ int main(int argc, char** argv) {
         
         uniform vec2 position;
         uniform vec2 size;
+        uniform vec4 uvRect; // u0, v0, u1, v1
         
         out vec2 TexCoord;
         
         void main() {
             vec2 scaledPos = aPos * size + position;
             gl_Position = vec4(scaledPos, 0.0, 1.0);
-            TexCoord = aTexCoord;
+            TexCoord = mix(uvRect.xy, uvRect.zw, aTexCoord);
         }
     )";
     
@@ -0,0 +1,65 @@
+// Command recorder camera test
+// A command list that never calls setCamera draws in screen space, even when
+// the list executed before it left a camera set; the camera of one list must
+// not leak into the next. Runs against the Null render backend.
+
+#include "CommandRecorder.h"
+#include "Camera.h"
+#include "RenderBackend.h"
+#include "TestHarness.h"
+
+namespace {
+
+// Screen space maps pixel 0 to NDC -1; a camera shifts the projection's translation
+bool isScreenSpace(const SpriteBatch& batch) {
+    return batch.getProjection()[12] == -1.0f && batch.getProjection()[13] == 1.0f;
+}
+
+void drawQuad(CommandList& list) {
+    RenderCommand command;
+    command.size = Vector2(8.0f, 8.0f);
+    list.drawSprite(command);
+}
+
+} // namespace
+
+int main() {
+    RenderBackend::select(RenderBackendType::Null);
+    RenderBackend& backend = RenderBackend::getActive();
+
+    SpriteBatch batch;
+    check(batch.initialize(), "batch initialized");
+
+    Camera camera(800.0f, 600.0f);
+    camera.setPosition(Vector2(1000.0f, 1000.0f));
+    check(camera.getViewOffset().x != 0.0f, "camera is away from the origin");
+
+    CommandRecorder recorder(1);
+    RenderQueue queue;
+
+    // World list first, then a UI list without a camera: two flushes, the second in screen space
+    CommandList& world = recorder.createCommandList();
+    world.setCamera(&camera);
+    drawQuad(world);
+    CommandList& ui = recorder.createCommandList();
+    drawQuad(ui);
+
+    backend.resetStats();
+    recorder.execute(queue, batch, 800, 600);
+    check(backend.getStats().drawCalls == 2, "world and UI lists draw separately");
+    check(isScreenSpace(batch), "list without setCamera draws in screen space");
+
+    // The same lists recorded on a worker, UI first: the world list still gets its camera
+    recorder.recordAsync([](CommandList& list) { drawQuad(list); });
+    recorder.recordAsync([&camera](CommandList& list) {
+        list.setCamera(&camera);
+        drawQuad(list);
+    });
+
+    backend.resetStats();
+    recorder.execute(queue, batch, 800, 600);
+    check(backend.getStats().drawCalls == 2, "UI and world lists draw separately");
+    check(!isScreenSpace(batch), "list with setCamera draws through its camera");
+
+    return reportResults("Command Recorder Camera Test");
+}
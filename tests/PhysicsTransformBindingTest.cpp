@@ -0,0 +1,65 @@
+// Physics transform binding test
+// A body keeps stepping after the ECS frees the Transform it was bound to
+// (destroyEntity, removeComponent, a replacing addComponent); the binding must
+// be dropped rather than written through.
+
+#include "Physics.h"
+#include "TestHarness.h"
+
+namespace {
+
+// Spaced apart so the bodies never touch
+Entity createFallingEntity(PhysicsSystem& system, ECS& ecs, float x) {
+    PhysicsBodyDef bodyDef;
+    bodyDef.type = BodyType::Dynamic;
+    bodyDef.position = Vector2(x, 0.0f);
+    bodyDef.linearVelocity = Vector2(1.0f, 0.0f);
+
+    PhysicsShapeDef shapeDef;
+    shapeDef.type = ShapeType::Box;
+    shapeDef.size = Vector2(1.0f, 1.0f);
+    return system.createPhysicsEntity(ecs, bodyDef, shapeDef);
+}
+
+} // namespace
+
+int main() {
+    PhysicsWorld world(Vector2(0, -10.0f));
+    PhysicsSystem system(&world);
+    ECS ecs;
+    const float step = 1.0f / 60.0f;
+
+    // Bound transform follows the body
+    Entity moving = createFallingEntity(system, ecs, 0.0f);
+    system.update(ecs, step);
+    check(ecs.getComponent<Transform>(moving)->position.y < 0.0f, "bound transform follows its body");
+
+    // Entity destroyed without destroying its body
+    Entity destroyed = createFallingEntity(system, ecs, 10.0f);
+    ecs.destroyEntity(destroyed);
+    for (int i = 0; i < 10; i++) {
+        system.update(ecs, step);
+    }
+    world.step(step);
+    check(world.syncTransforms() == 1, "destroyed entity's binding is dropped");
+
+    // Transform removed
+    Entity removed = createFallingEntity(system, ecs, 20.0f);
+    ecs.removeComponent<Transform>(removed);
+    world.step(step);
+    check(world.syncTransforms() == 1, "removed transform's binding is dropped");
+
+    // Transform replaced: the old one is freed, the new one is only driven after relinking
+    Entity replaced = createFallingEntity(system, ecs, 30.0f);
+    Transform* replacement = ecs.addComponent<Transform>(replaced);
+    system.update(ecs, step);
+    check(replacement->position.y == 0.0f, "replacement transform is not bound implicitly");
+
+    system.linkEntity(ecs, replaced);
+    system.update(ecs, step);
+    Vector2 bodyPosition = ecs.getComponent<PhysicsComponent>(replaced)->body->getPosition();
+    check(replacement->position.x == bodyPosition.x && replacement->position.y == bodyPosition.y,
+          "relinked replacement follows its body");
+
+    return reportResults("Physics Transform Binding Test");
+}
@@ -0,0 +1,65 @@
+// Render queue sort test
+// A RenderCommand left at its default blend mode is opaque: within a layer it
+// sorts by shader and texture, with depth only breaking ties, so opaque draws
+// at mixed depths come out in one run per texture. Translucent draws keep
+// back-to-front order instead. Runs against the Null render backend.
+
+#include "RenderQueue.h"
+#include "RenderBackend.h"
+#include "TestHarness.h"
+
+namespace {
+
+// Alternates two textures while depth rises, the worst order for texture runs
+void submitInterleaved(RenderQueue& queue, Texture* first, Texture* second, BlendMode blendMode, int count) {
+    for (int i = 0; i < count; i++) {
+        RenderCommand command;
+        command.texture = (i % 2 == 0) ? first : second;
+        command.size = Vector2(8.0f, 8.0f);
+        command.blendMode = blendMode;
+        queue.submit(command, 0, static_cast<float>(i) / count);
+    }
+}
+
+} // namespace
+
+int main() {
+    RenderBackend::select(RenderBackendType::Null);
+    RenderBackend& backend = RenderBackend::getActive();
+
+    unsigned char white[4] = { 255, 255, 255, 255 };
+    Texture first;
+    Texture second;
+    check(first.createFromData(white, 1, 1, 4) && second.createFromData(white, 1, 1, 4), "textures created");
+
+    SpriteBatch batch;
+    check(batch.initialize(), "batch initialized");
+
+    RenderCommand defaults;
+    check(defaults.blendMode == BlendMode::None, "commands default to opaque");
+
+    // Keys: texture ranks above depth for opaque draws, below it for translucent ones
+    RenderKey nearSecond = RenderQueue::makeKey(0, false, 1, 2, 0.0f);
+    RenderKey farFirst = RenderQueue::makeKey(0, false, 1, 1, 1.0f);
+    check(farFirst < nearSecond, "opaque keys order by texture before depth");
+    RenderKey nearSecondBlended = RenderQueue::makeKey(0, true, 1, 2, 0.0f);
+    RenderKey farFirstBlended = RenderQueue::makeKey(0, true, 1, 1, 1.0f);
+    check(farFirstBlended < nearSecondBlended, "translucent keys draw back to front");
+
+    const int count = 64;
+    RenderQueue queue;
+
+    // Opaque: one draw per texture regardless of depth
+    submitInterleaved(queue, &first, &second, RenderCommand().blendMode, count);
+    backend.resetStats();
+    queue.execute(batch, 800, 600);
+    check(backend.getStats().drawCalls == 2, "opaque draws with mixed depths sort by texture");
+
+    // Translucent: painter's order wins, so every texture change is a draw
+    submitInterleaved(queue, &first, &second, BlendMode::Alpha, count);
+    backend.resetStats();
+    queue.execute(batch, 800, 600);
+    check(backend.getStats().drawCalls == static_cast<uint64_t>(count), "translucent draws keep depth order");
+
+    return reportResults("Render Queue Sort Test");
+}
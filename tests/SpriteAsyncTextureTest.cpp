@@ -0,0 +1,73 @@
+// Sprite async texture test
+// Goes load -> sprite -> adopt the way AsyncTextureLoader drives a Texture:
+// a sprite created while its texture still shows the placeholder must take the
+// texture's size once the real one is adopted, a failed load must stop naming
+// the loader's placeholder, and a tileset over a loading texture has no grid.
+// Runs against the Null render backend, so no window or GPU is needed.
+
+#include "Sprite.h"
+#include "Tilemap.h"
+#include "RenderBackend.h"
+#include "TestHarness.h"
+
+namespace {
+
+bool sizeEquals(const Vector2& size, float width, float height) {
+    return size.x == width && size.y == height;
+}
+
+} // namespace
+
+int main() {
+    RenderBackend::select(RenderBackendType::Null);
+    RenderBackend& backend = RenderBackend::getActive();
+
+    unsigned char transparent[4] = { 0, 0, 0, 0 };
+    Texture placeholder;
+    check(placeholder.createFromData(transparent, 1, 1, 4), "placeholder created");
+
+    // Sprite auto-sizes to a texture adopted after setTexture
+    Texture loading;
+    loading.setPlaceholder(placeholder.getID());
+    Sprite sprite;
+    sprite.setTexture(&loading);
+    check(sprite.getSize().x > 0.0f && sprite.getSize().y > 0.0f, "sprite on a loading texture is not 0x0");
+    loading.adopt(backend.createTexture(), 64, 32, false);
+    check(sizeEquals(sprite.getSize(), 64.0f, 32.0f), "sprite takes the adopted texture's size");
+
+    // A size set by hand while loading wins over the texture's
+    Texture sized;
+    sized.setPlaceholder(placeholder.getID());
+    Sprite manual;
+    manual.setTexture(&sized);
+    manual.setSize(Vector2(16.0f, 16.0f));
+    sized.adopt(backend.createTexture(), 64, 32, false);
+    check(sizeEquals(manual.getSize(), 16.0f, 16.0f), "manual size survives adopt");
+
+    // Already resident: sized immediately, as before
+    Sprite resident;
+    resident.setTexture(&loading);
+    check(sizeEquals(resident.getSize(), 64.0f, 32.0f), "sprite on a resident texture is sized at once");
+
+    // A failed load holds no texture, so deleting the placeholder leaves nothing dangling
+    Texture failed;
+    failed.setPlaceholder(placeholder.getID());
+    failed.setFailed();
+    check(failed.getState() == TextureState::Failed, "failed texture reports Failed");
+    check(!failed.isValid() && failed.getID() == 0, "failed texture drops the placeholder name");
+
+    // No tile grid while the tileset texture is loading; one once it is adopted
+    Texture atlas;
+    atlas.setPlaceholder(placeholder.getID());
+    Tileset tileset(&atlas, 16, 16);
+    check(tileset.getColumns() == 0, "loading tileset has no columns");
+    float u0, v0, u1, v1;
+    tileset.getTileUV(5, u0, v0, u1, v1);
+    check(u0 == 0.0f && v0 == 0.0f && u1 == 1.0f && v1 == 1.0f, "tile UVs without a grid fall back to the whole texture");
+    atlas.adopt(backend.createTexture(), 64, 64, false);
+    tileset.calculateGrid();
+    tileset.getTileUV(5, u0, v0, u1, v1);
+    check(tileset.getColumns() == 4 && u0 == 0.25f && v0 == 0.25f, "tile UVs follow the adopted texture");
+
+    return reportResults("Sprite Async Texture Test");
+}
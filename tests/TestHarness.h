@@ -0,0 +1,27 @@
+#ifndef OMEGA_TEST_HARNESS_H
+#define OMEGA_TEST_HARNESS_H
+
+// Shared by the test executables: check() records failures, reportResults() prints
+// the banner and the verdict and gives main() its exit code (0 = pass)
+
+#include <iostream>
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        testFailures()++;
+    }
+}
+
+inline int reportResults(const char* testName) {
+    std::cout << "=== " << testName << " ===" << std::endl;
+    std::cout << (testFailures() == 0 ? "PASSED" : "FAILED") << std::endl;
+    return testFailures() == 0 ? 0 : 1;
+}
+
+#endif // OMEGA_TEST_HARNESS_H